@@ -1,23 +1,9 @@
 #ifndef Header_SuperpoweredAndroidAudioIO
 #define Header_SuperpoweredAndroidAudioIO
 
-struct SuperpoweredAndroidAudioIOInternals;
-
-/**
- @brief This is the prototype of an audio processing callback function.
-
- If the application requires both audio input and audio output,
- this callback is called once (there is no separate audio input and audio output callback).
- Audio input is available in audioIO, and the application should change it's contents
- for audio output.
+#include "SuperpoweredAudioIOEngine.h"
 
- @param clientdata A custom pointer your callback receives.
- @param audioIO 16-bit stereo interleaved audio input and/or output.
- @param numberOfSamples The number of samples received and/or requested.
- @param samplerate The current sample rate in Hz.
-*/
-typedef bool (*audioProcessingCallback)(void *clientdata, short int *audioIO, int numberOfSamples,
-                                        int samplerate);
+struct SuperpoweredAndroidAudioIOInternals;
 
 /**
  @brief Easy handling of OpenSL ES audio input and/or output.
@@ -27,6 +13,8 @@ public:
     /**
      @brief Creates an audio I/O instance. Audio input and/or output immediately starts after calling this.
 
+     If the device rejects the buffer queues or memory allocation fails, no audio runs and start() does nothing.
+
      @param samplerate The requested sample rate in Hz.
      @param buffersize The requested buffer size (number of samples).
      @param enableInput Enable audio input.
@@ -50,6 +38,22 @@ public:
                                int outputStreamType = -1,
                                int latencySamples = 0);
 
+    /**
+     @brief Creates an audio I/O instance with a 32-bit floating point callback. Audio input and/or output immediately starts after calling this.
+
+     The fifo holds floating point audio, so no conversion runs before or after the callback.
+     Floating point buffer queues are used if the device supports them (Android 5.0+ for output, 6.0+ for input).
+     Otherwise the device runs in 16-bit, and audio is converted once where it enters or leaves the fifo.
+
+     The parameters and the failure handling are the same as above.
+     */
+    SuperpoweredAndroidAudioIO(int samplerate, int buffersize,
+                               bool enableInput, bool enableOutput,
+                               audioProcessingCallbackFloat callback, void *clientdata,
+                               int inputStreamType = -1,
+                               int outputStreamType = -1,
+                               int latencySamples = 0);
+
     ~SuperpoweredAndroidAudioIO();
 
     /*
@@ -70,6 +74,31 @@ public:
     */
     void onBackground();
 
+    /**
+     @brief Enables or disables adaptive latency. Works only when both input and output are enabled. Safe to call from any thread.
+
+     Every dropout grows the latency by one buffer. If the fifo always had a buffer to spare for two seconds, the latency shrinks by one buffer.
+     So every device runs at the lowest latency it can sustain.
+
+     @param minLatencySamples The lowest latency allowed. 0 disables adaptive latency, the latency stays where it is.
+     @param maxLatencySamples The highest latency allowed. Limited by the fifo size: twice the latencySamples given at creation, 16 buffers minimum.
+     */
+    void setAdaptiveLatency(int minLatencySamples, int maxLatencySamples);
+
+    /**
+     @return Returns with the current latency in samples (how many samples the fifo needs before processing). Safe to call from any thread.
+     */
+    int getLatencySamples();
+
+    /**
+     @brief Returns with the real-time statistics: underruns, overruns, silence, fifo fill level and the callback load histogram.
+
+     Safe to call from any thread, never blocks the audio threads. The counters are free running, take the difference of two snapshots for an interval.
+
+     @param stats The statistics are copied here.
+     */
+    void getStats(SuperpoweredAudioIOStats *stats);
+
     /*
      @brief Starts audio input and/or output.
     */
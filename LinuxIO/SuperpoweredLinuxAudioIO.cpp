@@ -0,0 +1,280 @@
+#include "SuperpoweredLinuxAudioIO.h"
+#include <time.h>
+
+#define SIMULATED_MAX_PENDING 64
+
+// One simulated buffer queue. The hardware moves audio in periods of random size, and every time a full
+// buffer is completed, a callback is scheduled with some random delay.
+typedef struct simulatedQueue {
+    double secondsPerSample;                         // Includes the clock drift.
+    double hardwareTime;                             // When the current hardware period ends.
+    double completeTimes[SIMULATED_MAX_PENDING];     // When the buffer was completed by the hardware.
+    double fireTimes[SIMULATED_MAX_PENDING];         // When the callback runs.
+    double lastFireTime;
+    int periodSamples, samplesDone, pendingHead, pendingCount;
+    bool enabled;
+} simulatedQueue;
+
+typedef struct SuperpoweredLinuxAudioIOInternals {
+    SuperpoweredAudioIOEngine engine;
+    SuperpoweredSimulatedAudioDevice device;
+    SuperpoweredLinuxAudioIOStats stats;
+    simulatedQueue input, output;
+    double now, bufferSeconds, loadSum, latencySum;
+    double *recordTimes;                             // The completion time of every fifo buffer's recording.
+    void *inputBuffer;                               // The buffer the input device records into.
+    int64_t loadCount, latencyCount;
+    unsigned int random;
+    bool started, outputStarted, failed;
+} SuperpoweredLinuxAudioIOInternals;
+
+// Deterministic xorshift generator, between 0 and 1.
+static double nextRandom(SuperpoweredLinuxAudioIOInternals *internals) {
+    unsigned int x = internals->random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    internals->random = x;
+    return (double)x / 4294967296.0;
+}
+
+static int nextPeriod(SuperpoweredLinuxAudioIOInternals *internals) {
+    int range = internals->device.maxPeriodSamples - internals->device.minPeriodSamples;
+    if (range <= 0) return internals->device.minPeriodSamples;
+    return internals->device.minPeriodSamples + (int)(nextRandom(internals) * (range + 1));
+}
+
+static void resetQueue(SuperpoweredLinuxAudioIOInternals *internals, simulatedQueue *queue) {
+    queue->periodSamples = nextPeriod(internals);
+    queue->hardwareTime = internals->now + queue->periodSamples * queue->secondsPerSample;
+    queue->lastFireTime = internals->now;
+    queue->samplesDone = queue->pendingHead = queue->pendingCount = 0;
+}
+
+// The hardware finished a period. Schedules callbacks for the buffers completed.
+static void hardwarePeriod(SuperpoweredLinuxAudioIOInternals *internals, simulatedQueue *queue) {
+    queue->samplesDone += queue->periodSamples;
+    while ((queue->samplesDone >= internals->engine.buffersize) && (queue->pendingCount < SIMULATED_MAX_PENDING)) {
+        queue->samplesDone -= internals->engine.buffersize;
+
+        double fireTime = queue->hardwareTime + nextRandom(internals) * internals->device.jitterMs * 0.001;
+        if (fireTime < queue->lastFireTime) fireTime = queue->lastFireTime; // Callbacks of one queue never overtake each other.
+        queue->lastFireTime = fireTime;
+
+        int index = (queue->pendingHead + queue->pendingCount) % SIMULATED_MAX_PENDING;
+        queue->completeTimes[index] = queue->hardwareTime;
+        queue->fireTimes[index] = fireTime;
+        queue->pendingCount++;
+    }
+
+    queue->periodSamples = nextPeriod(internals);
+    queue->hardwareTime += queue->periodSamples * queue->secondsPerSample;
+}
+
+static double wallSeconds() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+static void addLoad(SuperpoweredLinuxAudioIOInternals *internals, double seconds) {
+    double load = seconds / internals->bufferSeconds;
+    internals->loadSum += load;
+    internals->loadCount++;
+    if (load > internals->stats.maximumLoad) internals->stats.maximumLoad = load;
+}
+
+static void inputCallback(SuperpoweredLinuxAudioIOInternals *internals, double completeTime) {
+    SuperpoweredAudioFifo *fifo = &internals->engine.fifo;
+    memset(internals->inputBuffer, 0, SuperpoweredAudioIOEngineDeviceBufferBytes(&internals->engine));
+
+    if (SuperpoweredAudioFifoFill(fifo) + 1 >= fifo->numBuffers) internals->stats.overruns++;
+    else internals->recordTimes[fifo->writeCount & (fifo->numBuffers - 1)] = completeTime;
+
+    double start = wallSeconds();
+    internals->inputBuffer = SuperpoweredAudioIOEngineInput(&internals->engine);
+    if (!internals->engine.hasOutput) addLoad(internals, wallSeconds() - start);
+    internals->stats.inputCallbacks++;
+}
+
+static void outputCallback(SuperpoweredLinuxAudioIOInternals *internals, double fireTime) {
+    SuperpoweredAudioFifo *fifo = &internals->engine.fifo;
+    bool shouldStop;
+    double start = wallSeconds();
+    void *output = SuperpoweredAudioIOEngineOutput(&internals->engine, &shouldStop);
+    addLoad(internals, wallSeconds() - start);
+    internals->stats.outputCallbacks++;
+
+    if (output == internals->engine.silence) {
+        // Silence before the fifo filled up the first time is not a dropout.
+        if (internals->outputStarted) internals->stats.dropouts++;
+    } else {
+        internals->outputStarted = true;
+        if (internals->engine.hasInput) {
+            // The fifo buffer played. The adaptive latency may have dropped buffers in the call, so it's known only now.
+            // A converted buffer has been handed back to the fifo already, the device plays the staging buffer.
+            unsigned int index;
+            if (output == internals->engine.outputStaging) index = (fifo->readCount - 1) & (fifo->numBuffers - 1);
+            else index = (unsigned int)(((char *)output - fifo->buffers) / fifo->bufferStepBytes);
+
+            // The first sample was recorded one buffer before the recording completed, and starts playing now.
+            double latency = fireTime - internals->recordTimes[index] + internals->bufferSeconds;
+            if ((internals->latencyCount == 0) || (latency < internals->stats.minimumLatencyMs)) internals->stats.minimumLatencyMs = latency;
+            if (latency > internals->stats.maximumLatencyMs) internals->stats.maximumLatencyMs = latency;
+            internals->latencySum += latency;
+            internals->latencyCount++;
+        }
+    }
+
+    if (shouldStop) internals->started = false;
+}
+
+// Shared by the 16-bit and the floating point constructors. Exactly one of the callbacks is set.
+static SuperpoweredLinuxAudioIOInternals *createInternals(int samplerate, int buffersize,
+                                                          bool enableInput, bool enableOutput,
+                                                          audioProcessingCallback callback,
+                                                          audioProcessingCallbackFloat floatCallback,
+                                                          void *clientdata, int latencySamples,
+                                                          const SuperpoweredSimulatedAudioDevice *device) {
+    SuperpoweredLinuxAudioIOInternals *internals = new SuperpoweredLinuxAudioIOInternals;
+    memset(internals, 0, sizeof(SuperpoweredLinuxAudioIOInternals));
+
+    if (device) internals->device = *device;
+    if (internals->device.minPeriodSamples <= 0) internals->device.minPeriodSamples = buffersize;
+    if (internals->device.maxPeriodSamples < internals->device.minPeriodSamples) internals->device.maxPeriodSamples = internals->device.minPeriodSamples;
+    if (internals->device.jitterMs < 0) internals->device.jitterMs = 0;
+    internals->random = internals->device.seed ? internals->device.seed : 0x9e3779b9;
+
+    if (!SuperpoweredAudioIOEngineInit(&internals->engine, samplerate, buffersize, enableInput, enableOutput,
+                                       callback, floatCallback, clientdata, latencySamples, internals->device.floatFormat) ||
+        !(internals->recordTimes = (double *)malloc(internals->engine.fifo.numBuffers * sizeof(double)))) {
+        // Out of memory: the devices never start.
+        SuperpoweredAudioIOEngineFree(&internals->engine);
+        internals->failed = true;
+        return internals;
+    }
+    memset(internals->recordTimes, 0, internals->engine.fifo.numBuffers * sizeof(double));
+    internals->inputBuffer = SuperpoweredAudioIOEngineFirstInputBuffer(&internals->engine);
+
+    internals->bufferSeconds = (double)buffersize / (double)samplerate;
+    internals->input.enabled = enableInput;
+    internals->input.secondsPerSample = 1.0 / ((double)samplerate * (1.0 + internals->device.inputDriftPPM * 0.000001));
+    internals->output.enabled = enableOutput;
+    internals->output.secondsPerSample = 1.0 / ((double)samplerate * (1.0 + internals->device.outputDriftPPM * 0.000001));
+    return internals;
+}
+
+SuperpoweredLinuxAudioIO::SuperpoweredLinuxAudioIO(int samplerate, int buffersize,
+                                                   bool enableInput, bool enableOutput,
+                                                   audioProcessingCallback callback, void *clientdata,
+                                                   int latencySamples,
+                                                   const SuperpoweredSimulatedAudioDevice *device) {
+    internals = createInternals(samplerate, buffersize, enableInput, enableOutput, callback, NULL, clientdata, latencySamples, device);
+    start();
+}
+
+SuperpoweredLinuxAudioIO::SuperpoweredLinuxAudioIO(int samplerate, int buffersize,
+                                                   bool enableInput, bool enableOutput,
+                                                   audioProcessingCallbackFloat callback, void *clientdata,
+                                                   int latencySamples,
+                                                   const SuperpoweredSimulatedAudioDevice *device) {
+    internals = createInternals(samplerate, buffersize, enableInput, enableOutput, NULL, callback, clientdata, latencySamples, device);
+    start();
+}
+
+SuperpoweredLinuxAudioIO::~SuperpoweredLinuxAudioIO() {
+    SuperpoweredAudioIOEngineFree(&internals->engine);
+    free(internals->recordTimes);
+    delete internals;
+}
+
+void SuperpoweredLinuxAudioIO::run(double seconds) {
+    double start = internals->now, end = start + seconds;
+    simulatedQueue *queues[2] = { &internals->input, &internals->output };
+
+    while (internals->started) {
+        // Find the next event: a hardware period or a callback, whichever comes first.
+        double nextTime = end;
+        simulatedQueue *queue = NULL;
+        bool isCallback = false;
+
+        for (int n = 0; n < 2; n++) {
+            if (!queues[n]->enabled) continue;
+            if (queues[n]->hardwareTime < nextTime) {
+                nextTime = queues[n]->hardwareTime;
+                queue = queues[n];
+                isCallback = false;
+            }
+            if (queues[n]->pendingCount && (queues[n]->fireTimes[queues[n]->pendingHead] <= nextTime)) {
+                nextTime = queues[n]->fireTimes[queues[n]->pendingHead];
+                queue = queues[n];
+                isCallback = true;
+            }
+        }
+        if (!queue) break;
+        internals->now = nextTime;
+
+        if (!isCallback) hardwarePeriod(internals, queue);
+        else {
+            double completeTime = queue->completeTimes[queue->pendingHead];
+            queue->pendingHead = (queue->pendingHead + 1) % SIMULATED_MAX_PENDING;
+            queue->pendingCount--;
+
+            if (queue == &internals->input) inputCallback(internals, completeTime);
+            else outputCallback(internals, nextTime);
+        }
+    }
+
+    // If the devices stopped, the simulation ended at the last callback.
+    if (internals->started) internals->now = end;
+    internals->stats.simulatedSeconds += internals->now - start;
+}
+
+void SuperpoweredLinuxAudioIO::getStats(SuperpoweredLinuxAudioIOStats *stats) {
+    *stats = internals->stats;
+    stats->averageLoad = internals->loadCount ? internals->loadSum / (double)internals->loadCount : 0;
+    stats->averageLatencyMs = internals->latencyCount ? internals->latencySum / (double)internals->latencyCount : 0;
+    stats->minimumLatencyMs *= 1000.0;
+    stats->averageLatencyMs *= 1000.0;
+    stats->maximumLatencyMs *= 1000.0;
+}
+
+void SuperpoweredLinuxAudioIO::getStats(SuperpoweredAudioIOStats *stats) {
+    SuperpoweredAudioIOEngineGetStats(&internals->engine, stats);
+}
+
+void SuperpoweredLinuxAudioIO::resetStats() {
+    memset(&internals->stats, 0, sizeof(SuperpoweredLinuxAudioIOStats));
+    // The callbacks run on this thread, nothing writes the engine's statistics now.
+    memset(&internals->engine.stats, 0, sizeof(SuperpoweredAudioIOStats));
+    internals->loadSum = internals->latencySum = 0;
+    internals->loadCount = internals->latencyCount = 0;
+}
+
+void SuperpoweredLinuxAudioIO::onForeground() {
+    SuperpoweredAudioIOEngineSetForeground(&internals->engine, true);
+    start();
+}
+
+void SuperpoweredLinuxAudioIO::onBackground() {
+    SuperpoweredAudioIOEngineSetForeground(&internals->engine, false);
+}
+
+void SuperpoweredLinuxAudioIO::setAdaptiveLatency(int minLatencySamples, int maxLatencySamples) {
+    SuperpoweredAudioIOEngineSetAdaptiveLatency(&internals->engine, minLatencySamples, maxLatencySamples);
+}
+
+int SuperpoweredLinuxAudioIO::getLatencySamples() {
+    return SuperpoweredAudioIOEngineLatencySamples(&internals->engine);
+}
+
+void SuperpoweredLinuxAudioIO::start() {
+    if (internals->started || internals->failed) return;
+    internals->started = true;
+    resetQueue(internals, &internals->input);
+    resetQueue(internals, &internals->output);
+}
+
+void SuperpoweredLinuxAudioIO::stop() {
+    internals->started = false;
+}
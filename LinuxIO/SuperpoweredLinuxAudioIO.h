@@ -0,0 +1,151 @@
+#ifndef Header_SuperpoweredLinuxAudioIO
+#define Header_SuperpoweredLinuxAudioIO
+
+#include "SuperpoweredAudioIOEngine.h"
+#include <stdint.h>
+
+struct SuperpoweredLinuxAudioIOInternals;
+
+/**
+ @brief Describes the simulated audio device. Zero everything for a perfect device.
+
+ @param inputDriftPPM How much faster the input clock runs than the nominal sample rate, in parts per million. Can be negative.
+ @param outputDriftPPM How much faster the output clock runs than the nominal sample rate, in parts per million. Can be negative.
+ @param jitterMs Maximum random delay of a callback after its buffer was completed by the device.
+ @param minPeriodSamples The device moves audio between the hardware and the buffer queues in periods of random size. This is the smallest period. 0 means buffersize.
+ @param maxPeriodSamples The largest period. 0 means minPeriodSamples.
+ @param seed Seed of the random generator. The same seed and settings always produce the same callback sequence.
+ @param floatFormat The device takes 32-bit floating point audio. Works with a floating point callback only, 16-bit otherwise.
+ */
+typedef struct SuperpoweredSimulatedAudioDevice {
+    double inputDriftPPM, outputDriftPPM, jitterMs;
+    int minPeriodSamples, maxPeriodSamples;
+    unsigned int seed;
+    bool floatFormat;
+} SuperpoweredSimulatedAudioDevice;
+
+/**
+ @brief Statistics collected by the simulation.
+
+ @param inputCallbacks The number of input callbacks.
+ @param outputCallbacks The number of output callbacks.
+ @param dropouts Output buffers replaced by silence because the fifo didn't have enough audio.
+ @param overruns Recorded buffers dropped because the fifo was full.
+ @param averageLoad Average wall time of the audio processing callback, relative to the buffer period.
+ @param maximumLoad Maximum wall time of the audio processing callback, relative to the buffer period.
+ @param minimumLatencyMs Minimum simulated time from recording to playback. Only with input and output enabled.
+ @param averageLatencyMs Average simulated time from recording to playback.
+ @param maximumLatencyMs Maximum simulated time from recording to playback.
+ @param simulatedSeconds The simulated time passed while the devices were running.
+ */
+typedef struct SuperpoweredLinuxAudioIOStats {
+    int64_t inputCallbacks, outputCallbacks, dropouts, overruns;
+    double averageLoad, maximumLoad;
+    double minimumLatencyMs, averageLatencyMs, maximumLatencyMs;
+    double simulatedSeconds;
+} SuperpoweredLinuxAudioIOStats;
+
+/**
+ @brief Headless audio I/O with a simulated device clock, for benchmarking and regression testing the buffering policy on any Linux machine.
+
+ Runs the same engine as SuperpoweredAndroidAudioIO. Instead of real time, the device clock advances in run(), and the callbacks run on the calling thread in simulated time order. Jitter, uneven device periods and input/output drift can be injected.
+ */
+class SuperpoweredLinuxAudioIO {
+public:
+    /**
+     @brief Creates an audio I/O instance. The simulated devices start immediately, but nothing happens until run() is called.
+
+     If memory allocation fails, the devices never start and run() does nothing.
+
+     @param samplerate The sample rate in Hz.
+     @param buffersize The buffer size (number of samples).
+     @param enableInput Enable audio input.
+     @param enableOutput Enable audio output.
+     @param callback The audio processing callback function to call periodically.
+     @param clientdata A custom pointer the callback receives.
+     @param latencySamples How many samples to have in the internal fifo buffer minimum. Works only when both input and output are enabled.
+     @param device The simulated device. NULL means a perfect device.
+     */
+    SuperpoweredLinuxAudioIO(int samplerate, int buffersize,
+                             bool enableInput, bool enableOutput,
+                             audioProcessingCallback callback, void *clientdata,
+                             int latencySamples = 0,
+                             const SuperpoweredSimulatedAudioDevice *device = 0);
+
+    /**
+     @brief Creates an audio I/O instance with a 32-bit floating point callback. The parameters are the same as above.
+     */
+    SuperpoweredLinuxAudioIO(int samplerate, int buffersize,
+                             bool enableInput, bool enableOutput,
+                             audioProcessingCallbackFloat callback, void *clientdata,
+                             int latencySamples = 0,
+                             const SuperpoweredSimulatedAudioDevice *device = 0);
+
+    ~SuperpoweredLinuxAudioIO();
+
+    /**
+     @brief Advances the simulated clock, running all device callbacks due in this time on the calling thread.
+
+     If the devices stop (in the background, see onBackground()), the clock stops at the callback that stopped them.
+
+     @param seconds Simulated time to advance.
+    */
+    void run(double seconds);
+
+    /**
+     @brief Returns with the statistics collected since creation or the last resetStats().
+    */
+    void getStats(SuperpoweredLinuxAudioIOStats *stats);
+
+    /**
+     @brief Returns with the engine's real-time statistics, the same as SuperpoweredAndroidAudioIO::getStats() returns.
+    */
+    void getStats(SuperpoweredAudioIOStats *stats);
+
+    /**
+     @brief Clears both statistics.
+    */
+    void resetStats();
+
+    /**
+     @brief Simulates the main activity's onResume().
+    */
+    void onForeground();
+
+    /**
+     @brief Simulates the main activity's onPause(). Audio stops after one second of silence.
+    */
+    void onBackground();
+
+    /**
+     @brief Enables or disables adaptive latency, same as SuperpoweredAndroidAudioIO::setAdaptiveLatency().
+
+     @param minLatencySamples The lowest latency allowed. 0 disables adaptive latency.
+     @param maxLatencySamples The highest latency allowed. Limited by the fifo size.
+    */
+    void setAdaptiveLatency(int minLatencySamples, int maxLatencySamples);
+
+    /**
+     @return Returns with the current latency in samples.
+    */
+    int getLatencySamples();
+
+    /**
+     @brief Starts audio input and/or output.
+    */
+    void start();
+
+    /**
+     @brief Stops audio input and/or output.
+    */
+    void stop();
+
+private:
+    SuperpoweredLinuxAudioIOInternals *internals;
+
+    SuperpoweredLinuxAudioIO(const SuperpoweredLinuxAudioIO &);
+
+    SuperpoweredLinuxAudioIO &operator=(const SuperpoweredLinuxAudioIO &);
+};
+
+#endif
@@ -0,0 +1,431 @@
+#include "SuperpoweredAudioBufferCache.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define CACHELINE 64
+#define NOBUFFER 0xffffffffu
+#define HUGECLASS SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES
+#define TABLECHUNKSHIFT 12 // 4096 buffers per table chunk.
+#define TABLECHUNKS 1024
+#define HUGEPAGE (2 * 1024 * 1024)
+
+// Every buffer starts with a header, the audio follows on the next cache line.
+typedef struct bufferHeader {
+    unsigned int next;      // The next free buffer in the shared pool.
+    unsigned int index;     // Position in the buffer table.
+    int retainCount;
+    unsigned int sizeClass; // HUGECLASS for unpooled buffers.
+    char pad[CACHELINE - 4 * sizeof(unsigned int)];
+} bufferHeader;
+
+// The shared pool of a size class: a lock-free stack of buffer indexes, linked through the headers.
+// The head is the index of the first buffer in the low 32 bits and a tag in the high 32 bits. The tag changes at every
+// modification, so a compare and swap never succeeds on a head that was popped and pushed back in the meantime (ABA).
+// The free count and the high-water mark are statistics only, they are updated after the compare and swap.
+typedef struct sharedPool {
+    uint64_t head;
+    int freeBuffers;
+    unsigned int highWaterMark;
+    char pad[CACHELINE - sizeof(uint64_t) - 2 * sizeof(unsigned int)];
+} sharedPool;
+
+// The magazines of a thread. Owned by one thread, only the owner reads and writes it (the counters are read by getStats).
+typedef struct threadCache {
+    unsigned int count[SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES];
+    int inUse; // Claimed by a thread.
+    uint64_t hits[SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES], misses[SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES];
+    void *buffers[SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES][SUPERPOWEREDAUDIOBUFFERCACHE_MAGAZINE];
+} __attribute__((aligned(CACHELINE))) threadCache;
+
+// Growth of a size class. Written with the class lock locked.
+typedef struct classGrowth {
+    pthread_mutex_t lock;
+    unsigned int buffers, fixedBuffers, slabs;
+    uint64_t slabFallbacks;
+} __attribute__((aligned(CACHELINE))) classGrowth;
+
+// Buffer indexes to headers. Chunks are added, never removed, so lookups need no lock.
+static bufferHeader **bufferTable[TABLECHUNKS];
+static unsigned int numBuffers = 0;
+
+static sharedPool pools[SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES];
+static classGrowth growth[SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES];
+static threadCache threadCaches[SUPERPOWEREDAUDIOBUFFERCACHE_MAXTHREADS];
+static threadCache noThreadCache; // Marks threads without a free slot, so they don't search again.
+static uint64_t noThreadCacheHits[SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES], noThreadCacheMisses[SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES];
+static unsigned int magazineCapacity[SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES];
+static unsigned int hugeBuffers = 0;
+static pthread_key_t threadKey;
+static pthread_mutex_t growLock = PTHREAD_MUTEX_INITIALIZER;
+static int initialized = 0;
+
+static inline bufferHeader *headerOf(unsigned int index) {
+    return bufferTable[index >> TABLECHUNKSHIFT][index & ((1 << TABLECHUNKSHIFT) - 1)];
+}
+
+static inline bufferHeader *headerOfBuffer(void *buffer) {
+    return (bufferHeader *)buffer - 1;
+}
+
+static inline unsigned int classBytes(unsigned int sizeClass) {
+    return 1u << (SUPERPOWEREDAUDIOBUFFERCACHE_MINSHIFT + sizeClass);
+}
+
+// The smallest class large enough, or HUGECLASS.
+static inline unsigned int sizeClassOf(unsigned int sizeBytes) {
+    if (sizeBytes <= classBytes(0)) return 0;
+    unsigned int sizeClass = 32 - (unsigned int)__builtin_clz(sizeBytes - 1) - SUPERPOWEREDAUDIOBUFFERCACHE_MINSHIFT;
+    return (sizeClass < HUGECLASS) ? sizeClass : HUGECLASS;
+}
+
+// Counters with a single writer, no read-modify-write needed.
+static inline void countOwned(uint64_t *counter) {
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED);
+}
+
+// Pushes a chain of buffers, already linked from first to last, to the shared pool with one compare and swap.
+static void pushChain(unsigned int sizeClass, bufferHeader *first, bufferHeader *last, unsigned int count) {
+    uint64_t head = __atomic_load_n(&pools[sizeClass].head, __ATOMIC_RELAXED), newHead;
+    do {
+        __atomic_store_n(&last->next, (unsigned int)head, __ATOMIC_RELAXED);
+        newHead = (((head >> 32) + 1) << 32) | first->index;
+    } while (!__atomic_compare_exchange_n(&pools[sizeClass].head, &head, newHead, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    __atomic_add_fetch(&pools[sizeClass].freeBuffers, (int)count, __ATOMIC_RELAXED);
+}
+
+// Pushes a chain of buffers to the shared pool with one compare and swap.
+static void pushBuffers(unsigned int sizeClass, void **buffers, unsigned int count) {
+    if (!count) return;
+    for (unsigned int n = 0; n + 1 < count; n++) __atomic_store_n(&headerOfBuffer(buffers[n])->next, headerOfBuffer(buffers[n + 1])->index, __ATOMIC_RELAXED);
+    pushChain(sizeClass, headerOfBuffer(buffers[0]), headerOfBuffer(buffers[count - 1]), count);
+}
+
+// The number of buffers out of the shared pool (in use or in magazines) is at its highest right after a pop.
+static void updateHighWaterMark(unsigned int sizeClass) {
+    int freeBuffers = __atomic_load_n(&pools[sizeClass].freeBuffers, __ATOMIC_RELAXED);
+    unsigned int buffers = __atomic_load_n(&growth[sizeClass].buffers, __ATOMIC_RELAXED);
+    unsigned int out = (freeBuffers <= 0) ? buffers : ((unsigned int)freeBuffers < buffers ? buffers - (unsigned int)freeBuffers : 0);
+    unsigned int mark = __atomic_load_n(&pools[sizeClass].highWaterMark, __ATOMIC_RELAXED);
+    while ((out > mark) && !__atomic_compare_exchange_n(&pools[sizeClass].highWaterMark, &mark, out, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+// Pops up to count buffers from the shared pool with one compare and swap. Returns with the number of buffers.
+// The walk may read the links of buffers another thread has popped meanwhile. The headers are never freed, and the tag fails the compare and swap then.
+static unsigned int popBuffers(unsigned int sizeClass, void **buffers, unsigned int count) {
+    uint64_t head = __atomic_load_n(&pools[sizeClass].head, __ATOMIC_ACQUIRE);
+    while (true) {
+        unsigned int first = (unsigned int)head, last = first, n = 1;
+        if (first == NOBUFFER) return 0;
+        while (n < count) {
+            unsigned int next = __atomic_load_n(&headerOf(last)->next, __ATOMIC_RELAXED);
+            if (next == NOBUFFER) break;
+            last = next;
+            n++;
+        }
+        uint64_t newHead = (((head >> 32) + 1) << 32) | __atomic_load_n(&headerOf(last)->next, __ATOMIC_RELAXED);
+        if (__atomic_compare_exchange_n(&pools[sizeClass].head, &head, newHead, true, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            for (unsigned int i = 0, index = first; i < n; i++) {
+                bufferHeader *header = headerOf(index);
+                buffers[i] = header + 1;
+                index = header->next;
+            }
+            __atomic_sub_fetch(&pools[sizeClass].freeBuffers, (int)n, __ATOMIC_RELAXED);
+            updateHighWaterMark(sizeClass);
+            return n;
+        }
+    }
+}
+
+static void flushCache(threadCache *cache) {
+    for (unsigned int sizeClass = 0; sizeClass < SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES; sizeClass++) {
+        pushBuffers(sizeClass, cache->buffers[sizeClass], cache->count[sizeClass]);
+        cache->count[sizeClass] = 0;
+    }
+}
+
+static void threadExit(void *value) {
+    threadCache *cache = (threadCache *)value;
+    if (cache == &noThreadCache) return;
+    flushCache(cache);
+    __atomic_store_n(&cache->inUse, 0, __ATOMIC_RELEASE);
+}
+
+// The calling thread's magazines, claims a free slot at the first call. NULL if there is no free slot.
+static threadCache *getThreadCache() {
+    threadCache *cache = (threadCache *)pthread_getspecific(threadKey);
+    if (cache) return (cache == &noThreadCache) ? NULL : cache;
+
+    for (int n = 0; n < SUPERPOWEREDAUDIOBUFFERCACHE_MAXTHREADS; n++) {
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&threadCaches[n].inUse, &expected, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            pthread_setspecific(threadKey, &threadCaches[n]);
+            return &threadCaches[n];
+        }
+    }
+    pthread_setspecific(threadKey, &noThreadCache);
+    return NULL;
+}
+
+// Adds the buffers of a memory block to the table, linked to each other in order. Returns with the first header, or NULL if the table is full.
+// Can be called concurrently: the indexes are reserved with a compare and swap, missing table chunks are installed with another one.
+static bufferHeader *registerBuffers(char *memory, unsigned int sizeClass, unsigned int count) {
+    unsigned int first = __atomic_load_n(&numBuffers, __ATOMIC_RELAXED);
+    do {
+        if (((first + count - 1) >> TABLECHUNKSHIFT) >= TABLECHUNKS) return NULL;
+    } while (!__atomic_compare_exchange_n(&numBuffers, &first, first + count, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    for (unsigned int chunk = first >> TABLECHUNKSHIFT; chunk <= ((first + count - 1) >> TABLECHUNKSHIFT); chunk++) {
+        if (__atomic_load_n(&bufferTable[chunk], __ATOMIC_ACQUIRE)) continue;
+        bufferHeader **table = (bufferHeader **)calloc(1 << TABLECHUNKSHIFT, sizeof(bufferHeader *)), **expected = NULL;
+        if (!table) return NULL; // The reserved indexes are lost, not a problem.
+        if (!__atomic_compare_exchange_n(&bufferTable[chunk], &expected, table, false, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE)) free(table);
+    }
+
+    unsigned int stride = sizeof(bufferHeader) + classBytes(sizeClass);
+    for (unsigned int n = 0; n < count; n++) {
+        bufferHeader *header = (bufferHeader *)(memory + (size_t)n * stride);
+        unsigned int index = first + n;
+        header->index = index;
+        header->sizeClass = sizeClass;
+        header->retainCount = 0;
+        header->next = (n + 1 < count) ? index + 1 : NOBUFFER;
+        __atomic_store_n(&bufferTable[index >> TABLECHUNKSHIFT][index & ((1 << TABLECHUNKSHIFT) - 1)], header, __ATOMIC_RELEASE);
+    }
+    return (bufferHeader *)memory;
+}
+
+// Allocates a slab for a size class, and returns with one of its buffers. The rest goes to the shared pool.
+// Call with the class lock locked.
+static bufferHeader *growClass(unsigned int sizeClass) {
+    unsigned int stride = sizeof(bufferHeader) + classBytes(sizeClass), count = SUPERPOWEREDAUDIOBUFFERCACHE_SLABBYTES / classBytes(sizeClass);
+    if (count < 2) count = 2;
+    char *slab = NULL;
+    if (posix_memalign((void **)&slab, CACHELINE, (size_t)stride * count) != 0) return NULL;
+    bufferHeader *first = registerBuffers(slab, sizeClass, count);
+    if (!first) {
+        free(slab);
+        return NULL;
+    }
+
+    classGrowth *g = &growth[sizeClass];
+    __atomic_store_n(&g->buffers, g->buffers + count, __ATOMIC_RELAXED);
+    __atomic_store_n(&g->slabs, g->slabs + 1, __ATOMIC_RELAXED);
+    pushChain(sizeClass, (bufferHeader *)(slab + stride), (bufferHeader *)(slab + (size_t)(count - 1) * stride), count - 1);
+    return first;
+}
+
+// Maps an anonymous memory region, aligned to the hugepage size if hugepages are requested. NULL on failure.
+static char *mapRegion(size_t bytes, bool hugePages) {
+#ifdef MADV_HUGEPAGE
+    if (hugePages) {
+        size_t mappedBytes = bytes + HUGEPAGE;
+        char *mapped = (char *)mmap(NULL, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped != MAP_FAILED) {
+            char *region = (char *)(((uintptr_t)mapped + HUGEPAGE - 1) & ~(uintptr_t)(HUGEPAGE - 1));
+            if (region > mapped) munmap(mapped, region - mapped);
+            if (mapped + mappedBytes > region + bytes) munmap(region + bytes, (mapped + mappedBytes) - (region + bytes));
+            madvise(region, bytes, MADV_HUGEPAGE); // Fails without transparent hugepage support, the region works with normal pages then.
+            return region;
+        }
+    }
+#endif
+    char *region = (char *)mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return (region == MAP_FAILED) ? NULL : region;
+}
+
+// Call with growLock locked.
+static bool initialize(const SuperpoweredAudiobufferCacheConfig *config, bool *memoryLocked) {
+    static bool prepared = false;
+    if (!prepared) {
+        pthread_key_create(&threadKey, threadExit);
+        for (unsigned int sizeClass = 0; sizeClass < SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES; sizeClass++) {
+            unsigned int capacity = (256 * 1024) / classBytes(sizeClass);
+            magazineCapacity[sizeClass] = (capacity < 2) ? 2 : ((capacity > SUPERPOWEREDAUDIOBUFFERCACHE_MAGAZINE) ? SUPERPOWEREDAUDIOBUFFERCACHE_MAGAZINE : capacity);
+            pools[sizeClass].head = NOBUFFER;
+            pthread_mutex_init(&growth[sizeClass].lock, NULL);
+        }
+        prepared = true;
+    }
+
+    // The fixed region: one mapping, the size classes follow each other.
+    size_t bytes = 0, pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    for (unsigned int sizeClass = 0; sizeClass < SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES; sizeClass++) bytes += (size_t)(sizeof(bufferHeader) + classBytes(sizeClass)) * config->buffersPerClass[sizeClass];
+    char *region = NULL;
+    bool locked = false;
+    if (bytes) {
+        size_t granularity = config->hugePages ? HUGEPAGE : pageSize;
+        bytes = (bytes + granularity - 1) & ~(granularity - 1);
+        region = mapRegion(bytes, config->hugePages);
+        if (!region) return false;
+
+        // Page faults and TLB misses happen here, not in the first audio callbacks.
+        for (size_t offset = 0; offset < bytes; offset += pageSize) ((volatile char *)region)[offset] = 0;
+        if (config->lockMemory) locked = (mlock(region, bytes) == 0);
+    }
+    if (memoryLocked) *memoryLocked = locked;
+
+    for (unsigned int sizeClass = 0; sizeClass < SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES; sizeClass++) {
+        unsigned int stride = sizeof(bufferHeader) + classBytes(sizeClass), count = config->buffersPerClass[sizeClass];
+        if (!count) continue;
+        bufferHeader *first = registerBuffers(region, sizeClass, count);
+        if (first) {
+            growth[sizeClass].buffers = growth[sizeClass].fixedBuffers = count;
+            pushChain(sizeClass, first, (bufferHeader *)(region + (size_t)(count - 1) * stride), count);
+        }
+        region += (size_t)stride * count;
+    }
+    __atomic_store_n(&initialized, 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+void SuperpoweredAudiobufferCache::defaultConfig(SuperpoweredAudiobufferCacheConfig *config) {
+    for (unsigned int sizeClass = 0; sizeClass < SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES; sizeClass++) {
+        unsigned int count = (512 * 1024) / classBytes(sizeClass);
+        config->buffersPerClass[sizeClass] = (count < 2) ? 2 : count;
+    }
+    config->lockMemory = false;
+    config->hugePages = true;
+}
+
+bool SuperpoweredAudiobufferCache::init(const SuperpoweredAudiobufferCacheConfig *config, bool *memoryLocked) {
+    SuperpoweredAudiobufferCacheConfig defaults;
+    if (!config) {
+        defaultConfig(&defaults);
+        config = &defaults;
+    }
+    pthread_mutex_lock(&growLock);
+    bool success = !initialized && initialize(config, memoryLocked);
+    pthread_mutex_unlock(&growLock);
+    return success;
+}
+
+void SuperpoweredAudiobufferCache::ping() {
+    if (__atomic_load_n(&initialized, __ATOMIC_ACQUIRE)) return;
+    init(NULL);
+}
+
+void *SuperpoweredAudiobufferCache::getBuffer(unsigned int sizeBytes) {
+    unsigned int sizeClass = sizeClassOf(sizeBytes);
+    if ((sizeClass == HUGECLASS) || !__atomic_load_n(&initialized, __ATOMIC_ACQUIRE)) return NULL;
+
+    void *buffer;
+    threadCache *cache = getThreadCache();
+    if (cache) {
+        unsigned int *count = &cache->count[sizeClass];
+        if (!*count) *count = popBuffers(sizeClass, cache->buffers[sizeClass], magazineCapacity[sizeClass] / 2);
+        if (!*count) {
+            countOwned(&cache->misses[sizeClass]);
+            return NULL;
+        }
+        buffer = cache->buffers[sizeClass][--(*count)];
+        countOwned(&cache->hits[sizeClass]);
+    } else if (popBuffers(sizeClass, &buffer, 1)) __atomic_add_fetch(&noThreadCacheHits[sizeClass], 1, __ATOMIC_RELAXED);
+    else {
+        __atomic_add_fetch(&noThreadCacheMisses[sizeClass], 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    __atomic_store_n(&headerOfBuffer(buffer)->retainCount, 1, __ATOMIC_RELAXED);
+    return buffer;
+}
+
+void *SuperpoweredAudiobufferCache::allocBuffer(unsigned int sizeBytes) {
+    ping();
+    void *buffer = getBuffer(sizeBytes);
+    if (buffer) return buffer;
+
+    unsigned int sizeClass = sizeClassOf(sizeBytes);
+    bufferHeader *header = NULL;
+    if (sizeClass == HUGECLASS) {
+        if (posix_memalign((void **)&header, CACHELINE, sizeof(bufferHeader) + (size_t)sizeBytes) != 0) return NULL;
+        header->index = NOBUFFER;
+        header->sizeClass = HUGECLASS;
+        __atomic_add_fetch(&hugeBuffers, 1, __ATOMIC_RELAXED);
+    } else {
+        // Only the threads growing the same size class wait for each other. The slab may have been created by another thread while waiting.
+        classGrowth *g = &growth[sizeClass];
+        pthread_mutex_lock(&g->lock);
+        if (popBuffers(sizeClass, &buffer, 1)) header = headerOfBuffer(buffer);
+        else {
+            header = growClass(sizeClass);
+            if (header) __atomic_store_n(&g->slabFallbacks, g->slabFallbacks + 1, __ATOMIC_RELAXED);
+        }
+        pthread_mutex_unlock(&g->lock);
+        if (!header) return NULL;
+    }
+    __atomic_store_n(&header->retainCount, 1, __ATOMIC_RELAXED);
+    return header + 1;
+}
+
+void SuperpoweredAudiobufferCache::releaseBuffer(void *buffer) {
+    bufferHeader *header = headerOfBuffer(buffer);
+    if (__atomic_sub_fetch(&header->retainCount, 1, __ATOMIC_ACQ_REL) != 0) return;
+
+    unsigned int sizeClass = header->sizeClass;
+    if (sizeClass == HUGECLASS) {
+        __atomic_sub_fetch(&hugeBuffers, 1, __ATOMIC_RELAXED);
+        free(header);
+        return;
+    }
+
+    threadCache *cache = getThreadCache();
+    if (!cache) {
+        pushBuffers(sizeClass, &buffer, 1);
+        return;
+    }
+    unsigned int *count = &cache->count[sizeClass], capacity = magazineCapacity[sizeClass];
+    if (*count == capacity) { // Full: the older half goes to the shared pool, the recently used buffers stay (warm in the cache).
+        pushBuffers(sizeClass, cache->buffers[sizeClass], capacity / 2);
+        memmove(cache->buffers[sizeClass], cache->buffers[sizeClass] + capacity / 2, (capacity - capacity / 2) * sizeof(void *));
+        *count -= capacity / 2;
+    }
+    cache->buffers[sizeClass][(*count)++] = buffer;
+}
+
+void SuperpoweredAudiobufferCache::retainBuffer(void *buffer) {
+    __atomic_add_fetch(&headerOfBuffer(buffer)->retainCount, 1, __ATOMIC_RELAXED);
+}
+
+void SuperpoweredAudiobufferCache::flushThread() {
+    if (!__atomic_load_n(&initialized, __ATOMIC_ACQUIRE)) return;
+    threadCache *cache = getThreadCache();
+    if (cache) flushCache(cache);
+}
+
+unsigned int SuperpoweredAudiobufferCache::getStats(SuperpoweredAudiobufferCacheStats stats[SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES]) {
+    memset(stats, 0, sizeof(SuperpoweredAudiobufferCacheStats) * SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES);
+    for (unsigned int sizeClass = 0; sizeClass < SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES; sizeClass++) {
+        SuperpoweredAudiobufferCacheStats *s = &stats[sizeClass];
+        s->bufferSizeBytes = classBytes(sizeClass);
+        s->buffers = __atomic_load_n(&growth[sizeClass].buffers, __ATOMIC_RELAXED);
+        s->fixedRegionBuffers = __atomic_load_n(&growth[sizeClass].fixedBuffers, __ATOMIC_RELAXED);
+        s->slabs = __atomic_load_n(&growth[sizeClass].slabs, __ATOMIC_RELAXED);
+        s->slabFallbacks = __atomic_load_n(&growth[sizeClass].slabFallbacks, __ATOMIC_RELAXED);
+        s->highWaterMark = __atomic_load_n(&pools[sizeClass].highWaterMark, __ATOMIC_RELAXED);
+        s->hits = __atomic_load_n(&noThreadCacheHits[sizeClass], __ATOMIC_RELAXED);
+        s->misses = __atomic_load_n(&noThreadCacheMisses[sizeClass], __ATOMIC_RELAXED);
+        for (int n = 0; n < SUPERPOWEREDAUDIOBUFFERCACHE_MAXTHREADS; n++) {
+            s->hits += __atomic_load_n(&threadCaches[n].hits[sizeClass], __ATOMIC_RELAXED);
+            s->misses += __atomic_load_n(&threadCaches[n].misses[sizeClass], __ATOMIC_RELAXED);
+        }
+    }
+
+    // Free buffers have zero retain count, the rest is in use.
+    unsigned int count = __atomic_load_n(&numBuffers, __ATOMIC_RELAXED);
+    for (unsigned int index = 0; index < count; index++) {
+        bufferHeader **table = __atomic_load_n(&bufferTable[index >> TABLECHUNKSHIFT], __ATOMIC_ACQUIRE);
+        if (!table) continue;
+        bufferHeader *header = __atomic_load_n(&table[index & ((1 << TABLECHUNKSHIFT) - 1)], __ATOMIC_ACQUIRE);
+        if (!header) continue;
+        int retainCount = __atomic_load_n(&header->retainCount, __ATOMIC_RELAXED);
+        if (retainCount > 0) {
+            stats[header->sizeClass].retainedBuffers++;
+            stats[header->sizeClass].retainCount += (unsigned int)retainCount;
+        }
+    }
+    return __atomic_load_n(&hugeBuffers, __ATOMIC_RELAXED);
+}
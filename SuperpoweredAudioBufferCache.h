@@ -0,0 +1,167 @@
+#ifndef Header_SuperpoweredAudioBufferCache
+#define Header_SuperpoweredAudioBufferCache
+
+#include <stddef.h>
+
+/**
+ @brief The smallest size class is 1 << SUPERPOWEREDAUDIOBUFFERCACHE_MINSHIFT bytes (256).
+ */
+#define SUPERPOWEREDAUDIOBUFFERCACHE_MINSHIFT 8
+
+/**
+ @brief The number of size classes. Every class is twice the size of the previous one, the largest is 1 MB.
+ */
+#define SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES 13
+
+/**
+ @brief The number of threads with their own magazines. Any number of threads can use the cache, the others go to the shared pool at every call.
+ */
+#define SUPERPOWEREDAUDIOBUFFERCACHE_MAXTHREADS 64
+
+/**
+ @brief The maximum number of buffers a thread keeps for itself in every size class. Large classes keep less, so threads don't hoard big buffers.
+ */
+#define SUPERPOWEREDAUDIOBUFFERCACHE_MAGAZINE 32
+
+/**
+ @brief allocBuffer() grows an exhausted size class with a slab of this many bytes (at least 2 buffers).
+ */
+#define SUPERPOWEREDAUDIOBUFFERCACHE_SLABBYTES (256 * 1024)
+
+/**
+ @brief The layout and memory options of the fixed region. @see SuperpoweredAudiobufferCache::init
+
+ @param buffersPerClass The number of buffers in every size class, the smallest class first. The region's size is the sum of the buffers plus a 64 byte header for every buffer. Size classes with 0 buffers are grown with slabs by allocBuffer() only.
+ @param lockMemory Locks the region into physical memory with mlock(), so it's never paged out. Subject to RLIMIT_MEMLOCK.
+ @param hugePages Aligns the region to 2 MB and asks for transparent hugepages, fewer TLB misses then. Ignored if the system doesn't support them.
+ */
+typedef struct SuperpoweredAudiobufferCacheConfig {
+    unsigned int buffersPerClass[SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES];
+    bool lockMemory, hugePages;
+} SuperpoweredAudiobufferCacheConfig;
+
+/**
+ @brief Statistics of a size class, to size the fixed region for production. @see SuperpoweredAudiobufferCache::getStats
+
+ @param bufferSizeBytes The size of the buffers in this class.
+ @param buffers The number of buffers in this class, in the fixed region and in the slabs.
+ @param fixedRegionBuffers The number of buffers in the fixed region.
+ @param slabs The number of slabs allocBuffer() created.
+ @param highWaterMark The most buffers ever out of the shared pool at once (in use or in thread magazines).
+ @param retainedBuffers The number of buffers in use now (retain count above zero). If it doesn't return to zero after the audio stops, buffers are leaking.
+ @param retainCount The sum of the retain counts of the buffers in use now.
+ @param hits The number of requests served with an existing buffer, without allocation.
+ @param misses The number of requests getBuffer() found no free buffer for (including the ones made by allocBuffer()).
+ @param slabFallbacks The number of allocBuffer() calls that had to create a slab.
+ */
+typedef struct SuperpoweredAudiobufferCacheStats {
+    unsigned int bufferSizeBytes, buffers, fixedRegionBuffers, slabs, highWaterMark, retainedBuffers, retainCount;
+    unsigned long long hits, misses, slabFallbacks;
+} SuperpoweredAudiobufferCacheStats;
+
+/**
+ @brief Audio buffer pool with the same interface and retain/release semantics as SuperpoweredAudiobufferPool, scaling to many threads.
+
+ Buffers are grouped into power of two size classes. Every class has a shared, lock-free pool.
+ Every thread has a magazine for every class: a small array of free buffers the thread owns. getBuffer() and releaseBuffer() work on the magazine, without atomic operations on shared memory and without touching other cores' cache lines.
+ An empty magazine is refilled with half of its capacity from the shared pool, a full magazine returns half of its capacity, with a single compare and swap.
+ A buffer can be released on any thread, it goes to the magazine of the releasing thread.
+
+ The magazines of a thread are returned to the shared pool when the thread exits.
+ Every buffer is aligned to 64 bytes.
+ */
+class SuperpoweredAudiobufferCache {
+public:
+    /**
+     @brief Creates the fixed memory region with the default configuration, if it doesn't exist yet. @see defaultConfig
+
+     Call it (or init) before the audio threads start. Not real-time safe, allocates memory.
+     */
+    static void ping();
+
+    /**
+     @brief Creates the fixed memory region. Every page of it is touched (pre-faulted), so page faults never happen in the first real-time callbacks.
+
+     Call it once, before the audio threads start and before any other function of the cache. Not real-time safe, allocates memory.
+
+     @return False if the region already exists or memory allocation failed.
+
+     @param config The layout and memory options. NULL means the default configuration.
+     @param memoryLocked Output, optional. True if the region was locked into physical memory.
+     */
+    static bool init(const SuperpoweredAudiobufferCacheConfig *config, bool *memoryLocked = NULL);
+
+    /**
+     @brief Fills a configuration with the defaults: 512 kb of buffers in every size class (at least 2 buffers), hugepages, no mlock.
+
+     @param config Output.
+     */
+    static void defaultConfig(SuperpoweredAudiobufferCacheConfig *config);
+
+    /**
+     @brief Creates a buffer with retain count set to 1.
+
+     @return The buffer, or NULL if there is no free buffer in the size class. @see allocBuffer then.
+
+     Never blocks, never locks, safe to use in a realtime thread. Can be called concurrently.
+
+     @param sizeBytes The buffer's size in bytes.
+     */
+    static void *getBuffer(unsigned int sizeBytes);
+
+    /**
+     @brief Creates a buffer with retain count set to 1. Returns with a free buffer like getBuffer() if there is one, grows the size class with a slab of SUPERPOWEREDAUDIOBUFFERCACHE_SLABBYTES otherwise.
+
+     Don't use this function in a realtime thread, as it may allocate memory. Can be called concurrently: only the threads growing the same size class wait for each other.
+     The other buffers of a new slab go to the shared pool, slabs are never freed.
+     Buffers larger than the largest size class are not pooled, releasing them calls free().
+
+     @return The buffer, or NULL if memory allocation failed.
+
+     @param sizeBytes The buffer's size in bytes.
+     */
+    static void *allocBuffer(unsigned int sizeBytes);
+
+    /**
+     @brief Release a buffer, similar to Objective-C.
+
+     Never blocks, never locks, safe to use in a realtime thread. Can be called concurrently.
+
+     @param buffer The buffer.
+     */
+    static void releaseBuffer(void *buffer);
+
+    /**
+     @brief Retain a buffer, similar to Objective-C.
+
+     Never blocks, never locks, safe to use in a realtime thread. Can be called concurrently.
+
+     @param buffer The buffer.
+     */
+    static void retainBuffer(void *buffer);
+
+    /**
+     @brief Returns the buffers in the calling thread's magazines to the shared pool. Happens automatically when the thread exits.
+
+     Call it when a worker thread goes idle for a long time, so other threads can use its buffers.
+     */
+    static void flushThread();
+
+    /**
+     @brief Reads the statistics of every size class. The counters are read without stopping the other threads, so they may be slightly inconsistent with each other.
+
+     Not real-time safe, walks every buffer. Can be called concurrently.
+
+     @return The number of buffers larger than the largest size class in use now.
+
+     @param stats Output. SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES items, the smallest size class first.
+     */
+    static unsigned int getStats(SuperpoweredAudiobufferCacheStats stats[SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES]);
+
+private:
+    SuperpoweredAudiobufferCache();
+    SuperpoweredAudiobufferCache(const SuperpoweredAudiobufferCache&);
+    SuperpoweredAudiobufferCache& operator=(const SuperpoweredAudiobufferCache&);
+};
+
+#endif
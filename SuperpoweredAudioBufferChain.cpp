@@ -0,0 +1,443 @@
+#include "SuperpoweredAudioBufferChain.h"
+#include "SuperpoweredAudioBufferCache.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+static void poolRetain(void *, void *buffer) {
+    SuperpoweredAudiobufferPool::retainBuffer(buffer);
+}
+
+static void poolRelease(void *, void *buffer) {
+    SuperpoweredAudiobufferPool::releaseBuffer(buffer);
+}
+
+static void cacheRetain(void *, void *buffer) {
+    SuperpoweredAudiobufferCache::retainBuffer(buffer);
+}
+
+static void cacheRelease(void *, void *buffer) {
+    SuperpoweredAudiobufferCache::releaseBuffer(buffer);
+}
+
+static void *poolAlloc(void *, unsigned int sizeBytes) {
+    void *buffer = SuperpoweredAudiobufferPool::getBuffer(sizeBytes);
+    return buffer ? buffer : SuperpoweredAudiobufferPool::allocBuffer(sizeBytes);
+}
+
+static void *cacheAlloc(void *, unsigned int sizeBytes) {
+    return SuperpoweredAudiobufferCache::allocBuffer(sizeBytes);
+}
+
+const SuperpoweredAudiobufferOwner SuperpoweredAudiobufferPoolOwner = { poolRetain, poolRelease, NULL, poolAlloc };
+const SuperpoweredAudiobufferOwner SuperpoweredAudiobufferCacheOwner = { cacheRetain, cacheRelease, NULL, cacheAlloc };
+
+typedef struct chainItem {
+    SuperpoweredAudiobufferlistElement element;
+    const SuperpoweredAudiobufferOwner *owner;
+} chainItem;
+
+typedef struct chainInternals {
+    chainItem *items; // Circular, the capacity is a power of two.
+    const SuperpoweredAudiobufferOwner *owner;
+    unsigned int capacity, first, count, bytesPerSample, numStereoPairs, compactCursor;
+    // The slice: items sliceFirst to sliceLast (counted from the first item), beginning at sample sliceStart of the first and ending at sample sliceEnd of the last.
+    int sliceFirst, sliceLast, sliceStart, sliceEnd;
+    int enumerators[4];
+    bool sliceValid;
+} chainInternals;
+
+static inline chainItem *itemAt(chainInternals *internals, unsigned int index) {
+    return internals->items + ((internals->first + index) & (internals->capacity - 1));
+}
+
+// The part of samplesUsed belonging to numSamples of an item.
+static inline float samplesUsedOf(const SuperpoweredAudiobufferlistElement *element, int numSamples) {
+    int length = element->endSample - element->startSample;
+    return (length > 0) ? element->samplesUsed * (float)numSamples / (float)length : 0;
+}
+
+static void releaseItem(chainInternals *internals, chainItem *item) {
+    for (unsigned int pair = 0; pair < internals->numStereoPairs; pair++) if (item->element.buffers[pair]) item->owner->release(item->owner->clientData, item->element.buffers[pair]);
+}
+
+static void retainItem(chainInternals *internals, chainItem *item) {
+    for (unsigned int pair = 0; pair < internals->numStereoPairs; pair++) if (item->element.buffers[pair]) item->owner->retain(item->owner->clientData, item->element.buffers[pair]);
+}
+
+// Grows the capacity to a bigger power of two, the items are moved to the beginning of the new array.
+static bool grow(chainInternals *internals, unsigned int capacity) {
+    chainItem *items = (chainItem *)malloc(sizeof(chainItem) * capacity);
+    if (!items) return false;
+    for (unsigned int n = 0; n < internals->count; n++) items[n] = *itemAt(internals, n);
+    free(internals->items);
+    internals->items = items;
+    internals->first = 0;
+    internals->capacity = capacity;
+    return true;
+}
+
+// Takes ownership. Returns with the new item's place, or NULL if memory allocation failed (the buffers are released then).
+static chainItem *addItem(chainInternals *internals, SuperpoweredAudiobufferlistElement *buffer, const SuperpoweredAudiobufferOwner *owner, bool toTheBeginning) {
+    chainItem item;
+    item.element = *buffer;
+    item.owner = owner ? owner : internals->owner;
+    for (unsigned int pair = internals->numStereoPairs; pair < 4; pair++) item.element.buffers[pair] = NULL;
+
+    if ((internals->count == internals->capacity) && !grow(internals, internals->capacity ? internals->capacity * 2 : 4)) {
+        releaseItem(internals, &item);
+        return NULL;
+    }
+    if (toTheBeginning) internals->first = (internals->first - 1) & (internals->capacity - 1);
+    internals->count++;
+    chainItem *place = itemAt(internals, toTheBeginning ? 0 : internals->count - 1);
+    *place = item;
+    internals->sliceValid = false;
+    return place;
+}
+
+SuperpoweredAudiobufferChain::SuperpoweredAudiobufferChain(unsigned int bytesPerSample, unsigned int typicalNumElements, unsigned int numStereoPairs, const SuperpoweredAudiobufferOwner *owner) : sampleLength(0) {
+    internals = new chainInternals;
+    memset(internals, 0, sizeof(chainInternals));
+    unsigned int capacity = 4;
+    while (capacity < typicalNumElements) capacity *= 2;
+    internals->items = (chainItem *)malloc(sizeof(chainItem) * capacity);
+    internals->capacity = internals->items ? capacity : 0; // Out of memory: no room for items, the next append(), insert() or reserve() tries again.
+    internals->owner = owner ? owner : &SuperpoweredAudiobufferPoolOwner;
+    internals->bytesPerSample = bytesPerSample;
+    internals->numStereoPairs = (numStereoPairs < 1) ? 1 : ((numStereoPairs > 4) ? 4 : numStereoPairs);
+}
+
+SuperpoweredAudiobufferChain::~SuperpoweredAudiobufferChain() {
+    clear();
+    free(internals->items);
+    delete internals;
+}
+
+void SuperpoweredAudiobufferChain::append(SuperpoweredAudiobufferlistElement *buffer, const SuperpoweredAudiobufferOwner *owner) {
+    if (addItem(internals, buffer, owner, false)) sampleLength += buffer->endSample - buffer->startSample;
+}
+
+void SuperpoweredAudiobufferChain::insert(SuperpoweredAudiobufferlistElement *buffer, const SuperpoweredAudiobufferOwner *owner) {
+    if (addItem(internals, buffer, owner, true)) sampleLength += buffer->endSample - buffer->startSample;
+}
+
+bool SuperpoweredAudiobufferChain::reserve(unsigned int numItems) {
+    unsigned int capacity = internals->capacity ? internals->capacity : 4;
+    while (capacity < numItems) capacity *= 2;
+    return (capacity == internals->capacity) || grow(internals, capacity);
+}
+
+unsigned int SuperpoweredAudiobufferChain::freeItems() {
+    return internals->capacity - internals->count;
+}
+
+void SuperpoweredAudiobufferChain::clear() {
+    for (unsigned int n = 0; n < internals->count; n++) releaseItem(internals, itemAt(internals, n));
+    internals->count = internals->first = 0;
+    internals->sliceValid = false;
+    sampleLength = 0;
+}
+
+void SuperpoweredAudiobufferChain::copyAllBuffersTo(SuperpoweredAudiobufferChain *anotherList) {
+    for (unsigned int n = 0; n < internals->count; n++) {
+        chainItem *item = itemAt(internals, n);
+        retainItem(internals, item);
+        anotherList->append(&item->element, item->owner);
+    }
+}
+
+void SuperpoweredAudiobufferChain::truncate(int numSamples, bool fromTheBeginning) {
+    internals->sliceValid = false;
+    while ((numSamples > 0) && internals->count) {
+        chainItem *item = itemAt(internals, fromTheBeginning ? 0 : internals->count - 1);
+        SuperpoweredAudiobufferlistElement *element = &item->element;
+        int length = element->endSample - element->startSample;
+
+        if (length <= numSamples) { // The entire item goes.
+            releaseItem(internals, item);
+            if (fromTheBeginning) internals->first = (internals->first + 1) & (internals->capacity - 1);
+            internals->count--;
+            numSamples -= length;
+            sampleLength -= length;
+        } else { // All stereo pairs share startSample and endSample, so they stay aligned.
+            float samplesUsed = samplesUsedOf(element, numSamples);
+            if (fromTheBeginning) {
+                element->startSample += numSamples;
+                element->samplePosition += (int64_t)(samplesUsed + 0.5f);
+            } else element->endSample -= numSamples;
+            element->samplesUsed -= samplesUsed;
+            sampleLength -= numSamples;
+            numSamples = 0;
+        }
+    }
+    if (!internals->count) internals->first = 0;
+}
+
+int64_t SuperpoweredAudiobufferChain::startSamplePosition() {
+    return internals->count ? itemAt(internals, 0)->element.samplePosition : 0;
+}
+
+int64_t SuperpoweredAudiobufferChain::nextSamplePosition() {
+    if (!internals->count) return 0;
+    SuperpoweredAudiobufferlistElement *element = &itemAt(internals, internals->count - 1)->element;
+    return element->samplePosition + (int64_t)(element->samplesUsed + 0.5f);
+}
+
+bool SuperpoweredAudiobufferChain::makeSlice(int fromSample, int lengthSamples) {
+    internals->sliceValid = false;
+    if ((fromSample < 0) || (lengthSamples < 1) || (fromSample + lengthSamples > sampleLength)) return false;
+
+    int position = 0, toSample = fromSample + lengthSamples;
+    unsigned int n = 0;
+    while (true) { // The first item.
+        SuperpoweredAudiobufferlistElement *element = &itemAt(internals, n)->element;
+        int length = element->endSample - element->startSample;
+        if (fromSample < position + length) {
+            internals->sliceFirst = (int)n;
+            internals->sliceStart = element->startSample + fromSample - position;
+            break;
+        }
+        position += length;
+        n++;
+    }
+    while (true) { // The last item.
+        SuperpoweredAudiobufferlistElement *element = &itemAt(internals, n)->element;
+        int length = element->endSample - element->startSample;
+        if (toSample <= position + length) {
+            internals->sliceLast = (int)n;
+            internals->sliceEnd = element->startSample + toSample - position;
+            break;
+        }
+        position += length;
+        n++;
+    }
+
+    for (int pair = 0; pair < 4; pair++) internals->enumerators[pair] = internals->sliceFirst;
+    internals->sliceValid = true;
+    return true;
+}
+
+int64_t SuperpoweredAudiobufferChain::samplePositionOfSliceBeginning() {
+    if (!internals->sliceValid) return 0;
+    SuperpoweredAudiobufferlistElement *element = &itemAt(internals, internals->sliceFirst)->element;
+    return element->samplePosition + (int64_t)(samplesUsedOf(element, internals->sliceStart - element->startSample) + 0.5f);
+}
+
+// The part of an item inside the slice.
+static inline void sliceRange(chainInternals *internals, int index, SuperpoweredAudiobufferlistElement *element, int *start, int *end) {
+    *start = (index == internals->sliceFirst) ? internals->sliceStart : element->startSample;
+    *end = (index == internals->sliceLast) ? internals->sliceEnd : element->endSample;
+}
+
+// Returns with the audio of the item at the enumerator, then moves the enumerator by step.
+static void *sliceItem(chainInternals *internals, int step, int *lengthSamples, float *samplesUsed, int stereoPairIndex) {
+    if (!internals->sliceValid || (stereoPairIndex < 0) || (stereoPairIndex >= (int)internals->numStereoPairs)) return NULL;
+    int index = internals->enumerators[stereoPairIndex];
+    if ((index < internals->sliceFirst) || (index > internals->sliceLast)) return NULL;
+    internals->enumerators[stereoPairIndex] += step;
+
+    SuperpoweredAudiobufferlistElement *element = &itemAt(internals, index)->element;
+    int start, end;
+    sliceRange(internals, index, element, &start, &end);
+    *lengthSamples = end - start;
+    if (samplesUsed) *samplesUsed = samplesUsedOf(element, end - start);
+    return (char *)element->buffers[stereoPairIndex] + start * internals->bytesPerSample;
+}
+
+void *SuperpoweredAudiobufferChain::nextSliceItem(int *lengthSamples, float *samplesUsed, int stereoPairIndex) {
+    return sliceItem(internals, 1, lengthSamples, samplesUsed, stereoPairIndex);
+}
+
+void *SuperpoweredAudiobufferChain::prevSliceItem(int *lengthSamples, float *samplesUsed, int stereoPairIndex) {
+    return sliceItem(internals, -1, lengthSamples, samplesUsed, stereoPairIndex);
+}
+
+void SuperpoweredAudiobufferChain::rewindSlice() {
+    for (int pair = 0; pair < 4; pair++) internals->enumerators[pair] = internals->sliceFirst;
+}
+
+void SuperpoweredAudiobufferChain::forwardToLastSliceBuffer() {
+    for (int pair = 0; pair < 4; pair++) internals->enumerators[pair] = internals->sliceLast;
+}
+
+bool SuperpoweredAudiobufferChain::nextSliceElement(SuperpoweredAudiobufferlistElement *element, bool retainBuffers) {
+    if (!internals->sliceValid) return false;
+    int index = internals->enumerators[0];
+    if ((index < internals->sliceFirst) || (index > internals->sliceLast)) return false;
+    internals->enumerators[0]++;
+
+    chainItem *item = itemAt(internals, index);
+    int start, end;
+    sliceRange(internals, index, &item->element, &start, &end);
+    *element = item->element;
+    element->samplePosition += (int64_t)(samplesUsedOf(&item->element, start - item->element.startSample) + 0.5f);
+    element->samplesUsed = samplesUsedOf(&item->element, end - start);
+    element->startSample = start;
+    element->endSample = end;
+    if (retainBuffers) retainItem(internals, item);
+    return true;
+}
+
+unsigned int SuperpoweredAudiobufferChain::getSliceSegments(struct iovec *segments, unsigned int maxSegments, int stereoPairIndex) {
+    if (!internals->sliceValid || (stereoPairIndex < 0) || (stereoPairIndex >= (int)internals->numStereoPairs)) return 0;
+    for (int index = internals->sliceFirst; (index <= internals->sliceLast) && ((unsigned int)(index - internals->sliceFirst) < maxSegments); index++) {
+        SuperpoweredAudiobufferlistElement *element = &itemAt(internals, index)->element;
+        int start, end;
+        sliceRange(internals, index, element, &start, &end);
+        segments->iov_base = (char *)element->buffers[stereoPairIndex] + start * internals->bytesPerSample;
+        segments->iov_len = (size_t)(end - start) * internals->bytesPerSample;
+        segments++;
+    }
+    return (unsigned int)(internals->sliceLast - internals->sliceFirst + 1);
+}
+
+void *SuperpoweredAudiobufferChain::getSliceContiguous(void *scratch, int stereoPairIndex) {
+    struct iovec segment;
+    unsigned int numSegments = getSliceSegments(&segment, 1, stereoPairIndex);
+    if (numSegments == 0) return NULL;
+    if (numSegments == 1) return segment.iov_base;
+
+    char *output = (char *)scratch;
+    for (int index = internals->sliceFirst; index <= internals->sliceLast; index++) {
+        SuperpoweredAudiobufferlistElement *element = &itemAt(internals, index)->element;
+        int start, end;
+        sliceRange(internals, index, element, &start, &end);
+        size_t bytes = (size_t)(end - start) * internals->bytesPerSample;
+        memcpy(output, (char *)element->buffers[stereoPairIndex] + start * internals->bytesPerSample, bytes);
+        output += bytes;
+    }
+    return scratch;
+}
+
+#define WRITESEGMENTS 64
+
+bool SuperpoweredAudiobufferChain::writeSlice(FILE *fd, int stereoPairIndex) {
+    if (!internals->sliceValid || (stereoPairIndex < 0) || (stereoPairIndex >= (int)internals->numStereoPairs)) return false;
+    if (fflush(fd) != 0) return false; // Anything buffered by stdio goes first.
+    int file = fileno(fd);
+
+    struct iovec segments[WRITESEGMENTS];
+    int index = internals->sliceFirst;
+    while (index <= internals->sliceLast) {
+        int numSegments = 0;
+        while ((numSegments < WRITESEGMENTS) && (index <= internals->sliceLast)) {
+            SuperpoweredAudiobufferlistElement *element = &itemAt(internals, index++)->element;
+            int start, end;
+            sliceRange(internals, index - 1, element, &start, &end);
+            segments[numSegments].iov_base = (char *)element->buffers[stereoPairIndex] + start * internals->bytesPerSample;
+            segments[numSegments++].iov_len = (size_t)(end - start) * internals->bytesPerSample;
+        }
+
+        struct iovec *segment = segments;
+        while (numSegments > 0) { // writev may write less than asked.
+            ssize_t written = writev(file, segment, numSegments);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            while ((numSegments > 0) && ((size_t)written >= segment->iov_len)) {
+                written -= segment->iov_len;
+                segment++;
+                numSegments--;
+            }
+            if (numSegments > 0) {
+                segment->iov_base = (char *)segment->iov_base + written;
+                segment->iov_len -= (size_t)written;
+            }
+        }
+    }
+    // The stdio position follows the file descriptor again, so closeWAV finds the right length.
+    return fseek(fd, 0, SEEK_END) == 0;
+}
+
+static inline int itemLength(chainInternals *internals, unsigned int index) {
+    SuperpoweredAudiobufferlistElement *element = &itemAt(internals, index)->element;
+    return element->endSample - element->startSample;
+}
+
+// True if an item can join a run starting at samplePosition with samplesUsed so far: it starts in the source where the run ends,
+// and the merged item ends where it ends (the rounding of fractional samplesUsed doesn't move the end).
+static inline bool continues(const SuperpoweredAudiobufferlistElement *next, int64_t samplePosition, float samplesUsed) {
+    return (next->samplePosition == samplePosition + (int64_t)(samplesUsed + 0.5f))
+        && (samplePosition + (int64_t)(samplesUsed + next->samplesUsed + 0.5f) == next->samplePosition + (int64_t)(next->samplesUsed + 0.5f));
+}
+
+// Replaces items first to last with one item in new buffers. False if the buffers could not be created.
+static bool mergeItems(chainInternals *internals, unsigned int first, unsigned int last, int lengthSamples) {
+    const SuperpoweredAudiobufferOwner *owner = internals->owner;
+    SuperpoweredAudiobufferlistElement merged;
+    memset(&merged, 0, sizeof(merged));
+
+    for (unsigned int pair = 0; pair < internals->numStereoPairs; pair++) {
+        char *output = (char *)owner->alloc(owner->clientData, (unsigned int)lengthSamples * internals->bytesPerSample);
+        if (!output) {
+            for (unsigned int n = 0; n < pair; n++) owner->release(owner->clientData, merged.buffers[n]);
+            return false;
+        }
+        merged.buffers[pair] = output;
+        for (unsigned int index = first; index <= last; index++) {
+            SuperpoweredAudiobufferlistElement *element = &itemAt(internals, index)->element;
+            size_t bytes = (size_t)(element->endSample - element->startSample) * internals->bytesPerSample;
+            if (element->buffers[pair]) memcpy(output, (char *)element->buffers[pair] + element->startSample * internals->bytesPerSample, bytes);
+            else memset(output, 0, bytes);
+            output += bytes;
+        }
+    }
+
+    merged.samplePosition = itemAt(internals, first)->element.samplePosition;
+    merged.endSample = lengthSamples;
+    for (unsigned int index = first; index <= last; index++) {
+        chainItem *item = itemAt(internals, index);
+        merged.samplesUsed += item->element.samplesUsed;
+        releaseItem(internals, item);
+    }
+
+    chainItem *item = itemAt(internals, first);
+    item->element = merged;
+    item->owner = owner;
+    unsigned int removed = last - first;
+    for (unsigned int index = last + 1; index < internals->count; index++) *itemAt(internals, index - removed) = *itemAt(internals, index);
+    internals->count -= removed;
+    return true;
+}
+
+unsigned int SuperpoweredAudiobufferChain::compact(unsigned int maxSamples, int smallItemSamples, int targetItemSamples) {
+    if (!internals->owner->alloc) return 0;
+    unsigned int index = (internals->compactCursor < internals->count) ? internals->compactCursor : 0, removed = 0, copied = 0;
+
+    while (index + 1 < internals->count) {
+        // A run of small items following each other, not longer than the target.
+        unsigned int last = index;
+        int lengthSamples = itemLength(internals, index);
+        int64_t samplePosition = itemAt(internals, index)->element.samplePosition;
+        float samplesUsed = itemAt(internals, index)->element.samplesUsed;
+        bool full = false; // No more copying in this call.
+        if (lengthSamples < smallItemSamples) while (last + 1 < internals->count) {
+            SuperpoweredAudiobufferlistElement *next = &itemAt(internals, last + 1)->element;
+            int nextLength = next->endSample - next->startSample;
+            if ((nextLength >= smallItemSamples) || (lengthSamples + nextLength > targetItemSamples) || !continues(next, samplePosition, samplesUsed)) break;
+            // The run ends at the copy limit. The first run of a call merges at least two items, so every call makes progress.
+            if ((copied + (unsigned int)(lengthSamples + nextLength) > maxSamples) && (copied || (last > index))) {
+                full = true;
+                break;
+            }
+            lengthSamples += nextLength;
+            samplesUsed += next->samplesUsed;
+            last++;
+        }
+
+        if (last > index) {
+            if (!mergeItems(internals, index, last, lengthSamples)) break;
+            copied += (unsigned int)lengthSamples;
+            removed += last - index;
+        } else if (full) break; // The next call continues with this item.
+        index++;
+        if (full) break;
+    }
+
+    internals->compactCursor = (index + 1 < internals->count) ? index : 0;
+    if (removed) internals->sliceValid = false;
+    return removed;
+}
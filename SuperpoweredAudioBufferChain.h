@@ -0,0 +1,227 @@
+#ifndef Header_SuperpoweredAudioBufferChain
+#define Header_SuperpoweredAudioBufferChain
+
+#include "SuperpoweredAudioBuffers.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <sys/uio.h>
+
+struct chainInternals;
+
+/**
+ @brief Retains and releases the buffers of a list item. Every item of a chain has an owner, so items from different sources can be mixed.
+
+ @param retain Retains a buffer.
+ @param release Releases a buffer.
+ @param clientData Passed to retain, release and alloc.
+ @param alloc Optional, creates a buffer with retain count set to 1. Needed for the chain's default owner by compact().
+ */
+typedef struct SuperpoweredAudiobufferOwner {
+    void (*retain)(void *clientData, void *buffer);
+    void (*release)(void *clientData, void *buffer);
+    void *clientData;
+    void *(*alloc)(void *clientData, unsigned int sizeBytes);
+} SuperpoweredAudiobufferOwner;
+
+/**
+ @brief Buffers coming from SuperpoweredAudiobufferPool.
+ */
+extern const SuperpoweredAudiobufferOwner SuperpoweredAudiobufferPoolOwner;
+
+/**
+ @brief Buffers coming from SuperpoweredAudiobufferCache.
+ */
+extern const SuperpoweredAudiobufferOwner SuperpoweredAudiobufferCacheOwner;
+
+/**
+ @brief An audio buffer chain with the same interface as SuperpoweredAudiopointerList, handling up to 4 stereo pairs in one list.
+
+ Every item carries one buffer per stereo pair (buffers[0] to buffers[numStereoPairs - 1]), sharing the same startSample, endSample, samplePosition and samplesUsed. So append, insert, truncate and makeSlice keep all pairs aligned, and multi-pair material (STEMS, 8 channels) needs no separate lists.
+ The items are stored in one array, enumeration doesn't chase pointers.
+
+ The chain takes ownership of the buffers appended or inserted: the caller's retain goes to the chain, and the chain releases the buffers when the item leaves the chain.
+ Modifying the chain (append, insert, truncate, clear) ends the current slice, call makeSlice again.
+ Not thread safe, one thread should use an instance at a time.
+
+ @param sampleLength The number of samples inside this list. Read only.
+ */
+class SuperpoweredAudiobufferChain {
+public:
+    int sampleLength;
+
+    /**
+     @brief Creates an audio buffer chain.
+
+     If memory allocation fails, the chain has no room for items: freeItems() returns 0, and reserve() returns false until it succeeds.
+
+     @param bytesPerSample Sample size of one stereo pair. For example: 4 for 16-bit stereo, 8 for 32-bit stereo audio.
+     @param typicalNumElements Each list item uses 64 bytes memory on a 64-bit device. This number sets the initial memory usage of this list.
+     @param numStereoPairs The number of stereo pairs (1-4), the number of buffers used in every item.
+     @param owner The owner of the buffers appended or inserted without an explicit owner. NULL means SuperpoweredAudiobufferPoolOwner. Must be valid during the life of the chain.
+     */
+    SuperpoweredAudiobufferChain(unsigned int bytesPerSample, unsigned int typicalNumElements, unsigned int numStereoPairs = 1, const SuperpoweredAudiobufferOwner *owner = NULL);
+    ~SuperpoweredAudiobufferChain();
+
+    /**
+     @brief Append a buffer to the end of the list. The chain takes ownership of the buffers.
+
+     @param buffer The item, copied. Only the first numStereoPairs buffers are used.
+     @param owner The owner of the buffers. NULL means the chain's default owner. Must be valid as long as the buffers are in the chain.
+     */
+    void append(SuperpoweredAudiobufferlistElement *buffer, const SuperpoweredAudiobufferOwner *owner = NULL);
+
+    /**
+     @brief Insert a buffer before the beginning of the list. The chain takes ownership of the buffers.
+
+     @param buffer The item, copied. Only the first numStereoPairs buffers are used.
+     @param owner The owner of the buffers. NULL means the chain's default owner. Must be valid as long as the buffers are in the chain.
+     */
+    void insert(SuperpoweredAudiobufferlistElement *buffer, const SuperpoweredAudiobufferOwner *owner = NULL);
+
+    /**
+     @brief Makes room for items, so append() and insert() don't allocate memory until the chain has more items than this. Call it before the chain is used in a realtime thread.
+
+     @return False if memory allocation failed.
+
+     @param numItems The number of items.
+     */
+    bool reserve(unsigned int numItems);
+
+    /**
+     @brief Returns with the number of items append() or insert() can add without allocating memory.
+     */
+    unsigned int freeItems();
+
+    /**
+     @brief Remove everything from the list.
+     */
+    void clear();
+
+    /**
+     @brief Appends all buffers to another buffer chain, retaining them. The other chain should have the same bytes per sample and number of stereo pairs.
+     */
+    void copyAllBuffersTo(SuperpoweredAudiobufferChain *anotherList);
+
+    /**
+     @brief Removes samples from the beginning or the end, from every stereo pair.
+
+     @param numSamples The number of samples to remove.
+     @param fromTheBeginning From the end or the beginning.
+     */
+    void truncate(int numSamples, bool fromTheBeginning);
+    /**
+     @brief Returns the buffer list beginning's sample position in an audio file or stream.
+     */
+    int64_t startSamplePosition();
+    /**
+     @brief Returns the buffer list end's sample position in an audio file or stream, plus 1.
+     */
+    int64_t nextSamplePosition();
+
+    /**
+     @brief Creates a "virtual slice" from this list, for every stereo pair.
+
+     @return False if the list doesn't have enough samples.
+
+     @param fromSample The slice will start from this sample.
+     @param lengthSamples The slice will contain this number of samples.
+     */
+    bool makeSlice(int fromSample, int lengthSamples);
+    /**
+     @brief Returns the slice beginning's sample position in an audio file or stream.
+     */
+    int64_t samplePositionOfSliceBeginning();
+
+    /**
+     @return This the slice's forward enumerator method to go through all buffers in it. Returns with a pointer to the audio, or NULL.
+
+     Every stereo pair has its own enumerator, so the pairs can be enumerated one after the other or interleaved.
+
+     @param lengthSamples Returns with the number of samples in audio.
+     @param samplesUsed Returns with the number of original number of samples, creating this chunk of audio. Good for time-stretching for example, to track the movement of the playhead.
+     @param stereoPairIndex The stereo pair to enumerate.
+     */
+    void *nextSliceItem(int *lengthSamples, float *samplesUsed = 0, int stereoPairIndex = 0);
+    /**
+     @brief Returns the slice enumerators of every stereo pair to the first buffer.
+     */
+    void rewindSlice();
+    /**
+     @brief Jumps the enumerators of every stereo pair to the last buffer.
+     */
+    void forwardToLastSliceBuffer();
+    /**
+     @return This the slice's backwards (reverse) enumerator method to go through all buffers in it. Returns with a pointer to the audio, or NULL.
+
+     @param lengthSamples Returns with the number of samples in audio.
+     @param samplesUsed Returns with the number of original number of samples, creating this chunk of audio. Good for time-stretching for example, to track the movement of the playhead.
+     @param stereoPairIndex The stereo pair to enumerate.
+     */
+    void *prevSliceItem(int *lengthSamples, float *samplesUsed = 0, int stereoPairIndex = 0);
+
+    /**
+     @brief Forward enumerator returning with all stereo pairs at once, as a list item. Uses the enumerator of stereo pair 0.
+
+     The item can be passed to SuperpoweredTimeStretching::process or SuperpoweredFrequencyDomain::addInput after setStereoPairs(numStereoPairs), without copying the pairs into separate buffers.
+
+     @return False at the end of the slice.
+
+     @param element Returns with the item. startSample and endSample are limited to the slice, samplePosition and samplesUsed are adjusted to them.
+     @param retainBuffers Retains the buffers for a consumer taking ownership of them (such as SuperpoweredTimeStretching::process for pool buffers).
+     */
+    bool nextSliceElement(SuperpoweredAudiobufferlistElement *element, bool retainBuffers);
+
+    /**
+     @brief Exports the slice as an array of {pointer, length in bytes} segments pointing into the buffers, without copying. Doesn't move the enumerators.
+
+     @return The number of segments in the slice. If it's more than maxSegments, only the first maxSegments are filled, call it again with a bigger array.
+
+     @param segments Output, ready for writev().
+     @param maxSegments The size of segments.
+     @param stereoPairIndex The stereo pair to export.
+     */
+    unsigned int getSliceSegments(struct iovec *segments, unsigned int maxSegments, int stereoPairIndex = 0);
+
+    /**
+     @brief Returns with the slice as contiguous audio. Copies only if the slice crosses buffer boundaries.
+
+     @return A pointer into the buffer holding the entire slice, or scratch with a copy of the slice. NULL if there is no slice.
+
+     @param scratch At least the slice's length * bytesPerSample bytes big, used only when the slice is made of more than one buffer.
+     @param stereoPairIndex The stereo pair.
+     */
+    void *getSliceContiguous(void *scratch, int stereoPairIndex = 0);
+
+    /**
+     @brief Writes the slice to a file with writev(), without copying the audio into a contiguous buffer first.
+
+     Made for files created with createWAV (the chain should hold 16-bit stereo audio then, bytesPerSample = 4), close them with closeWAV as usual. Works with any file opened for writing. Not for a live audio processing loop.
+
+     @return False on a write error.
+
+     @param fd The file handle.
+     @param stereoPairIndex The stereo pair to write.
+     */
+    bool writeSlice(FILE *fd, int stereoPairIndex = 0);
+
+    /**
+     @brief Merges runs of small adjacent items into larger buffers, so enumeration walks fewer items. Incremental: continues where the previous call stopped, and copies at most maxSamples samples per call (or two items, if they are longer together).
+
+     Items are merged only if they follow each other in the source (the samplePosition of the next one is where the previous one ends), so samplePosition and samplesUsed stay intact. The new buffers are created by the chain's default owner, which needs an alloc function.
+     Ends the current slice if anything was merged. Not real-time safe if the owner's alloc may allocate memory. Call it from the thread using the chain, for example a background thread building or rendering the chain, between two operations.
+
+     @return The number of items removed.
+
+     @param maxSamples The maximum number of samples to copy in this call.
+     @param smallItemSamples Items shorter than this are merged.
+     @param targetItemSamples Merged items are not longer than this.
+     */
+    unsigned int compact(unsigned int maxSamples, int smallItemSamples = 1024, int targetItemSamples = 8192);
+
+private:
+    chainInternals *internals;
+    SuperpoweredAudiobufferChain(const SuperpoweredAudiobufferChain&);
+    SuperpoweredAudiobufferChain& operator=(const SuperpoweredAudiobufferChain&);
+};
+
+#endif
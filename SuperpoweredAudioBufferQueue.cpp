@@ -0,0 +1,124 @@
+#include "SuperpoweredAudioBufferQueue.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define CACHELINE 64
+
+// Vyukov's bounded queue. The sequence tells the state of a slot: equal to the write position when free, write position + 1 when filled.
+// The consumer sets it to the position of the next round (position + capacity) when it takes the item.
+typedef struct queueSlot {
+    unsigned int sequence;
+    SuperpoweredAudiobufferlistElement element;
+    const SuperpoweredAudiobufferOwner *owner;
+} queueSlot;
+
+typedef struct queueInternals {
+    unsigned int writePosition; // Producers. The positions are on different cache lines.
+    char pad0[CACHELINE - sizeof(unsigned int)];
+    unsigned int readPosition, lastWatermarkWritePosition; // Consumer.
+    char pad1[CACHELINE - 2 * sizeof(unsigned int)];
+    queueSlot *slots;
+    unsigned int mask, lowWatermark;
+    SuperpoweredAudiobufferQueueCallback callback;
+    void *clientData;
+    bool multipleProducers;
+} queueInternals;
+
+static bool takeItem(queueInternals *internals, SuperpoweredAudiobufferlistElement *element, const SuperpoweredAudiobufferOwner **owner);
+
+SuperpoweredAudiobufferQueue::SuperpoweredAudiobufferQueue(unsigned int capacity, bool multipleProducers) {
+    unsigned int size = 2;
+    while (size < capacity) size *= 2;
+    internals = new queueInternals;
+    memset(internals, 0, sizeof(queueInternals));
+    internals->slots = (queueSlot *)malloc(sizeof(queueSlot) * size);
+    if (internals->slots) for (unsigned int n = 0; n < size; n++) internals->slots[n].sequence = n;
+    internals->mask = size - 1;
+    internals->multipleProducers = multipleProducers;
+    internals->lastWatermarkWritePosition = 0xffffffff;
+}
+
+SuperpoweredAudiobufferQueue::~SuperpoweredAudiobufferQueue() {
+    SuperpoweredAudiobufferlistElement element;
+    const SuperpoweredAudiobufferOwner *owner;
+    while (takeItem(internals, &element, &owner)) {
+        for (int n = 0; n < 4; n++) if (element.buffers[n]) owner->release(owner->clientData, element.buffers[n]);
+    }
+    free(internals->slots);
+    delete internals;
+}
+
+void SuperpoweredAudiobufferQueue::setWatermark(unsigned int lowWatermark, SuperpoweredAudiobufferQueueCallback callback, void *clientData) {
+    internals->lowWatermark = lowWatermark;
+    internals->callback = callback;
+    internals->clientData = clientData;
+}
+
+bool SuperpoweredAudiobufferQueue::push(SuperpoweredAudiobufferlistElement *element, const SuperpoweredAudiobufferOwner *owner) {
+    if (!internals->slots) return false; // Out of memory at creation, zero capacity.
+    unsigned int position = __atomic_load_n(&internals->writePosition, __ATOMIC_RELAXED);
+    queueSlot *slot;
+
+    if (internals->multipleProducers) while (true) { // Claim the slot by moving the write position.
+        slot = &internals->slots[position & internals->mask];
+        int difference = (int)(__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) - position);
+        if (difference == 0) {
+            if (__atomic_compare_exchange_n(&internals->writePosition, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+        } else if (difference < 0) return false; // Full.
+        else position = __atomic_load_n(&internals->writePosition, __ATOMIC_RELAXED);
+    } else {
+        slot = &internals->slots[position & internals->mask];
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != position) return false; // Full.
+        __atomic_store_n(&internals->writePosition, position + 1, __ATOMIC_RELAXED);
+    }
+
+    slot->element = *element;
+    slot->owner = owner ? owner : &SuperpoweredAudiobufferPoolOwner;
+    __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+// Takes the first item if there is one, without the watermark check.
+static bool takeItem(queueInternals *internals, SuperpoweredAudiobufferlistElement *element, const SuperpoweredAudiobufferOwner **owner) {
+    if (!internals->slots) return false;
+    unsigned int position = internals->readPosition;
+    queueSlot *slot = &internals->slots[position & internals->mask];
+    if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != position + 1) return false; // Empty, or the producer is still writing it.
+
+    *element = slot->element;
+    if (owner) *owner = slot->owner;
+    __atomic_store_n(&slot->sequence, position + internals->mask + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&internals->readPosition, position + 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+static void checkWatermark(queueInternals *internals) {
+    if (!internals->callback) return;
+    unsigned int writePosition = __atomic_load_n(&internals->writePosition, __ATOMIC_RELAXED), numItems = writePosition - internals->readPosition;
+    if ((numItems > internals->lowWatermark) || (writePosition == internals->lastWatermarkWritePosition)) return;
+    internals->lastWatermarkWritePosition = writePosition; // Nothing new was pushed since the last call, don't call again.
+    internals->callback(internals->clientData, numItems);
+}
+
+bool SuperpoweredAudiobufferQueue::pop(SuperpoweredAudiobufferlistElement *element, const SuperpoweredAudiobufferOwner **owner) {
+    bool success = takeItem(internals, element, owner);
+    checkWatermark(internals);
+    return success;
+}
+
+unsigned int SuperpoweredAudiobufferQueue::drainTo(SuperpoweredAudiobufferChain *chain, unsigned int maxItems) {
+    SuperpoweredAudiobufferlistElement element;
+    const SuperpoweredAudiobufferOwner *owner;
+    unsigned int numItems = 0;
+    while ((numItems < maxItems) && chain->freeItems() && takeItem(internals, &element, &owner)) { // Growing the chain would allocate.
+        chain->append(&element, owner);
+        numItems++;
+    }
+    checkWatermark(internals);
+    return numItems;
+}
+
+unsigned int SuperpoweredAudiobufferQueue::count() {
+    unsigned int readPosition = __atomic_load_n(&internals->readPosition, __ATOMIC_RELAXED); // The read position never passes the write position loaded after it.
+    return __atomic_load_n(&internals->writePosition, __ATOMIC_RELAXED) - readPosition;
+}
@@ -0,0 +1,90 @@
+#ifndef Header_SuperpoweredAudioBufferQueue
+#define Header_SuperpoweredAudioBufferQueue
+
+#include "SuperpoweredAudioBufferChain.h"
+
+struct queueInternals;
+
+/**
+ @brief Called by the consumer when the number of items in the queue drops to the low watermark. Called again only after new items were pushed.
+
+ It runs on the consumer thread, which is usually the audio thread: it should only wake up the producer (post a semaphore, signal a condition variable), never block.
+
+ @param clientData Some custom pointer you set at setWatermark().
+ @param numItems The number of items in the queue.
+ */
+typedef void (* SuperpoweredAudiobufferQueueCallback) (void *clientData, unsigned int numItems);
+
+/**
+ @brief Bounded, lock-free queue of list items, to move decoded audio from a loader thread into the audio thread's SuperpoweredAudiobufferChain.
+
+ One consumer thread, one or more producer threads. Never allocates memory after creation, never blocks, never locks, so both ends are safe to use in a realtime thread.
+ Ownership moves with the items: a successful push() hands the caller's retain of the buffers to the queue, pop() and drainTo() hand it to the consumer. Nothing is retained or released on the way, only the items being destroyed with the queue are released.
+ Unused buffer pointers in the items should be NULL.
+ */
+class SuperpoweredAudiobufferQueue {
+public:
+    /**
+     @brief Creates a queue.
+
+     If memory allocation fails, the queue has zero capacity: push() always returns false, and the queue is always empty.
+
+     @param capacity The maximum number of items in the queue, rounded up to a power of two.
+     @param multipleProducers Set it to true if more than one thread pushes items. A single producer is a little bit faster.
+     */
+    SuperpoweredAudiobufferQueue(unsigned int capacity, bool multipleProducers = false);
+    ~SuperpoweredAudiobufferQueue();
+
+    /**
+     @brief Sets the low watermark and the callback. Call it before the producer and consumer threads start.
+
+     @param lowWatermark The callback is called when the queue has this many items or less.
+     @param callback The callback. NULL disables it.
+     @param clientData Custom pointer for the callback.
+     */
+    void setWatermark(unsigned int lowWatermark, SuperpoweredAudiobufferQueueCallback callback, void *clientData);
+
+    /**
+     @brief Adds an item to the end of the queue. Producer only.
+
+     @return True if the queue took the item and the ownership of its buffers, false if the queue is full (the caller keeps the ownership then).
+
+     @param element The item, copied.
+     @param owner The owner of the buffers. NULL means SuperpoweredAudiobufferPoolOwner. Must be valid as long as the buffers are in the queue or in a chain.
+     */
+    bool push(SuperpoweredAudiobufferlistElement *element, const SuperpoweredAudiobufferOwner *owner = NULL);
+
+    /**
+     @brief Removes the first item from the queue. Consumer only.
+
+     @return False if the queue is empty.
+
+     @param element Returns with the item. The caller owns its buffers.
+     @param owner Returns with the owner of the buffers. Can be NULL.
+     */
+    bool pop(SuperpoweredAudiobufferlistElement *element, const SuperpoweredAudiobufferOwner **owner = NULL);
+
+    /**
+     @brief Moves items from the queue to the end of a chain, with their ownership. Consumer only.
+
+     Never allocates memory: it stops when the chain is full, the other items stay in the queue. Give the chain room for the queue's capacity with SuperpoweredAudiobufferChain::reserve().
+
+     @return The number of items moved.
+
+     @param chain The chain.
+     @param maxItems The maximum number of items to move.
+     */
+    unsigned int drainTo(SuperpoweredAudiobufferChain *chain, unsigned int maxItems = 0xffffffff);
+
+    /**
+     @brief Returns with the number of items in the queue. Approximate if the other side is working on the queue at the same time.
+     */
+    unsigned int count();
+
+private:
+    queueInternals *internals;
+    SuperpoweredAudiobufferQueue(const SuperpoweredAudiobufferQueue&);
+    SuperpoweredAudiobufferQueue& operator=(const SuperpoweredAudiobufferQueue&);
+};
+
+#endif
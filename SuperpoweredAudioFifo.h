@@ -0,0 +1,123 @@
+#ifndef Header_SuperpoweredAudioFifo
+#define Header_SuperpoweredAudioFifo
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SUPERPOWEREDAUDIOFIFO_CACHELINE 64
+
+/**
+ @brief Lock-free single-producer/single-consumer ring of equally sized audio buffers.
+
+ The producer thread fills SuperpoweredAudioFifoWriteBuffer() and publishes it with SuperpoweredAudioFifoCommitWrite().
+ The consumer thread works on SuperpoweredAudioFifoReadBuffer() and hands it back with SuperpoweredAudioFifoCommitRead().
+ Both counters are free running and have exactly one writer. Publishing is a release store, looking at the other side is an acquire load, so there are no locks and no read-modify-write operations.
+ The write and read counters are on separate cache lines, the two audio threads don't bounce the same line between their cores.
+
+ The buffer returned by SuperpoweredAudioFifoWriteBuffer() is never visible to the consumer before it's committed, so it can be handed to an audio device for recording.
+ A buffer returned by SuperpoweredAudioFifoReadBuffer() is never reused by the producer before it's committed, so it can be handed to an audio device for playback.
+
+ The buffers are untyped, the fifo can carry 16-bit or 32-bit floating point audio.
+
+ @param buffers The audio buffers (numBuffers * bufferStepBytes bytes).
+ @param numBuffers Number of buffers, always a power of two.
+ @param bufferStepBytes Distance between buffers in bytes.
+*/
+typedef struct SuperpoweredAudioFifo {
+    char padHead[SUPERPOWEREDAUDIOFIFO_CACHELINE];
+    unsigned int writeCount; // Written by the producer only.
+    char padWrite[SUPERPOWEREDAUDIOFIFO_CACHELINE - sizeof(unsigned int)];
+    unsigned int readCount; // Written by the consumer only.
+    char padRead[SUPERPOWEREDAUDIOFIFO_CACHELINE - sizeof(unsigned int)];
+    char *buffers;
+    unsigned int numBuffers, bufferStepBytes;
+    char padTail[SUPERPOWEREDAUDIOFIFO_CACHELINE];
+} SuperpoweredAudioFifo;
+
+/**
+ @brief Allocates the buffers. Not thread safe, call it before the audio threads start.
+
+ @return False if memory allocation failed.
+
+ @param fifo The fifo.
+ @param minimumBuffers Minimum number of buffers. Will be rounded up to the next power of two.
+ @param bufferStepBytes Distance between buffers in bytes.
+*/
+static inline bool SuperpoweredAudioFifoInit(SuperpoweredAudioFifo *fifo, unsigned int minimumBuffers, unsigned int bufferStepBytes) {
+    unsigned int numBuffers = 2;
+    while (numBuffers < minimumBuffers) numBuffers <<= 1;
+
+    size_t sizeBytes = (size_t)numBuffers * bufferStepBytes;
+    fifo->buffers = (char *)malloc(sizeBytes);
+    if (!fifo->buffers) return false;
+    memset(fifo->buffers, 0, sizeBytes);
+
+    fifo->numBuffers = numBuffers;
+    fifo->bufferStepBytes = bufferStepBytes;
+    __atomic_store_n(&fifo->writeCount, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&fifo->readCount, 0, __ATOMIC_RELAXED);
+    return true;
+}
+
+/**
+ @brief Frees the buffers. Not thread safe, call it after the audio threads stopped.
+*/
+static inline void SuperpoweredAudioFifoFree(SuperpoweredAudioFifo *fifo) {
+    free(fifo->buffers);
+    fifo->buffers = NULL;
+}
+
+/**
+ @return Returns with the number of committed, unread buffers. Safe to call from any thread.
+*/
+static inline unsigned int SuperpoweredAudioFifoFill(SuperpoweredAudioFifo *fifo) {
+    unsigned int readCount = __atomic_load_n(&fifo->readCount, __ATOMIC_ACQUIRE);
+    return __atomic_load_n(&fifo->writeCount, __ATOMIC_ACQUIRE) - readCount;
+}
+
+/**
+ @return Producer only. Returns with the buffer to fill next.
+*/
+static inline void *SuperpoweredAudioFifoWriteBuffer(SuperpoweredAudioFifo *fifo) {
+    unsigned int writeCount = __atomic_load_n(&fifo->writeCount, __ATOMIC_RELAXED);
+    return fifo->buffers + (size_t)(writeCount & (fifo->numBuffers - 1)) * fifo->bufferStepBytes;
+}
+
+/**
+ @brief Producer only. Publishes the write buffer to the consumer.
+
+ One buffer is always kept for the producer, so the next write buffer never aliases a buffer the consumer may work on.
+
+ @return False if the fifo is full (overrun). The buffer is not published in this case and will be returned by SuperpoweredAudioFifoWriteBuffer() again.
+*/
+static inline bool SuperpoweredAudioFifoCommitWrite(SuperpoweredAudioFifo *fifo) {
+    unsigned int writeCount = __atomic_load_n(&fifo->writeCount, __ATOMIC_RELAXED);
+    if (writeCount + 1 - __atomic_load_n(&fifo->readCount, __ATOMIC_ACQUIRE) >= fifo->numBuffers) return false;
+    __atomic_store_n(&fifo->writeCount, writeCount + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ @return Consumer only. Returns with the number of buffers available for reading.
+*/
+static inline unsigned int SuperpoweredAudioFifoReadable(SuperpoweredAudioFifo *fifo) {
+    return __atomic_load_n(&fifo->writeCount, __ATOMIC_ACQUIRE) - __atomic_load_n(&fifo->readCount, __ATOMIC_RELAXED);
+}
+
+/**
+ @return Consumer only. Returns with the oldest committed buffer. Check SuperpoweredAudioFifoReadable() first.
+*/
+static inline void *SuperpoweredAudioFifoReadBuffer(SuperpoweredAudioFifo *fifo) {
+    unsigned int readCount = __atomic_load_n(&fifo->readCount, __ATOMIC_RELAXED);
+    return fifo->buffers + (size_t)(readCount & (fifo->numBuffers - 1)) * fifo->bufferStepBytes;
+}
+
+/**
+ @brief Consumer only. Hands the read buffer back to the producer.
+*/
+static inline void SuperpoweredAudioFifoCommitRead(SuperpoweredAudioFifo *fifo) {
+    unsigned int readCount = __atomic_load_n(&fifo->readCount, __ATOMIC_RELAXED);
+    __atomic_store_n(&fifo->readCount, readCount + 1, __ATOMIC_RELEASE);
+}
+
+#endif
@@ -0,0 +1,454 @@
+#ifndef Header_SuperpoweredAudioIOEngine
+#define Header_SuperpoweredAudioIOEngine
+
+#include "SuperpoweredAudioFifo.h"
+#include <stdint.h>
+#include <time.h>
+
+#define SUPERPOWEREDAUDIOIO_LOAD_BUCKETS 16
+
+/**
+ @brief This is the prototype of an audio processing callback function.
+
+ If the application requires both audio input and audio output,
+ this callback is called once (there is no separate audio input and audio output callback).
+ Audio input is available in audioIO, and the application should change it's contents
+ for audio output.
+
+ @param clientdata A custom pointer your callback receives.
+ @param audioIO 16-bit stereo interleaved audio input and/or output.
+ @param numberOfSamples The number of samples received and/or requested.
+ @param samplerate The current sample rate in Hz.
+*/
+typedef bool (*audioProcessingCallback)(void *clientdata, short int *audioIO, int numberOfSamples,
+                                        int samplerate);
+
+/**
+ @brief This is the prototype of a 32-bit floating point audio processing callback function.
+
+ Same as audioProcessingCallback, but the audio is 32-bit floating point, between -1.0f and 1.0f.
+ No conversion is needed before or after the Superpowered effects.
+
+ @param clientdata A custom pointer your callback receives.
+ @param audioIO 32-bit floating point stereo interleaved audio input and/or output.
+ @param numberOfSamples The number of samples received and/or requested.
+ @param samplerate The current sample rate in Hz.
+*/
+typedef bool (*audioProcessingCallbackFloat)(void *clientdata, float *audioIO, int numberOfSamples,
+                                             int samplerate);
+
+/**
+ @brief Real-time statistics of the audio I/O, updated by the audio threads and readable from any thread.
+
+ Every counter has exactly one writer thread and is updated without locks. The counters are free running 32-bit values,
+ they wrap around and are never reset. Take the difference of two snapshots to get the statistics of an interval.
+ Each value is read atomically, but a snapshot is not taken at one instant, so counters written by different threads may be off by one callback.
+
+ @param callbacks How many times the audio processing callback ran.
+ @param silentCallbacks How many times the audio processing callback returned false (silence).
+ @param underruns Output buffers replaced by silence because the fifo ran empty after playback started.
+ @param overruns Recorded buffers dropped because the fifo was full. Written by the input thread.
+ @param silenceEnqueues How many times the output device got the silence buffer, including the fifo filling up at start.
+ @param fifoFill The number of buffers in the fifo after the last callback.
+ @param maximumFifoFill The highest fifoFill seen.
+ @param maximumLoadPercent The longest audio processing callback, in percent of the buffer period.
+ @param loadHistogram Wall time of the audio processing callback, relative to the buffer period. Bucket n counts callbacks taking n/8 to (n+1)/8 of the period, the last bucket counts everything above.
+*/
+typedef struct SuperpoweredAudioIOStats {
+    unsigned int callbacks, silentCallbacks;
+    unsigned int underruns, overruns, silenceEnqueues;
+    unsigned int fifoFill, maximumFifoFill;
+    unsigned int maximumLoadPercent;
+    unsigned int loadHistogram[SUPERPOWEREDAUDIOIO_LOAD_BUCKETS];
+} SuperpoweredAudioIOStats;
+
+/**
+ @brief The platform-neutral part of the audio I/O classes: fifo, latency, dropout and silence handling.
+
+ A backend owns the audio devices and talks to the engine with three calls only:
+ - SuperpoweredAudioIOEngineInput() when the input device finished recording the buffer it was given,
+ - SuperpoweredAudioIOEngineOutput() when the output device needs the next buffer to play,
+ - SuperpoweredAudioIOEngineSetForeground() from the main thread.
+
+ Each device is given exactly one buffer at a time, and keeps it until its next call.
+ The input and output calls may run on two different threads. The fifo is the only state they share.
+
+ With the floating point callback the fifo holds floats. If the device is 16-bit, audio is converted once,
+ where it enters or leaves the fifo, and the device gets a staging buffer instead of a fifo buffer.
+
+ @param fifo Audio input waiting for processing (with input), or processed audio waiting for the output device (output only).
+ @param silence One buffer of silence in the device format, played on dropouts.
+ @param inputStaging 16-bit buffer for the input device, with a floating point fifo only.
+ @param outputStaging 16-bit buffer for the output device, with a floating point fifo only.
+ @param silenceSamples How many samples of silence the callback returned in a row. Output thread only.
+ @param latencySamples How many samples to have in the fifo minimum before processing/playback. Changed by the output thread in adaptive mode.
+ @param adaptiveMinSamples Lower bound of the adaptive latency. 0 means adaptive latency is off. Set by any thread.
+ @param adaptiveMaxSamples Upper bound of the adaptive latency. Set by any thread.
+ @param adaptiveCallbacks, adaptiveMinReadable, adaptiveStableWindows The adaptive latency controller's state. Output thread only.
+ @param floatFifo The fifo holds 32-bit floating point audio.
+ @param floatDevice The devices take 32-bit floating point audio.
+ @param foreground Set by the main thread, read by the output thread.
+ @param outputPending The output device still plays the fifo buffer it was given in the previous call. Output thread only.
+ @param outputStarted The output played audio from the fifo at least once. Output thread only.
+ @param stats Real-time statistics.
+ @param bufferNanoseconds The length of one buffer in nanoseconds, for the callback load.
+*/
+typedef struct SuperpoweredAudioIOEngine {
+    SuperpoweredAudioFifo fifo;
+    audioProcessingCallback callback;
+    audioProcessingCallbackFloat floatCallback;
+    void *clientdata;
+    void *silence;
+    short int *inputStaging, *outputStaging;
+    int samplerate, buffersize, silenceSamples, latencySamples;
+    int adaptiveMinSamples, adaptiveMaxSamples;
+    int adaptiveCallbacks, adaptiveStableWindows;
+    unsigned int adaptiveMinReadable;
+    bool hasInput, hasOutput, floatFifo, floatDevice, foreground, outputPending, outputStarted;
+    SuperpoweredAudioIOStats stats;
+    int64_t bufferNanoseconds;
+} SuperpoweredAudioIOEngine;
+
+/**
+ @brief Sets up the engine and allocates the fifo. Call it before the audio devices start.
+
+ @return False if memory allocation failed.
+
+ @param engine The engine, zeroed.
+ @param samplerate The sample rate in Hz.
+ @param buffersize The number of samples in one device buffer.
+ @param enableInput Audio input is enabled.
+ @param enableOutput Audio output is enabled.
+ @param callback The 16-bit audio processing callback function, or NULL.
+ @param floatCallback The 32-bit floating point audio processing callback function, or NULL.
+ @param clientdata A custom pointer the callback receives.
+ @param latencySamples How many samples to have in the fifo minimum. Works only when both input and output are enabled.
+ @param floatDevice The devices take 32-bit floating point audio. Only with floatCallback.
+*/
+static inline bool SuperpoweredAudioIOEngineInit(SuperpoweredAudioIOEngine *engine, int samplerate, int buffersize,
+                                                 bool enableInput, bool enableOutput,
+                                                 audioProcessingCallback callback, audioProcessingCallbackFloat floatCallback,
+                                                 void *clientdata, int latencySamples, bool floatDevice) {
+    engine->samplerate = samplerate;
+    engine->buffersize = buffersize;
+    engine->callback = callback;
+    engine->floatCallback = floatCallback;
+    engine->clientdata = clientdata;
+    engine->hasInput = enableInput;
+    engine->hasOutput = enableOutput;
+    engine->floatFifo = (floatCallback != NULL);
+    engine->floatDevice = engine->floatFifo && floatDevice;
+    engine->foreground = true;
+    engine->outputPending = engine->outputStarted = false;
+    engine->silenceSamples = 0;
+    engine->adaptiveMinSamples = engine->adaptiveMaxSamples = 0;
+    engine->adaptiveCallbacks = engine->adaptiveStableWindows = 0;
+    engine->adaptiveMinReadable = 0xffffffff;
+    memset(&engine->stats, 0, sizeof(SuperpoweredAudioIOStats));
+    engine->bufferNanoseconds = (int64_t)buffersize * 1000000000 / samplerate;
+    if (engine->bufferNanoseconds < 1) engine->bufferNanoseconds = 1;
+
+    // buffersize * 2(stereo) * sample size
+    size_t deviceBufferBytes = (size_t)buffersize * (engine->floatDevice ? 8 : 4);
+    engine->silence = malloc(deviceBufferBytes);
+    if (!engine->silence) return false;
+    memset(engine->silence, 0, deviceBufferBytes);
+
+    if (engine->floatFifo && !engine->floatDevice) {
+        engine->inputStaging = (short int *)malloc((size_t)buffersize * 4);
+        engine->outputStaging = (short int *)malloc((size_t)buffersize * 4);
+        if (!engine->inputStaging || !engine->outputStaging) return false;
+        memset(engine->inputStaging, 0, (size_t)buffersize * 4);
+        memset(engine->outputStaging, 0, (size_t)buffersize * 4);
+    }
+
+    engine->latencySamples = latencySamples < buffersize ? buffersize : latencySamples;
+
+    // 最少使用16个Buffer, the fifo rounds it up to a power of two.
+    int numBuffers = (engine->latencySamples / buffersize) * 2;
+    if (numBuffers < 16) numBuffers = 16;
+    return SuperpoweredAudioFifoInit(&engine->fifo, (unsigned int)numBuffers, (unsigned int)(buffersize + 64) * (engine->floatFifo ? 8 : 4));
+}
+
+/**
+ @brief Frees the engine's memory. Call it after the audio devices stopped.
+*/
+static inline void SuperpoweredAudioIOEngineFree(SuperpoweredAudioIOEngine *engine) {
+    SuperpoweredAudioFifoFree(&engine->fifo);
+    free(engine->silence);
+    free(engine->inputStaging);
+    free(engine->outputStaging);
+    engine->silence = engine->inputStaging = engine->outputStaging = NULL;
+}
+
+/**
+ @return Returns with the size of one device buffer in bytes.
+*/
+static inline unsigned int SuperpoweredAudioIOEngineDeviceBufferBytes(SuperpoweredAudioIOEngine *engine) {
+    return (unsigned int)engine->buffersize * (engine->floatDevice ? 8 : 4);
+}
+
+/**
+ @return Returns with the first buffer to give to the input device.
+*/
+static inline void *SuperpoweredAudioIOEngineFirstInputBuffer(SuperpoweredAudioIOEngine *engine) {
+    if (engine->inputStaging) return engine->inputStaging;
+    return SuperpoweredAudioFifoWriteBuffer(&engine->fifo);
+}
+
+/**
+ @return Returns with the first buffer to give to the output device. The input device may be recording into the first fifo buffer, so this is silence.
+*/
+static inline void *SuperpoweredAudioIOEngineFirstOutputBuffer(SuperpoweredAudioIOEngine *engine) {
+    return engine->silence;
+}
+
+/**
+ @brief Call this when the main activity goes to the foreground or background. Safe to call from any thread.
+*/
+static inline void SuperpoweredAudioIOEngineSetForeground(SuperpoweredAudioIOEngine *engine, bool foreground) {
+    __atomic_store_n(&engine->foreground, foreground, __ATOMIC_RELAXED);
+}
+
+/**
+ @brief Enables or disables adaptive latency. Safe to call from any thread. Works only when both input and output are enabled.
+
+ In adaptive mode the latency is the fill to reach before playback starts, then every buffer is played as soon as it's available.
+ If the fifo runs empty (dropout), the latency grows by one buffer and playback restarts when the fifo filled up again.
+ If the fifo always had a buffer to spare for two seconds, the latency shrinks by one buffer, and the oldest buffer is dropped to really shorten the delay.
+ Callback jitter shows up as fill level swings at the output, so it is measured there and needs no clock.
+
+ @param minLatencySamples The lowest latency allowed. Rounded up to one buffer minimum. 0 disables adaptive latency, the latency stays where it is.
+ @param maxLatencySamples The highest latency allowed. Limited by the fifo size: twice the latency set at creation, 16 buffers minimum.
+*/
+static inline void SuperpoweredAudioIOEngineSetAdaptiveLatency(SuperpoweredAudioIOEngine *engine, int minLatencySamples, int maxLatencySamples) {
+    __atomic_store_n(&engine->adaptiveMaxSamples, maxLatencySamples, __ATOMIC_RELAXED);
+    __atomic_store_n(&engine->adaptiveMinSamples, minLatencySamples, __ATOMIC_RELAXED);
+}
+
+/**
+ @return Returns with the current latency (the minimum fill before processing/playback) in samples. Safe to call from any thread.
+*/
+static inline int SuperpoweredAudioIOEngineLatencySamples(SuperpoweredAudioIOEngine *engine) {
+    return __atomic_load_n(&engine->latencySamples, __ATOMIC_RELAXED);
+}
+
+/**
+ @brief Returns with a snapshot of the statistics. Safe to call from any thread, never blocks the audio threads.
+*/
+static inline void SuperpoweredAudioIOEngineGetStats(SuperpoweredAudioIOEngine *engine, SuperpoweredAudioIOStats *stats) {
+    const unsigned int *from = (const unsigned int *)&engine->stats;
+    unsigned int *to = (unsigned int *)stats;
+    for (size_t n = 0; n < sizeof(SuperpoweredAudioIOStats) / sizeof(unsigned int); n++) to[n] = __atomic_load_n(from + n, __ATOMIC_RELAXED);
+}
+
+// Statistics updates. Every counter has one writer thread, so a load and a store is enough, no read-modify-write needed.
+static inline void SuperpoweredAudioIOStatsAdd(unsigned int *counter) {
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED);
+}
+
+static inline void SuperpoweredAudioIOStatsFifoFill(SuperpoweredAudioIOStats *stats, unsigned int fill) {
+    __atomic_store_n(&stats->fifoFill, fill, __ATOMIC_RELAXED);
+    if (fill > __atomic_load_n(&stats->maximumFifoFill, __ATOMIC_RELAXED)) __atomic_store_n(&stats->maximumFifoFill, fill, __ATOMIC_RELAXED);
+}
+
+static inline int64_t SuperpoweredAudioIOEngineNanoseconds() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (int64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+
+// The adaptive latency controller, called by the output thread with the number of readable buffers.
+// Returns true if the oldest buffer should be dropped to shorten the delay.
+static inline bool SuperpoweredAudioIOEngineAdaptLatency(SuperpoweredAudioIOEngine *engine, unsigned int readable, bool dropout) {
+    int minSamples = __atomic_load_n(&engine->adaptiveMinSamples, __ATOMIC_RELAXED);
+    int maxSamples = __atomic_load_n(&engine->adaptiveMaxSamples, __ATOMIC_RELAXED);
+    int limit = ((int)engine->fifo.numBuffers - 2) * engine->buffersize;
+    if (maxSamples > limit) maxSamples = limit;
+    if (minSamples < engine->buffersize) minSamples = engine->buffersize;
+    if (maxSamples < minSamples) maxSamples = minSamples;
+
+    int latency = engine->latencySamples;
+    if (latency < minSamples) latency = minSamples; else if (latency > maxSamples) latency = maxSamples;
+
+    bool drop = false;
+    if (dropout) {
+        // The fifo ran empty: grow by one buffer, refill to the new latency and start observing again.
+        latency += engine->buffersize;
+        if (latency > maxSamples) latency = maxSamples;
+        engine->outputStarted = false;
+        engine->adaptiveCallbacks = engine->adaptiveStableWindows = 0;
+        engine->adaptiveMinReadable = 0xffffffff;
+    } else {
+        if (readable < engine->adaptiveMinReadable) engine->adaptiveMinReadable = readable;
+
+        // One window is about one second.
+        if (++engine->adaptiveCallbacks * engine->buffersize >= engine->samplerate) {
+            // There was always a buffer to spare, beyond the one played.
+            if (engine->adaptiveMinReadable >= 2) engine->adaptiveStableWindows++;
+            else engine->adaptiveStableWindows = 0;
+
+            if (engine->adaptiveStableWindows >= 2) {
+                // Shrink, and drop the oldest buffer to really shorten the delay.
+                if (latency - engine->buffersize >= minSamples) latency -= engine->buffersize;
+                drop = (readable >= 2);
+                engine->adaptiveStableWindows = 0;
+            }
+
+            engine->adaptiveCallbacks = 0;
+            engine->adaptiveMinReadable = 0xffffffff;
+        }
+    }
+
+    if (latency != engine->latencySamples) __atomic_store_n(&engine->latencySamples, latency, __ATOMIC_RELAXED);
+    return drop;
+}
+
+// 16-bit device audio into the floating point fifo.
+static inline void SuperpoweredAudioIOEngineShortToFloat(const short int *input, float *output, int numberOfValues) {
+    static const float scale = 1.0f / 32768.0f;
+    for (int n = 0; n < numberOfValues; n++) output[n] = (float)input[n] * scale;
+}
+
+// Floating point fifo audio to the 16-bit device, with clipping.
+static inline void SuperpoweredAudioIOEngineFloatToShort(const float *input, short int *output, int numberOfValues) {
+    for (int n = 0; n < numberOfValues; n++) {
+        float value = input[n] * 32767.0f;
+        if (value > 32767.0f) value = 32767.0f; else if (value < -32768.0f) value = -32768.0f;
+        output[n] = (short int)value;
+    }
+}
+
+// Runs the audio processing callback on a fifo buffer, and measures its wall time.
+static inline bool SuperpoweredAudioIOEngineProcess(SuperpoweredAudioIOEngine *engine, void *audioIO) {
+    int64_t start = SuperpoweredAudioIOEngineNanoseconds();
+    bool result;
+    if (engine->floatFifo) result = engine->floatCallback(engine->clientdata, (float *)audioIO, engine->buffersize, engine->samplerate);
+    else result = engine->callback(engine->clientdata, (short int *)audioIO, engine->buffersize, engine->samplerate);
+
+    SuperpoweredAudioIOStats *stats = &engine->stats;
+    int64_t percent = (SuperpoweredAudioIOEngineNanoseconds() - start) * 100 / engine->bufferNanoseconds;
+    if (percent > 0xffff) percent = 0xffff;
+    int bucket = (int)(percent * 8 / 100);
+    if (bucket >= SUPERPOWEREDAUDIOIO_LOAD_BUCKETS) bucket = SUPERPOWEREDAUDIOIO_LOAD_BUCKETS - 1;
+    SuperpoweredAudioIOStatsAdd(&stats->loadHistogram[bucket]);
+    if ((unsigned int)percent > __atomic_load_n(&stats->maximumLoadPercent, __ATOMIC_RELAXED)) __atomic_store_n(&stats->maximumLoadPercent, (unsigned int)percent, __ATOMIC_RELAXED);
+    SuperpoweredAudioIOStatsAdd(&stats->callbacks);
+    if (!result) SuperpoweredAudioIOStatsAdd(&stats->silentCallbacks);
+    return result;
+}
+
+/**
+ @brief The input device finished recording the buffer it was given.
+
+ Publishes the recording to the fifo. If the consumer fell behind, the fifo is full and the recording is dropped.
+ Without audio output, this also runs the audio processing callback when there is enough input.
+
+ @return Returns with the next buffer to record into. It's not visible to the consumer until the next call.
+*/
+static inline void *SuperpoweredAudioIOEngineInput(SuperpoweredAudioIOEngine *engine) {
+    SuperpoweredAudioFifo *fifo = &engine->fifo;
+    if (engine->inputStaging) SuperpoweredAudioIOEngineShortToFloat(engine->inputStaging, (float *)SuperpoweredAudioFifoWriteBuffer(fifo), engine->buffersize * 2);
+    if (!SuperpoweredAudioFifoCommitWrite(fifo)) SuperpoweredAudioIOStatsAdd(&engine->stats.overruns);
+
+    // 如果没有输出，那么整个信号由Mic端来驱动(push)，这里同时也是消费者。
+    // 如果有输出，则由输出端来驱动(pull)，这里只负责生产。
+    if (!engine->hasOutput && ((int)SuperpoweredAudioFifoReadable(fifo) * engine->buffersize >= engine->latencySamples)) {
+        SuperpoweredAudioIOEngineProcess(engine, SuperpoweredAudioFifoReadBuffer(fifo));
+        SuperpoweredAudioFifoCommitRead(fifo);
+    }
+    if (!engine->hasOutput) SuperpoweredAudioIOStatsFifoFill(&engine->stats, SuperpoweredAudioFifoReadable(fifo));
+
+    if (engine->inputStaging) return engine->inputStaging;
+    return SuperpoweredAudioFifoWriteBuffer(fifo);
+}
+
+/**
+ @brief The output device finished playing the buffer it was given, and needs the next one.
+
+ With audio input, processes the oldest input if there is enough of it. Without audio input, generates a new buffer into the fifo.
+
+ @return Returns with the buffer to play. It's the silence buffer on dropouts.
+
+ @param engine The engine.
+ @param shouldStop Set to true if the app is in the background and the callback returned silence for more than a second. The backend should stop the devices then.
+*/
+static inline void *SuperpoweredAudioIOEngineOutput(SuperpoweredAudioIOEngine *engine, bool *shouldStop) {
+    SuperpoweredAudioFifo *fifo = &engine->fifo;
+    size_t fifoBufferBytes = (size_t)engine->buffersize * (engine->floatFifo ? 8 : 4);
+
+    // The buffer given in the previous call has been played, hand it back to the producer.
+    if (engine->outputPending) {
+        SuperpoweredAudioFifoCommitRead(fifo);
+        engine->outputPending = false;
+    }
+
+    void *output = NULL;
+    bool started = engine->outputStarted; // The adaptive latency controller clears it on a dropout.
+
+    if (engine->hasInput) {
+        // 输入端负责生产数据，这里只消费。
+        unsigned int readable = SuperpoweredAudioFifoReadable(fifo);
+        bool enough;
+
+        if (__atomic_load_n(&engine->adaptiveMinSamples, __ATOMIC_RELAXED) > 0) {
+            // In adaptive mode the latency is the fill to reach before playback (re)starts, then every buffer is played as soon as it's available.
+            enough = engine->outputStarted ? (readable > 0) : ((int)readable * engine->buffersize >= engine->latencySamples);
+            if (SuperpoweredAudioIOEngineAdaptLatency(engine, readable, engine->outputStarted && !enough)) {
+                SuperpoweredAudioFifoCommitRead(fifo);
+                readable--;
+            }
+        } else enough = ((int)readable * engine->buffersize >= engine->latencySamples);
+
+        // if we have enough audio input available, else dropout
+        if (enough) {
+            engine->outputStarted = true;
+            output = SuperpoweredAudioFifoReadBuffer(fifo);
+            if (!SuperpoweredAudioIOEngineProcess(engine, output)) {
+                memset(output, 0, fifoBufferBytes);
+                engine->silenceSamples += engine->buffersize;
+            } else engine->silenceSamples = 0;
+        }
+    } else {
+        // 如果没有输入，则整个事件靠输出来驱动, 这里既是生产者又是消费者。
+        void *audioToGenerate = SuperpoweredAudioFifoWriteBuffer(fifo);
+        if (!SuperpoweredAudioIOEngineProcess(engine, audioToGenerate)) {
+            memset(audioToGenerate, 0, fifoBufferBytes);
+            engine->silenceSamples += engine->buffersize;
+        } else engine->silenceSamples = 0;
+        SuperpoweredAudioFifoCommitWrite(fifo);
+
+        // else dropout, not enough audio generated
+        if ((int)SuperpoweredAudioFifoReadable(fifo) * engine->buffersize >= engine->latencySamples) {
+            engine->outputStarted = true;
+            output = SuperpoweredAudioFifoReadBuffer(fifo);
+        }
+    }
+
+    // The buffer played now is still in the fifo, unless it was converted to the staging buffer.
+    SuperpoweredAudioIOStatsFifoFill(&engine->stats, SuperpoweredAudioFifoReadable(fifo));
+    if (!output) {
+        SuperpoweredAudioIOStatsAdd(&engine->stats.silenceEnqueues);
+        if (started) SuperpoweredAudioIOStatsAdd(&engine->stats.underruns);
+    }
+
+    if (output) {
+        if (engine->outputStaging) {
+            // The fifo buffer is converted and handed back right away, the device plays the staging buffer.
+            SuperpoweredAudioIOEngineFloatToShort((float *)output, engine->outputStaging, engine->buffersize * 2);
+            SuperpoweredAudioFifoCommitRead(fifo);
+            output = engine->outputStaging;
+        } else engine->outputPending = true; // The fifo buffer is owned by the output device until the next call.
+    }
+
+    // 如果不在前台，并且持续了一段时间，那么直接暂停
+    *shouldStop = false;
+    if (!__atomic_load_n(&engine->foreground, __ATOMIC_RELAXED) && (engine->silenceSamples > engine->samplerate)) {
+        engine->silenceSamples = 0;
+        *shouldStop = true;
+    }
+
+    return output ? output : engine->silence;
+}
+
+#endif
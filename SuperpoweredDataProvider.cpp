@@ -0,0 +1,78 @@
+#include "SuperpoweredDataProvider.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+#define PROVIDERCHUNKBYTES (64 * 1024)
+
+// An anonymous memory file. There is no fallback to a temporary file on disk where memfd is not available.
+static int createFile(char *path) {
+#if defined(__linux__) && defined(__NR_memfd_create)
+    int fd = (int)syscall(__NR_memfd_create, "SuperpoweredMemoryFile", 1); // MFD_CLOEXEC
+    if (fd >= 0) snprintf(path, 32, "/proc/self/fd/%i", fd);
+    return fd;
+#else
+    (void)path;
+    return -1;
+#endif
+}
+
+static bool writeAll(int fd, const unsigned char *data, size_t bytes) {
+    while (bytes > 0) {
+        ssize_t written = write(fd, data, bytes);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        bytes -= (size_t)written;
+    }
+    return true;
+}
+
+int SuperpoweredMemoryFileOpen(const void *data, size_t bytes, char *path) {
+    int fd = createFile(path);
+    if (fd < 0) return -1;
+    if (!writeAll(fd, (const unsigned char *)data, bytes)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int SuperpoweredMemoryFileOpenProvider(const SuperpoweredDataProvider *provider, char *path) {
+    if (!provider || !provider->read) return -1;
+    if (provider->seek && (provider->seek(provider->clientData, 0) != 0)) return -1;
+    int64_t size = provider->size ? provider->size(provider->clientData) : -1;
+
+    unsigned char *chunk = (unsigned char *)malloc(PROVIDERCHUNKBYTES);
+    if (!chunk) return -1;
+    int fd = createFile(path);
+    if (fd < 0) {
+        free(chunk);
+        return -1;
+    }
+
+    int64_t total = 0;
+    bool success = true;
+    while (true) {
+        int bytes = provider->read(provider->clientData, chunk, PROVIDERCHUNKBYTES);
+        if (bytes == 0) break;
+        if ((bytes < 0) || !writeAll(fd, chunk, (size_t)bytes)) {
+            success = false;
+            break;
+        }
+        total += bytes;
+    }
+    free(chunk);
+
+    if (!success || ((size >= 0) && (total != size))) { // A short read is an error if the size is known.
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
@@ -0,0 +1,48 @@
+#ifndef Header_SuperpoweredDataProvider
+#define Header_SuperpoweredDataProvider
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ @brief Callbacks reading audio file data from a custom storage (a blob store, a database, a network cache).
+
+ The data is read once from the beginning to the end, and copied entirely into memory (see SuperpoweredMemoryFileOpenProvider()). seek is only called once, to rewind to the beginning, and size is only used to detect a short read. Both are optional.
+
+ @param read Reads the next bytes. Returns with the number of bytes read, 0 at the end of the data or -1 on error.
+ @param seek Moves the read position to offset, from the beginning of the data. Returns with the new position or -1 on error.
+ @param size Returns with the size of the data in bytes, or -1 if it's unknown.
+ @param clientData Custom pointer for the callbacks.
+ */
+typedef struct SuperpoweredDataProvider {
+    int (*read)(void *clientData, void *buffer, int bytes);
+    int64_t (*seek)(void *clientData, int64_t offset);
+    int64_t (*size)(void *clientData);
+    void *clientData;
+} SuperpoweredDataProvider;
+
+/**
+ @brief Creates a path for data in memory, for APIs taking a file system path only (SuperpoweredDecoder, SuperpoweredAdvancedAudioPlayer).
+
+ The data is copied into an anonymous memory file (memfd on Linux and Android, there is no disk I/O). The copy costs as much RAM as the size of the data, for as long as the file descriptor is open.
+ The path is valid until the returned file descriptor is closed. Close it after the decoder or player is done with the path.
+
+ @return A file descriptor, or -1 on error, or if memfd is not available (Linux kernels before 3.17, other systems).
+
+ @param data The data.
+ @param bytes The size of the data in bytes.
+ @param path Returns with the path. Must be at least 32 bytes big.
+ */
+int SuperpoweredMemoryFileOpen(const void *data, size_t bytes, char *path);
+
+/**
+ @brief Same as SuperpoweredMemoryFileOpen(), with the data read from a data provider. The entire data is read into memory before this returns.
+
+ @return A file descriptor, or -1 on error.
+
+ @param provider The data provider.
+ @param path Returns with the path. Must be at least 32 bytes big.
+ */
+int SuperpoweredMemoryFileOpenProvider(const SuperpoweredDataProvider *provider, char *path);
+
+#endif
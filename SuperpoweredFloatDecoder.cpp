@@ -0,0 +1,242 @@
+#include "SuperpoweredFloatDecoder.h"
+#include "SuperpoweredMappedAudioSource.h"
+#include "SuperpoweredMP3FloatDecoder.h"
+#include "SuperpoweredSIMD.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SWAPSAMPLES 1024 // Big-endian audio is swapped in chunks of this many samples.
+
+typedef struct floatDecoderInternals {
+    SuperpoweredDecoder *decoder;
+    SuperpoweredMappedAudioSource *source;
+    SuperpoweredMP3FloatDecoder *mp3;
+    short int *pcm; // Decoder output.
+    unsigned int pcmSamples;
+    int memoryFile; // The file descriptor of openMemory() or openDataProvider() data for the decoder, or -1.
+    SuperpoweredSIMDFormat format; // For the mapped source.
+    bool unsignedInt8;
+    float swap[SWAPSAMPLES * 2]; // 8 bytes per sample, aligned for the conversion.
+} floatDecoderInternals;
+
+// The mapped source can read the file if it's stereo or mono, and the SIMD conversions know its sample format.
+static bool mappedFormat(SuperpoweredMappedAudioSource *source, floatDecoderInternals *internals) {
+    if ((source->numChannels < 1) || (source->numChannels > 2)) return false;
+    unsigned int bytes = (source->bitsPerSample + 7) / 8;
+    if (source->bytesPerSample != source->numChannels * bytes) return false; // Padded containers.
+    internals->unsignedInt8 = false;
+    if (source->isFloat) {
+        if (source->bitsPerSample != 32) return false;
+        internals->format = SuperpoweredSIMDFormat_Float32;
+        return true;
+    }
+    switch (bytes) {
+        case 1: internals->format = SuperpoweredSIMDFormat_Int8; internals->unsignedInt8 = (source->kind == SuperpoweredDecoder_WAV); return true; // 8-bit WAV is unsigned.
+        case 2: internals->format = SuperpoweredSIMDFormat_Int16; return true;
+        case 3: internals->format = SuperpoweredSIMDFormat_Int24; return true;
+        case 4: internals->format = SuperpoweredSIMDFormat_Int32; return true;
+        default: return false;
+    }
+}
+
+static void closeFile(floatDecoderInternals *internals) {
+    delete internals->decoder;
+    delete internals->source;
+    delete internals->mp3;
+    internals->decoder = NULL;
+    internals->source = NULL;
+    internals->mp3 = NULL;
+    if (internals->memoryFile >= 0) close(internals->memoryFile);
+    internals->memoryFile = -1;
+}
+
+static void useSource(SuperpoweredFloatDecoder *decoder, floatDecoderInternals *internals, SuperpoweredMappedAudioSource *source) {
+    internals->source = source;
+    decoder->durationSamples = source->durationSamples;
+    decoder->samplerate = source->samplerate;
+    decoder->samplesPerFrame = 1;
+    decoder->kind = source->kind;
+    decoder->durationSeconds = (double)decoder->durationSamples / (double)decoder->samplerate;
+}
+
+static void useMP3(SuperpoweredFloatDecoder *decoder, floatDecoderInternals *internals, SuperpoweredMP3FloatDecoder *mp3) {
+    internals->mp3 = mp3;
+    decoder->durationSeconds = mp3->durationSeconds;
+    decoder->durationSamples = mp3->durationSamples;
+    decoder->samplerate = mp3->samplerate;
+    decoder->samplesPerFrame = mp3->samplesPerFrame;
+    decoder->kind = SuperpoweredDecoder_MP3;
+}
+
+SuperpoweredFloatDecoder::SuperpoweredFloatDecoder() : durationSeconds(0), durationSamples(0), samplePosition(0), samplerate(0), samplesPerFrame(0), kind(SuperpoweredDecoder_WAV) {
+    internals = new floatDecoderInternals;
+    memset(internals, 0, sizeof(floatDecoderInternals));
+    internals->memoryFile = -1;
+}
+
+SuperpoweredFloatDecoder::~SuperpoweredFloatDecoder() {
+    closeFile(internals);
+    free(internals->pcm);
+    delete internals;
+}
+
+const char *SuperpoweredFloatDecoder::open(const char *path, int offset, int length, int stemsIndex) {
+    closeFile(internals);
+    durationSeconds = 0;
+    durationSamples = samplePosition = 0;
+
+    if (!offset && !length) {
+        SuperpoweredMappedAudioSource *source = new SuperpoweredMappedAudioSource();
+        if (!source->open(path) && mappedFormat(source, internals)) {
+            useSource(this, internals, source);
+            return NULL;
+        }
+        delete source; // Not a supported uncompressed file.
+
+        SuperpoweredMP3FloatDecoder *mp3 = new SuperpoweredMP3FloatDecoder();
+        if (!mp3->open(path)) {
+            useMP3(this, internals, mp3);
+            return NULL;
+        }
+        delete mp3; // Not MP3, the decoder may know it.
+    }
+
+    SuperpoweredDecoder *decoder = new SuperpoweredDecoder();
+    const char *error = decoder->open(path, false, offset, length, stemsIndex);
+    if (error) {
+        delete decoder;
+        return error;
+    }
+    internals->decoder = decoder;
+    durationSeconds = decoder->durationSeconds;
+    durationSamples = decoder->durationSamples;
+    samplePosition = decoder->samplePosition;
+    samplerate = decoder->samplerate;
+    samplesPerFrame = decoder->samplesPerFrame;
+    kind = decoder->kind;
+    return NULL;
+}
+
+// Opens the decoder on a memory file, which is closed with the decoder.
+static const char *openMemoryFile(SuperpoweredFloatDecoder *decoder, floatDecoderInternals *internals, int fd, const char *path) {
+    if (fd < 0) return "Can not create a memory file.";
+    const char *error = decoder->open(path);
+    if (error) close(fd); else internals->memoryFile = fd;
+    return error;
+}
+
+const char *SuperpoweredFloatDecoder::openMemory(const void *data, size_t bytes) {
+    closeFile(internals);
+    durationSeconds = 0;
+    durationSamples = samplePosition = 0;
+
+    SuperpoweredMappedAudioSource *source = new SuperpoweredMappedAudioSource();
+    if (!source->openMemory(data, bytes) && mappedFormat(source, internals)) {
+        useSource(this, internals, source);
+        return NULL;
+    }
+    delete source;
+
+    SuperpoweredMP3FloatDecoder *mp3 = new SuperpoweredMP3FloatDecoder();
+    if (!mp3->openMemory(data, bytes)) {
+        useMP3(this, internals, mp3);
+        return NULL;
+    }
+    delete mp3;
+
+    char path[32];
+    int fd = SuperpoweredMemoryFileOpen(data, bytes, path);
+    return openMemoryFile(this, internals, fd, path);
+}
+
+const char *SuperpoweredFloatDecoder::openDataProvider(const SuperpoweredDataProvider *provider) {
+    closeFile(internals);
+    durationSeconds = 0;
+    durationSamples = samplePosition = 0;
+
+    char path[32];
+    int fd = SuperpoweredMemoryFileOpenProvider(provider, path);
+    return openMemoryFile(this, internals, fd, path);
+}
+
+// Reverses the bytes of every value, big-endian to little-endian.
+static void swapBytes(const unsigned char *input, unsigned char *output, unsigned int numberOfValues, unsigned int bytesPerValue) {
+    switch (bytesPerValue) {
+        case 2: while (numberOfValues--) { output[0] = input[1]; output[1] = input[0]; input += 2; output += 2; } break;
+        case 3: while (numberOfValues--) { output[0] = input[2]; output[1] = input[1]; output[2] = input[0]; input += 3; output += 3; } break;
+        case 4: while (numberOfValues--) { output[0] = input[3]; output[1] = input[2]; output[2] = input[1]; output[3] = input[0]; input += 4; output += 4; } break;
+        default: memcpy(output, input, numberOfValues * bytesPerValue);
+    }
+}
+
+// Converts mapped audio to floating point, in the file's channel count.
+static void convertMapped(floatDecoderInternals *internals, unsigned char *input, float *output, unsigned int numberOfSamples) {
+    SuperpoweredMappedAudioSource *source = internals->source;
+    unsigned int numChannels = source->numChannels, bytesPerValue = source->bytesPerSample / numChannels;
+
+    if (internals->unsignedInt8) {
+        for (unsigned int n = 0; n < numberOfSamples * numChannels; n++) output[n] = (float)((int)input[n] - 128) * (1.0f / 128.0f);
+    } else if (!source->bigEndian || (bytesPerValue == 1)) {
+        SuperpoweredSIMDToFloat(input, internals->format, output, NULL, NULL, numberOfSamples, numChannels, NULL, NULL);
+    } else while (numberOfSamples > 0) {
+        unsigned int chunk = (numberOfSamples < SWAPSAMPLES) ? numberOfSamples : SWAPSAMPLES;
+        swapBytes(input, (unsigned char *)internals->swap, chunk * numChannels, bytesPerValue);
+        SuperpoweredSIMDToFloat(internals->swap, internals->format, output, NULL, NULL, chunk, numChannels, NULL, NULL);
+        input += chunk * source->bytesPerSample;
+        output += chunk * numChannels;
+        numberOfSamples -= chunk;
+    }
+}
+
+unsigned char SuperpoweredFloatDecoder::decode(float *output, unsigned int *samples) {
+    if (internals->source) {
+        SuperpoweredAudiobufferlistElement element;
+        if (!internals->source->getElement(samplePosition, (int)*samples, &element)) {
+            *samples = 0;
+            return SUPERPOWEREDDECODER_EOF;
+        }
+        unsigned int numberOfSamples = (unsigned int)element.endSample;
+        convertMapped(internals, (unsigned char *)element.buffers[0], output, numberOfSamples);
+        if (internals->source->numChannels == 1) for (int n = (int)numberOfSamples - 1; n >= 0; n--) output[n * 2] = output[n * 2 + 1] = output[n]; // Mono to stereo, backwards in place.
+        const SuperpoweredAudiobufferOwner *owner = internals->source->getOwner();
+        owner->release(owner->clientData, element.buffers[0]);
+
+        samplePosition += numberOfSamples;
+        *samples = numberOfSamples;
+        return SUPERPOWEREDDECODER_OK;
+    }
+
+    if (internals->mp3) {
+        unsigned char result = internals->mp3->decode(output, samples);
+        samplePosition = internals->mp3->samplePosition;
+        return result;
+    }
+
+    if (!internals->decoder) return SUPERPOWEREDDECODER_ERROR;
+    if (internals->pcmSamples < *samples) { // The decoder may return more than requested, the same margin as its own output.
+        free(internals->pcm);
+        internals->pcm = (short int *)malloc(*samples * 4 + 16384);
+        internals->pcmSamples = internals->pcm ? *samples : 0;
+        if (!internals->pcm) return SUPERPOWEREDDECODER_ERROR;
+    }
+    unsigned char result = internals->decoder->decode(internals->pcm, samples);
+    if (result == SUPERPOWEREDDECODER_OK) SuperpoweredSIMDShortIntToFloat(internals->pcm, output, *samples);
+    samplePosition = internals->decoder->samplePosition;
+    durationSamples = internals->decoder->durationSamples;
+    durationSeconds = internals->decoder->durationSeconds;
+    return result;
+}
+
+int64_t SuperpoweredFloatDecoder::seekTo(int64_t sample, bool precise) {
+    if (internals->source) {
+        internals->source->seekTo(sample);
+        samplePosition = internals->source->samplePosition;
+    } else if (internals->mp3) samplePosition = internals->mp3->seekTo(sample, precise);
+    else if (internals->decoder) samplePosition = internals->decoder->seekTo(sample, precise);
+    return samplePosition;
+}
+
+SuperpoweredDecoder *SuperpoweredFloatDecoder::getDecoder() {
+    return internals->decoder;
+}
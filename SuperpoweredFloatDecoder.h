@@ -0,0 +1,102 @@
+#ifndef Header_SuperpoweredFloatDecoder
+#define Header_SuperpoweredFloatDecoder
+
+#include "SuperpoweredDecoder.h"
+#include "SuperpoweredDataProvider.h"
+
+struct floatDecoderInternals;
+
+/**
+ @brief Audio file decoder with 32-bit floating point output. Same interface as SuperpoweredDecoder.
+
+ Uncompressed WAV and AIFF files (8, 16, 24 and 32-bit int or 32-bit IEEE float, mono or stereo) are read directly from a memory-mapped file and converted to floating point in one SIMD pass. 24-bit and 32-bit files keep their full precision, there is no quantization to 16-bit.
+ MP3 files are decoded by SuperpoweredMP3FloatDecoder, with the SIMD requantization, IMDCT and synthesis stages of SuperpoweredSIMD.h: the output is floating point from the start, there is no 16-bit stage. Its durations and sample positions count every audio frame, the encoder and decoder delays are not removed.
+ Every other format goes through SuperpoweredDecoder. Other compressed formats (AAC and others) keep its 16-bit precision: decode() decodes to 16-bit into an internal buffer, allocated at the first decode() or when more samples are requested, then converts to floating point. The conversion pass is not saved, it runs inside decode() instead of in the consumer.
+
+ Thread safety: single threaded, not thread safe. After a succesful open(), samplePosition and duration may change.
+
+ @param durationSeconds The duration of the current file in seconds. Read only.
+ @param durationSamples The duration of the current file in samples. Read only.
+ @param samplePosition The current position in samples. May change after each decode() or seekTo(). Read only.
+ @param samplerate The sample rate of the current file. Read only.
+ @param samplesPerFrame How many samples are in one frame of the source file. For example: 1152 in mp3 files.
+ @param kind The format of the current file.
+ */
+class SuperpoweredFloatDecoder {
+public:
+// READ ONLY properties
+    double durationSeconds;
+    int64_t durationSamples, samplePosition;
+    unsigned int samplerate, samplesPerFrame;
+    SuperpoweredDecoder_Kind kind;
+
+    /**
+     @brief Opens a file for decoding.
+
+     @param path Full file system path.
+     @param offset Byte offset in the file.
+     @param length Byte length from offset. Set offset and length to 0 to read the entire file. Files with an offset or length are always decoded by SuperpoweredDecoder.
+     @param stemsIndex Stems track index for Native Instruments Stems format.
+
+     @return NULL if successful, or an error string.
+     */
+    const char *open(const char *path, int offset = 0, int length = 0, int stemsIndex = 0);
+
+    /**
+     @brief Opens a file in memory for decoding.
+
+     WAV, AIFF and MP3 files are read directly from the memory, without a copy. Other compressed formats are copied into an anonymous memory file for SuperpoweredDecoder (see SuperpoweredMemoryFileOpen()): a full copy of the data in RAM while the file is open. This fails where memfd is not available.
+
+     @param data The file's data. Must stay valid until the next open or the destruction of the decoder.
+     @param bytes The size of the data in bytes.
+
+     @return NULL if successful, or an error string.
+     */
+    const char *openMemory(const void *data, size_t bytes);
+
+    /**
+     @brief Opens a file from a data provider for decoding.
+
+     The entire data is read from the provider into an anonymous memory file (see SuperpoweredMemoryFileOpenProvider()), then decoded like a file. Every format costs a full copy of the data in RAM while the file is open, and this fails where memfd is not available. The provider is not used after this returns.
+
+     @param provider The data provider.
+
+     @return NULL if successful, or an error string.
+     */
+    const char *openDataProvider(const SuperpoweredDataProvider *provider);
+
+    /**
+     @brief Decodes the requested number of samples.
+
+     @return End of file (0), ok (1) or error (2).
+
+     @param output The buffer to put 32-bit floating point interleaved stereo audio. Must be at least this big: (*samples * 8) + 32768 bytes.
+     @param samples On input, the requested number of samples. Should be >= samplesPerFrame. On return, the samples decoded.
+     */
+    unsigned char decode(float *output, unsigned int *samples);
+
+    /**
+     @brief Jumps to a specific position.
+
+     @return The new position.
+
+     @param sample The position (a sample index).
+     @param precise Some codecs may not jump precisely due internal framing. Set precise to true if you want exact positioning (for a little performance penalty of 1 memmove). Uncompressed files are always precise.
+     */
+    int64_t seekTo(int64_t sample, bool precise);
+
+    /**
+     @return The SuperpoweredDecoder used for compressed files (for metadata for example), or NULL if the current file is read directly or it's an MP3 file decoded by SuperpoweredMP3FloatDecoder.
+     */
+    SuperpoweredDecoder *getDecoder();
+
+    SuperpoweredFloatDecoder();
+    ~SuperpoweredFloatDecoder();
+
+private:
+    floatDecoderInternals *internals;
+    SuperpoweredFloatDecoder(const SuperpoweredFloatDecoder&);
+    SuperpoweredFloatDecoder& operator=(const SuperpoweredFloatDecoder&);
+};
+
+#endif
@@ -0,0 +1,989 @@
+#include "SuperpoweredMP3FloatDecoder.h"
+#include "SuperpoweredSeekIndex.h"
+#include "SuperpoweredSIMD.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define MP3_MAXRESERVOIRBYTES 511 // main_data_begin is 9 bits.
+#define MP3_READERPADDING 64 // Zero bytes after the main data. The checks of a damaged granule stop it this close to the end.
+#define MP3_MAINDATABYTES (MP3_MAXRESERVOIRBYTES + 1441 + MP3_READERPADDING) // The reservoir and the main data of the largest frame.
+
+// The Huffman code tables of ISO/IEC 11172-3 Annex B (table B.7), as multi-level lookup tables.
+// An entry is a value (bit 15 clear: the remaining length of the code in bits 8-11, x in bits 4-7 and y in bits 0-3), or points to the next level (bit 15 set: the bits of the level in bits 11-14, its offset from the table in bits 0-10).
+typedef struct mp3HuffmanTable {
+    unsigned short offset, bits, linbits;
+} mp3HuffmanTable;
+
+static const unsigned short mp3HuffmanLookup[4408] = {
+    0x0311, 0x0301, 0x0210, 0x0210, 0x0100, 0x0100, 0x0100, 0x0100, 0x0622, 0x0602, 0x0512, 0x0512, 0x0521, 0x0521, 0x0520, 0x0520,
+    0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0622, 0x0602, 0x0512, 0x0512, 0x0521, 0x0521, 0x0520, 0x0520,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211,
+    0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201,
+    0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0201, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0833, 0x0823, 0x0732, 0x0732, 0x0631, 0x0631, 0x0631, 0x0631,
+    0x0713, 0x0713, 0x0703, 0x0703, 0x0730, 0x0730, 0x0722, 0x0722, 0x0612, 0x0612, 0x0612, 0x0612, 0x0621, 0x0621, 0x0621, 0x0621,
+    0x0602, 0x0602, 0x0602, 0x0602, 0x0620, 0x0620, 0x0620, 0x0620, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311,
+    0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311,
+    0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0733, 0x0703, 0x0623, 0x0623, 0x0632, 0x0632, 0x0630, 0x0630,
+    0x0513, 0x0513, 0x0513, 0x0513, 0x0531, 0x0531, 0x0531, 0x0531, 0x0522, 0x0522, 0x0522, 0x0522, 0x0502, 0x0502, 0x0502, 0x0502,
+    0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421,
+    0x0420, 0x0420, 0x0420, 0x0420, 0x0420, 0x0420, 0x0420, 0x0420, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211,
+    0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211,
+    0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+    0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x9108, 0x8906, 0x8902, 0x0815, 0x0851, 0x8900, 0x0850, 0x8904,
+    0x0824, 0x0842, 0x0714, 0x0714, 0x0741, 0x0741, 0x0740, 0x0740, 0x0804, 0x0823, 0x0832, 0x0803, 0x0713, 0x0713, 0x0731, 0x0731,
+    0x0730, 0x0730, 0x0722, 0x0722, 0x0612, 0x0612, 0x0612, 0x0612, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521,
+    0x0602, 0x0602, 0x0602, 0x0602, 0x0620, 0x0620, 0x0620, 0x0620, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411,
+    0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0105, 0x0134, 0x0125, 0x0152, 0x0143, 0x0133, 0x0135, 0x0144,
+    0x0255, 0x0245, 0x0254, 0x0253, 0x990a, 0x9102, 0x8900, 0x0815, 0x0851, 0x8908, 0x8906, 0x0824, 0x0842, 0x0814, 0x0741, 0x0741,
+    0x0804, 0x0840, 0x0823, 0x0832, 0x0813, 0x0831, 0x0803, 0x0830, 0x0622, 0x0622, 0x0622, 0x0622, 0x0602, 0x0602, 0x0602, 0x0602,
+    0x0620, 0x0620, 0x0620, 0x0620, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412,
+    0x0412, 0x0412, 0x0412, 0x0412, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421,
+    0x0421, 0x0421, 0x0421, 0x0421, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211,
+    0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211,
+    0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211,
+    0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211, 0x0211,
+    0x0211, 0x0211, 0x0211, 0x0211, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0152, 0x0105, 0x0235, 0x0244, 0x0125, 0x0125, 0x0150, 0x0133, 0x0134, 0x0143, 0x0355, 0x0354,
+    0x0245, 0x0245, 0x0153, 0x0153, 0x0153, 0x0153, 0x8902, 0x0835, 0x0853, 0x8900, 0x0844, 0x0825, 0x0852, 0x0815, 0x0751, 0x0751,
+    0x0734, 0x0734, 0x0743, 0x0743, 0x0850, 0x0804, 0x0724, 0x0724, 0x0742, 0x0742, 0x0733, 0x0733, 0x0740, 0x0740, 0x0614, 0x0614,
+    0x0614, 0x0614, 0x0641, 0x0641, 0x0641, 0x0641, 0x0623, 0x0623, 0x0623, 0x0623, 0x0632, 0x0632, 0x0632, 0x0632, 0x0513, 0x0513,
+    0x0513, 0x0513, 0x0513, 0x0513, 0x0513, 0x0513, 0x0531, 0x0531, 0x0531, 0x0531, 0x0531, 0x0531, 0x0531, 0x0531, 0x0603, 0x0603,
+    0x0603, 0x0603, 0x0630, 0x0630, 0x0630, 0x0630, 0x0522, 0x0522, 0x0522, 0x0522, 0x0522, 0x0522, 0x0522, 0x0522, 0x0502, 0x0502,
+    0x0502, 0x0502, 0x0502, 0x0502, 0x0502, 0x0502, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412,
+    0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421,
+    0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0420, 0x0420, 0x0420, 0x0420, 0x0420, 0x0420, 0x0420, 0x0420, 0x0420, 0x0420,
+    0x0420, 0x0420, 0x0420, 0x0420, 0x0420, 0x0420, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311,
+    0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311,
+    0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+    0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+    0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0154, 0x0105, 0x0155, 0x0145, 0x992a, 0x911e, 0x9922, 0x8914, 0x9108, 0x911a,
+    0x9104, 0x0817, 0x0871, 0x8912, 0x910c, 0x9116, 0x0816, 0x0861, 0x0860, 0x8902, 0x8910, 0x8900, 0x0814, 0x0841, 0x0840, 0x0823,
+    0x0832, 0x0803, 0x0713, 0x0713, 0x0731, 0x0731, 0x0730, 0x0730, 0x0722, 0x0722, 0x0612, 0x0612, 0x0612, 0x0612, 0x0621, 0x0621,
+    0x0621, 0x0621, 0x0602, 0x0602, 0x0602, 0x0602, 0x0620, 0x0620, 0x0620, 0x0620, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411,
+    0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0133, 0x0104, 0x0105, 0x0150, 0x0106, 0x0106,
+    0x0253, 0x0244, 0x0264, 0x0207, 0x0170, 0x0170, 0x0225, 0x0252, 0x0115, 0x0115, 0x0124, 0x0142, 0x0136, 0x0126, 0x0127, 0x0172,
+    0x0151, 0x0151, 0x0234, 0x0243, 0x0162, 0x0162, 0x0245, 0x0235, 0x0274, 0x0256, 0x0265, 0x0237, 0x0273, 0x0273, 0x0246, 0x0246,
+    0x0355, 0x0354, 0x0263, 0x0263, 0x0377, 0x0367, 0x0376, 0x0357, 0x0375, 0x0366, 0x0247, 0x0247, 0x911a, 0x9912, 0x910c, 0x8910,
+    0x9108, 0x0827, 0x0872, 0x8902, 0x0771, 0x0771, 0x0817, 0x0870, 0x0836, 0x0863, 0x0860, 0x8904, 0x8900, 0x0815, 0x0762, 0x0762,
+    0x0826, 0x0806, 0x0716, 0x0716, 0x0761, 0x0761, 0x0851, 0x0834, 0x0850, 0x8906, 0x0824, 0x0842, 0x0814, 0x0841, 0x0804, 0x0840,
+    0x0723, 0x0723, 0x0732, 0x0732, 0x0613, 0x0613, 0x0613, 0x0613, 0x0631, 0x0631, 0x0631, 0x0631, 0x0703, 0x0703, 0x0730, 0x0730,
+    0x0622, 0x0622, 0x0622, 0x0622, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0412, 0x0412, 0x0412, 0x0412,
+    0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0502, 0x0502, 0x0502, 0x0502,
+    0x0502, 0x0502, 0x0502, 0x0502, 0x0520, 0x0520, 0x0520, 0x0520, 0x0520, 0x0520, 0x0520, 0x0520, 0x0311, 0x0311, 0x0311, 0x0311,
+    0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311,
+    0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+    0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0152, 0x0105, 0x0164, 0x0107,
+    0x0144, 0x0125, 0x0143, 0x0133, 0x0245, 0x0254, 0x0235, 0x0253, 0x0256, 0x0265, 0x0137, 0x0137, 0x0173, 0x0146, 0x0266, 0x0266,
+    0x0247, 0x0247, 0x0274, 0x0274, 0x0357, 0x0355, 0x0277, 0x0267, 0x0276, 0x0275, 0x910c, 0x8908, 0x8904, 0x890a, 0x0856, 0x0837,
+    0x8906, 0x0827, 0x0872, 0x0846, 0x0864, 0x0817, 0x0871, 0x8902, 0x0836, 0x0863, 0x0845, 0x0854, 0x0844, 0x8900, 0x0726, 0x0726,
+    0x0762, 0x0762, 0x0761, 0x0761, 0x0816, 0x0860, 0x0835, 0x0853, 0x0825, 0x0852, 0x0715, 0x0715, 0x0751, 0x0751, 0x0734, 0x0734,
+    0x0743, 0x0743, 0x0850, 0x0804, 0x0724, 0x0724, 0x0742, 0x0742, 0x0714, 0x0714, 0x0633, 0x0633, 0x0633, 0x0633, 0x0641, 0x0641,
+    0x0641, 0x0641, 0x0623, 0x0623, 0x0623, 0x0623, 0x0632, 0x0632, 0x0632, 0x0632, 0x0740, 0x0740, 0x0703, 0x0703, 0x0630, 0x0630,
+    0x0630, 0x0630, 0x0513, 0x0513, 0x0513, 0x0513, 0x0513, 0x0513, 0x0513, 0x0513, 0x0531, 0x0531, 0x0531, 0x0531, 0x0531, 0x0531,
+    0x0531, 0x0531, 0x0522, 0x0522, 0x0522, 0x0522, 0x0522, 0x0522, 0x0522, 0x0522, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412,
+    0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0412, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421,
+    0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0421, 0x0502, 0x0502, 0x0502, 0x0502, 0x0502, 0x0502,
+    0x0502, 0x0502, 0x0520, 0x0520, 0x0520, 0x0520, 0x0520, 0x0520, 0x0520, 0x0520, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400,
+    0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311,
+    0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311,
+    0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301,
+    0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0301, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0106, 0x0105, 0x0107, 0x0170, 0x0166, 0x0147,
+    0x0173, 0x0155, 0x0157, 0x0175, 0x0174, 0x0165, 0x0277, 0x0267, 0x0176, 0x0176, 0xa96e, 0xa94e, 0xa92e, 0xa208, 0xa11e, 0xa23a,
+    0x9916, 0x9a32, 0x990e, 0x9a52, 0x9a2a, 0x9a5a, 0x8a06, 0x910a, 0x9a22, 0x8a04, 0x9200, 0x9104, 0x924e, 0x921e, 0x0881, 0x8908,
+    0x89fe, 0x8902, 0x921a, 0x8900, 0x0815, 0x0851, 0x8a4c, 0x8a18, 0x8a4a, 0x0814, 0x0741, 0x0741, 0x0804, 0x0840, 0x0823, 0x0832,
+    0x0713, 0x0713, 0x0731, 0x0731, 0x0703, 0x0703, 0x0730, 0x0730, 0x0722, 0x0722, 0x0612, 0x0612, 0x0612, 0x0612, 0x0621, 0x0621,
+    0x0621, 0x0621, 0x0602, 0x0602, 0x0602, 0x0602, 0x0620, 0x0620, 0x0620, 0x0620, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411,
+    0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401,
+    0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0152, 0x0105, 0x0106, 0x0160, 0x0171, 0x0171,
+    0x0255, 0x0207, 0x0108, 0x0180, 0x0209, 0x0290, 0x0248, 0x0284, 0x021a, 0x021a, 0x02a1, 0x02a1, 0x030a, 0x0368, 0x02a0, 0x02a0,
+    0x021b, 0x021b, 0x02b1, 0x02b1, 0x030b, 0x03b0, 0x0396, 0x034a, 0x03c1, 0x03c1, 0x0498, 0x040c, 0x03c0, 0x03c0, 0x04b4, 0x046a,
+    0x04a6, 0x0479, 0x033b, 0x033b, 0x03b3, 0x03b3, 0x0488, 0x045a, 0x05d3, 0x057b, 0x042d, 0x042d, 0x04d2, 0x04d2, 0x041d, 0x041d,
+    0x04b7, 0x04b7, 0x055c, 0x05c5, 0x0599, 0x057a, 0x04c3, 0x04c3, 0x05a7, 0x0597, 0x044b, 0x044b, 0x03d1, 0x03d1, 0x03d1, 0x03d1,
+    0x040d, 0x040d, 0x04d0, 0x04d0, 0x048a, 0x048a, 0x04a8, 0x04a8, 0x04f0, 0x04f0, 0x05ba, 0x05e5, 0x05e4, 0x058c, 0x056d, 0x05e3,
+    0x04e2, 0x04e2, 0x052e, 0x050e, 0x041e, 0x041e, 0x04e1, 0x04e1, 0x05e0, 0x055d, 0x05d5, 0x057c, 0x05c7, 0x054d, 0x058b, 0x05b8,
+    0x05d4, 0x059a, 0x05a9, 0x056c, 0x04c6, 0x04c6, 0x043d, 0x043d, 0xa9d4, 0xa1c0, 0x99b2, 0x91d0, 0x99a6, 0x999c, 0x91bc, 0x9196,
+    0x8992, 0x89b0, 0x89fc, 0x89ba, 0x898e, 0x91f8, 0x053f, 0x89a4, 0x052f, 0x05f2, 0x8994, 0x050f, 0x8990, 0x05ab, 0x899a, 0x054e,
+    0x89f6, 0x053e, 0x05b9, 0x89ae, 0x041f, 0x041f, 0x04f1, 0x04f1, 0x014f, 0x01f4, 0x01c9, 0x015e, 0x01e8, 0x015f, 0x016e, 0x019c,
+    0x02cb, 0x02f6, 0x016f, 0x016f, 0x017d, 0x01d7, 0x028e, 0x028e, 0x037f, 0x037e, 0x01f7, 0x01f7, 0x01f7, 0x01f7, 0x018d, 0x01d8,
+    0x028f, 0x028f, 0x02f8, 0x02f8, 0x02cc, 0x02cc, 0x03ae, 0x039e, 0x019b, 0x01aa, 0x019d, 0x01d9, 0x03fa, 0x03cd, 0x02be, 0x02be,
+    0x02eb, 0x02eb, 0x029f, 0x029f, 0x01ac, 0x01bb, 0x01da, 0x01da, 0x02ad, 0x02bc, 0x03fb, 0x03fb, 0x03ce, 0x03ce, 0x03dc, 0x03dc,
+    0x04af, 0x04e9, 0x02ec, 0x02ec, 0x02ec, 0x02ec, 0x02dd, 0x02dd, 0x02dd, 0x02dd, 0x02f9, 0x02ea, 0x02bd, 0x02db, 0x89f4, 0x05fd,
+    0x04ed, 0x04ed, 0x03ff, 0x03ff, 0x03ff, 0x03ff, 0x03ef, 0x03ef, 0x03ef, 0x03ef, 0x03df, 0x03df, 0x03df, 0x03df, 0x03ee, 0x03ee,
+    0x03ee, 0x03ee, 0x03cf, 0x03cf, 0x03cf, 0x03cf, 0x03de, 0x03de, 0x03de, 0x03de, 0x03bf, 0x03bf, 0x03bf, 0x03bf, 0x01fe, 0x01fc,
+    0x01c8, 0x01d6, 0x02ca, 0x02e6, 0x01f3, 0x01f3, 0x01f5, 0x01e7, 0x0116, 0x0161, 0x0237, 0x0227, 0x0117, 0x0117, 0x0182, 0x0118,
+    0x0119, 0x0191, 0x044c, 0x04c4, 0x046b, 0x04b6, 0x033c, 0x033c, 0x032c, 0x032c, 0x03c2, 0x03c2, 0x035b, 0x035b, 0x04b5, 0x0489,
+    0x031c, 0x031c, 0x0150, 0x0124, 0x0253, 0x0244, 0x0125, 0x0125, 0x0254, 0x0226, 0x0262, 0x0235, 0x0272, 0x0272, 0x0346, 0x0364,
+    0x0128, 0x0128, 0x0128, 0x0128, 0x0229, 0x0229, 0x0292, 0x0292, 0x0357, 0x0375, 0x0238, 0x0238, 0x033a, 0x03a3, 0x0359, 0x0395,
+    0x022a, 0x022a, 0x02a2, 0x02a2, 0x032b, 0x032b, 0x04a5, 0x0469, 0x03a4, 0x03a4, 0x0478, 0x0487, 0x0394, 0x0394, 0x0477, 0x0476,
+    0x02b2, 0x02b2, 0x02b2, 0x02b2, 0x0142, 0x0133, 0x0134, 0x0143, 0x0270, 0x0236, 0x0263, 0x0245, 0x0386, 0x0349, 0x0293, 0x0293,
+    0x0339, 0x0358, 0x0385, 0x0367, 0x0283, 0x0283, 0x0366, 0x0347, 0x0374, 0x0356, 0x0365, 0x0373, 0xa9f6, 0xa936, 0xa1e0, 0xa19c,
+    0xa162, 0x99c8, 0x9994, 0xa126, 0x99c0, 0x998c, 0x991e, 0x99d8, 0x91bc, 0x9916, 0x990e, 0x917a, 0x915e, 0x91b8, 0x9188, 0x9176,
+    0x915a, 0x91f0, 0x91b4, 0x9184, 0x89d6, 0x8974, 0x8958, 0x910a, 0x89b2, 0x8982, 0x9106, 0x89d4, 0x8972, 0x89f4, 0x0891, 0x8956,
+    0x89b0, 0x89d2, 0x8980, 0x89ae, 0x0828, 0x0882, 0x0818, 0x0881, 0x8904, 0x89d0, 0x897e, 0x89ac, 0x0827, 0x0872, 0x0864, 0x0817,
+    0x0855, 0x0871, 0x8902, 0x0836, 0x0863, 0x0845, 0x0854, 0x0826, 0x0862, 0x0816, 0x8900, 0x0835, 0x0761, 0x0761, 0x0853, 0x0844,
+    0x0725, 0x0725, 0x0752, 0x0752, 0x0715, 0x0715, 0x0751, 0x0751, 0x0805, 0x0850, 0x0734, 0x0734, 0x0743, 0x0743, 0x0724, 0x0724,
+    0x0742, 0x0742, 0x0733, 0x0733, 0x0641, 0x0641, 0x0641, 0x0641, 0x0714, 0x0714, 0x0704, 0x0704, 0x0623, 0x0623, 0x0623, 0x0623,
+    0x0632, 0x0632, 0x0632, 0x0632, 0x0740, 0x0740, 0x0703, 0x0703, 0x0613, 0x0613, 0x0613, 0x0613, 0x0631, 0x0631, 0x0631, 0x0631,
+    0x0630, 0x0630, 0x0630, 0x0630, 0x0522, 0x0522, 0x0522, 0x0522, 0x0522, 0x0522, 0x0522, 0x0522, 0x0512, 0x0512, 0x0512, 0x0512,
+    0x0512, 0x0512, 0x0512, 0x0512, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0502, 0x0502, 0x0502, 0x0502,
+    0x0502, 0x0502, 0x0502, 0x0502, 0x0520, 0x0520, 0x0520, 0x0520, 0x0520, 0x0520, 0x0520, 0x0520, 0x0311, 0x0311, 0x0311, 0x0311,
+    0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311,
+    0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0311, 0x0401, 0x0401, 0x0401, 0x0401,
+    0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0410, 0x0410, 0x0410, 0x0410,
+    0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0300, 0x0300, 0x0300, 0x0300,
+    0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+    0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0106, 0x0160, 0x0107, 0x0170,
+    0x0174, 0x0108, 0x0193, 0x0193, 0x0277, 0x0209, 0x020a, 0x02a0, 0x0168, 0x0168, 0x027a, 0x027a, 0x02a7, 0x02a7, 0x02a6, 0x02a6,
+    0x03c0, 0x030b, 0x02b6, 0x02b6, 0x0399, 0x030c, 0x023c, 0x023c, 0x02c3, 0x02c3, 0x032d, 0x030d, 0x021d, 0x021d, 0x027b, 0x027b,
+    0x02b7, 0x02b7, 0x032e, 0x032e, 0x03aa, 0x03aa, 0x03e2, 0x03e2, 0x031e, 0x031e, 0x03e1, 0x03e1, 0x040e, 0x04e0, 0x035d, 0x035d,
+    0x03d5, 0x03d5, 0x04f9, 0x04f9, 0x04ea, 0x04ea, 0x04bd, 0x04bd, 0x04db, 0x04db, 0x048f, 0x048f, 0x04f8, 0x04f8, 0x04cc, 0x04cc,
+    0x049e, 0x049e, 0x04e9, 0x04e9, 0x047f, 0x047f, 0x04f7, 0x04f7, 0x04ad, 0x04ad, 0x04da, 0x04da, 0x04bc, 0x04bc, 0x046f, 0x046f,
+    0x05ae, 0x050f, 0x0119, 0x0190, 0x011a, 0x01a1, 0x01b2, 0x01b2, 0x02a5, 0x021b, 0x02b5, 0x021c, 0x0289, 0x0298, 0x03e6, 0x03e6,
+    0x032f, 0x032f, 0x03f2, 0x03f2, 0x046e, 0x04f0, 0x031f, 0x031f, 0x03f1, 0x03f1, 0x039c, 0x039c, 0x03c9, 0x03c9, 0x0129, 0x0167,
+    0x012a, 0x01a2, 0x0297, 0x0288, 0x022b, 0x025a, 0x01c2, 0x01c2, 0x022c, 0x025b, 0x0165, 0x0137, 0x0138, 0x0183, 0x0194, 0x0139,
+    0x0287, 0x023a, 0x01a3, 0x01a3, 0x023b, 0x0279, 0x01b3, 0x01b3, 0x03a9, 0x036c, 0x03c6, 0x033d, 0x02d3, 0x02d3, 0x02d2, 0x02d2,
+    0x038c, 0x03c8, 0x033e, 0x036d, 0x03d6, 0x03e3, 0x039b, 0x03b9, 0x03ca, 0x03ca, 0x03bb, 0x03bb, 0x04d9, 0x048d, 0x034f, 0x034f,
+    0x03f4, 0x03f4, 0x033f, 0x033f, 0x03f3, 0x03f3, 0x03d8, 0x03d8, 0x0173, 0x0146, 0x0166, 0x0147, 0x0148, 0x0184, 0x0186, 0x0149,
+    0x0296, 0x024a, 0x02a4, 0x0278, 0x02c1, 0x024b, 0x02b4, 0x026a, 0x02a8, 0x024c, 0x02c4, 0x026b, 0x037c, 0x03c7, 0x034d, 0x038b,
+    0x02d4, 0x02d4, 0x03b8, 0x039a, 0x035e, 0x03ab, 0x03ba, 0x03e5, 0x037d, 0x03d7, 0x034e, 0x03e4, 0x0180, 0x0156, 0x0157, 0x0175,
+    0x0158, 0x0185, 0x0159, 0x0195, 0x02d1, 0x02d1, 0x035c, 0x03d0, 0x02c5, 0x02c5, 0x028a, 0x028a, 0x03cb, 0x03cb, 0x03f6, 0x03f6,
+    0x048e, 0x04e8, 0x045f, 0x049d, 0x03f5, 0x03f5, 0x037e, 0x037e, 0x03e7, 0x03e7, 0x03ac, 0x03ac, 0x01b1, 0x01b1, 0x02b0, 0x0269,
+    0x0176, 0x0192, 0x05ff, 0x05ef, 0x05fe, 0x05df, 0x04ee, 0x04ee, 0x05fd, 0x05cf, 0x05fc, 0x05de, 0x05ed, 0x05bf, 0x04fb, 0x04fb,
+    0x05ce, 0x05ec, 0x04dd, 0x04dd, 0x04af, 0x04af, 0x04fa, 0x04fa, 0x04be, 0x04be, 0x04eb, 0x04eb, 0x04cd, 0x04cd, 0x04dc, 0x04dc,
+    0x049f, 0x049f, 0x9a56, 0x9a4e, 0x924a, 0x08ff, 0x9246, 0x8a5e, 0xa9f0, 0x08f2, 0x89a0, 0x081f, 0x08f1, 0xa968, 0xa948, 0xa9ac,
+    0xa138, 0xa128, 0xa236, 0x9920, 0x9918, 0x99e8, 0x99a4, 0x9910, 0x99d4, 0x9908, 0x91e4, 0x91d0, 0x89a2, 0x9104, 0x91e0, 0x89ce,
+    0x0851, 0x8902, 0x89de, 0x89cc, 0x89dc, 0x0814, 0x0841, 0x8900, 0x0823, 0x0832, 0x0713, 0x0713, 0x0731, 0x0731, 0x0803, 0x0830,
+    0x0722, 0x0722, 0x0612, 0x0612, 0x0612, 0x0612, 0x0621, 0x0621, 0x0621, 0x0621, 0x0602, 0x0602, 0x0602, 0x0602, 0x0620, 0x0620,
+    0x0620, 0x0620, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411,
+    0x0411, 0x0411, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401,
+    0x0401, 0x0401, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310, 0x0310,
+    0x0310, 0x0310, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0104, 0x0140, 0x0115, 0x0105, 0x0161, 0x0161, 0x0206, 0x0260, 0x0364, 0x0355, 0x0207, 0x0207, 0x0117, 0x0117,
+    0x0117, 0x0117, 0x0281, 0x0281, 0x0280, 0x0280, 0x0308, 0x0356, 0x0237, 0x0237, 0x0229, 0x0229, 0x0292, 0x0292, 0x0376, 0x0309,
+    0x0219, 0x0219, 0x021a, 0x021a, 0x030a, 0x03a0, 0x0339, 0x0393, 0x0358, 0x0385, 0x03b1, 0x03b1, 0x040b, 0x04b0, 0x0469, 0x0496,
+    0x044a, 0x04a4, 0x0478, 0x0487, 0x03a3, 0x03a3, 0x043a, 0x0459, 0x032a, 0x032a, 0x04c1, 0x040c, 0x044b, 0x04b4, 0x046a, 0x04a6,
+    0x03b3, 0x03b3, 0x045a, 0x04a5, 0x032b, 0x032b, 0x03b2, 0x03b2, 0x031b, 0x031b, 0x059a, 0x056c, 0x05c6, 0x053d, 0x055c, 0x05c5,
+    0x040d, 0x040d, 0x058a, 0x05a8, 0x0599, 0x054c, 0x05b6, 0x057a, 0x043c, 0x043c, 0x055b, 0x0589, 0x041c, 0x041c, 0x04c0, 0x04c0,
+    0x0598, 0x0579, 0x03e2, 0x03e2, 0x03e2, 0x03e2, 0x042e, 0x042e, 0x041e, 0x041e, 0x059e, 0x899c, 0x898e, 0x8992, 0x898c, 0x8988,
+    0x05e6, 0x059c, 0x8998, 0x899e, 0x054e, 0x898a, 0x05c8, 0x053e, 0x056d, 0x8990, 0x8996, 0x05e1, 0x05d4, 0x8994, 0x057b, 0x899a,
+    0x04e3, 0x04e3, 0x050e, 0x05e0, 0x055d, 0x05d5, 0x057c, 0x05c7, 0x054d, 0x058b, 0x01d8, 0x016e, 0x01e4, 0x018c, 0x01bb, 0x018d,
+    0x018e, 0x01e8, 0x01d6, 0x019b, 0x019d, 0x01e7, 0x01b8, 0x01a9, 0x01b9, 0x01aa, 0x01ab, 0x01ba, 0x01b7, 0x01d0, 0x01bc, 0x01cb,
+    0x01e5, 0x01d7, 0x012f, 0x010f, 0x0162, 0x0116, 0x0366, 0x0328, 0x0282, 0x0282, 0x0347, 0x0374, 0x0218, 0x0218, 0x04d3, 0x04d3,
+    0x042d, 0x042d, 0x04d2, 0x04d2, 0x04d1, 0x04d1, 0x043b, 0x043b, 0x0597, 0x0588, 0x031d, 0x031d, 0x031d, 0x031d, 0x04c4, 0x04c4,
+    0x046b, 0x046b, 0x04c3, 0x04c3, 0x04a7, 0x04a7, 0x032c, 0x032c, 0x032c, 0x032c, 0x04c2, 0x04c2, 0x04b5, 0x04b5, 0x0150, 0x0124,
+    0x0125, 0x0152, 0x0263, 0x0245, 0x0254, 0x0226, 0x0273, 0x0273, 0x0365, 0x0346, 0x0227, 0x0227, 0x0272, 0x0272, 0x0142, 0x0133,
+    0x0134, 0x0143, 0x0153, 0x0153, 0x0235, 0x0244, 0x0171, 0x0171, 0x0270, 0x0236, 0x0291, 0x0291, 0x0390, 0x0348, 0x0384, 0x0375,
+    0x0338, 0x0383, 0x01f0, 0x01f0, 0x01f0, 0x01f0, 0x01f0, 0x01f0, 0x01f0, 0x01f0, 0x01f0, 0x01f0, 0x01f0, 0x01f0, 0x01f0, 0x01f0,
+    0x01f0, 0x01f0, 0x023f, 0x023f, 0x023f, 0x023f, 0x023f, 0x023f, 0x023f, 0x023f, 0xa222, 0x9232, 0x8a20, 0x921c, 0x9218, 0x9214,
+    0x9210, 0x05bd, 0x02c9, 0x027d, 0x015e, 0x015e, 0x027e, 0x02ac, 0x01ca, 0x01ca, 0x01cc, 0x01cc, 0x02ad, 0x02da, 0x02dc, 0x02db,
+    0x01ae, 0x01ae, 0x01be, 0x01cd, 0x03ce, 0x03ce, 0x04ec, 0x04dd, 0x02de, 0x02de, 0x02de, 0x02de, 0x02e9, 0x02e9, 0x02e9, 0x02e9,
+    0x03ea, 0x03ea, 0x03d9, 0x03d9, 0x01ee, 0x01ee, 0x02ed, 0x02eb, 0x0495, 0x0468, 0x03a1, 0x03a1, 0x0486, 0x0477, 0x0394, 0x0394,
+    0x0449, 0x0457, 0x0367, 0x0367, 0x02a2, 0x02a2, 0x02a2, 0x02a2, 0x025f, 0x02f5, 0x014f, 0x014f, 0x027f, 0x02f7, 0x026f, 0x02f6,
+    0x02af, 0x02af, 0x03fa, 0x039f, 0x03f9, 0x03f8, 0x028f, 0x028f, 0x03ef, 0x03fe, 0x03df, 0x03fd, 0x03cf, 0x03fc, 0x03bf, 0x03fb,
+    0x01f4, 0x01f3, 0x08ef, 0x08fe, 0x08df, 0x08fd, 0x08cf, 0x08fc, 0x08bf, 0x08fb, 0x07fa, 0x07fa, 0x08af, 0x089f, 0x07f9, 0x07f9,
+    0x07f8, 0x07f8, 0x088f, 0x087f, 0x07f7, 0x07f7, 0x076f, 0x076f, 0x07f6, 0x07f6, 0x075f, 0x075f, 0x07f5, 0x07f5, 0x074f, 0x074f,
+    0x07f4, 0x07f4, 0x073f, 0x073f, 0x07f3, 0x07f3, 0x072f, 0x072f, 0x07f2, 0x07f2, 0x07f1, 0x07f1, 0x081f, 0x08f0, 0x9934, 0x99ce,
+    0x99c6, 0x99ba, 0x04ff, 0x04ff, 0x04ff, 0x04ff, 0x04ff, 0x04ff, 0x04ff, 0x04ff, 0x04ff, 0x04ff, 0x04ff, 0x04ff, 0x04ff, 0x04ff,
+    0x04ff, 0x04ff, 0xa124, 0x9998, 0x99b2, 0x9964, 0x91aa, 0x914c, 0x9194, 0x9184, 0x91a6, 0x9160, 0x9148, 0x9190, 0x9180, 0x991c,
+    0x915c, 0x9144, 0x917c, 0x9914, 0x91a2, 0x990c, 0x89c2, 0x9158, 0x9140, 0x89c4, 0x9178, 0x8970, 0x898e, 0x8956, 0x89a0, 0x89b0,
+    0x8976, 0x896e, 0x898c, 0x8954, 0x89ae, 0x893e, 0x8974, 0x898a, 0x896c, 0x8952, 0x893c, 0x8972, 0x9108, 0x8988, 0x9104, 0x0873,
+    0x8950, 0x0872, 0x0846, 0x0864, 0x0855, 0x0871, 0x0836, 0x0863, 0x0845, 0x0854, 0x0826, 0x0862, 0x0816, 0x0861, 0x8902, 0x0835,
+    0x0853, 0x0844, 0x0825, 0x0852, 0x0815, 0x8900, 0x0751, 0x0751, 0x0834, 0x0843, 0x0724, 0x0724, 0x0742, 0x0742, 0x0733, 0x0733,
+    0x0714, 0x0714, 0x0741, 0x0741, 0x0804, 0x0840, 0x0723, 0x0723, 0x0732, 0x0732, 0x0613, 0x0613, 0x0613, 0x0613, 0x0631, 0x0631,
+    0x0631, 0x0631, 0x0703, 0x0703, 0x0730, 0x0730, 0x0622, 0x0622, 0x0622, 0x0622, 0x0512, 0x0512, 0x0512, 0x0512, 0x0512, 0x0512,
+    0x0512, 0x0512, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0521, 0x0602, 0x0602, 0x0602, 0x0602, 0x0620, 0x0620,
+    0x0620, 0x0620, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411, 0x0411,
+    0x0411, 0x0411, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401, 0x0401,
+    0x0401, 0x0401, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410, 0x0410,
+    0x0410, 0x0410, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400, 0x0400,
+    0x0400, 0x0400, 0x0105, 0x0150, 0x0106, 0x0160, 0x0117, 0x0117, 0x0207, 0x0270, 0x0181, 0x0181, 0x0208, 0x0280, 0x0279, 0x0279,
+    0x0297, 0x0297, 0x03a0, 0x0309, 0x0290, 0x0290, 0x03c0, 0x030b, 0x023b, 0x023b, 0x03b0, 0x030a, 0x021a, 0x021a, 0x026b, 0x026b,
+    0x02b6, 0x02b6, 0x03d0, 0x030c, 0x023c, 0x023c, 0x03ca, 0x03ca, 0x03bb, 0x03bb, 0x038d, 0x038d, 0x03d8, 0x03d8, 0x040e, 0x04e0,
+    0x030d, 0x030d, 0x02e6, 0x02e6, 0x02e6, 0x02e6, 0x010f, 0x010f, 0x010f, 0x010f, 0x03ee, 0x03de, 0x03ed, 0x03ce, 0x0182, 0x0118,
+    0x0119, 0x0191, 0x02a5, 0x021b, 0x02b1, 0x0269, 0x02c2, 0x025b, 0x02b5, 0x021c, 0x02d2, 0x021d, 0x027b, 0x02b7, 0x02b9, 0x02aa,
+    0x02e2, 0x021e, 0x0137, 0x0127, 0x0166, 0x0128, 0x0129, 0x0167, 0x012a, 0x01a2, 0x022b, 0x025a, 0x01b2, 0x01b2, 0x02c3, 0x027a,
+    0x02a7, 0x022c, 0x02c6, 0x023d, 0x02d3, 0x022d, 0x028c, 0x028c, 0x02c8, 0x02c8, 0x034e, 0x032e, 0x023e, 0x023e, 0x0138, 0x0183,
+    0x0139, 0x0193, 0x013a, 0x01a3, 0x0147, 0x0174, 0x0148, 0x0184, 0x0149, 0x0194, 0x024a, 0x0278, 0x0187, 0x0187, 0x0289, 0x0298,
+    0x02c1, 0x024b, 0x02a8, 0x0299, 0x024c, 0x02c4, 0x02c7, 0x024d, 0x028b, 0x02b8, 0x0156, 0x0165, 0x0157, 0x0175, 0x0158, 0x0185,
+    0x0159, 0x0195, 0x02d1, 0x025c, 0x02c5, 0x028a, 0x02e1, 0x025d, 0x02d5, 0x027c, 0x036e, 0x039c, 0x02c9, 0x02c9, 0x025e, 0x025e,
+    0x02ba, 0x02ba, 0x01a1, 0x0168, 0x01b4, 0x01b4, 0x026a, 0x02a6, 0x02d4, 0x029a, 0x02a9, 0x026c, 0x026d, 0x02d6, 0x02e3, 0x029b,
+    0x0176, 0x0192, 0x0186, 0x0177, 0x02e5, 0x02e5, 0x03ab, 0x037d, 0x02d7, 0x02d7, 0x02e4, 0x02e4, 0x03cb, 0x038e, 0x03e8, 0x039d,
+    0x03d9, 0x037e, 0x03e7, 0x03ac, 0x01b3, 0x0188, 0x0196, 0x01a4, 0x03bd, 0x03db, 0x03cc, 0x039e, 0x03e9, 0x03ad, 0x03da, 0x03bc,
+    0x03ec, 0x03dd, 0x03be, 0x03eb, 0x03cd, 0x03dc, 0x03ae, 0x03ea
+};
+
+// Count1 table A. An entry is the length of the code in bits 8-11 and vwxy in bits 0-3. Table B is the 4-bit inverted value.
+static const unsigned short mp3Count1Lookup[64] = {
+    0x060b, 0x060f, 0x060d, 0x060e, 0x0607, 0x0605, 0x0509, 0x0509, 0x0506, 0x0506, 0x0503, 0x0503, 0x050a, 0x050a, 0x050c, 0x050c,
+    0x0402, 0x0402, 0x0402, 0x0402, 0x0401, 0x0401, 0x0401, 0x0401, 0x0404, 0x0404, 0x0404, 0x0404, 0x0408, 0x0408, 0x0408, 0x0408,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+    0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100
+};
+
+static const mp3HuffmanTable mp3HuffmanTables[32] = {
+    { 0, 0, 0 }, { 0, 3, 0 }, { 8, 6, 0 }, { 72, 6, 0 }, { 0, 0, 0 }, { 136, 8, 0 }, { 392, 7, 0 }, { 520, 8, 0 },
+    { 788, 8, 0 }, { 1062, 8, 0 }, { 1322, 8, 0 }, { 1628, 8, 0 }, { 1914, 8, 0 }, { 2186, 8, 0 }, { 0, 0, 0 }, { 2796, 8, 0 },
+    { 3330, 8, 1 }, { 3330, 8, 2 }, { 3330, 8, 3 }, { 3330, 8, 4 }, { 3330, 8, 6 }, { 3330, 8, 8 }, { 3330, 8, 10 }, { 3330, 8, 13 },
+    { 3938, 8, 4 }, { 3938, 8, 5 }, { 3938, 8, 6 }, { 3938, 8, 7 }, { 3938, 8, 8 }, { 3938, 8, 9 }, { 3938, 8, 11 }, { 3938, 8, 13 }
+};
+
+// Scalefactor band boundaries of long and short blocks. 44100, 48000, 32000 Hz (MPEG-1), 22050, 24000, 16000 Hz (MPEG-2), 11025, 12000, 8000 Hz (MPEG-2.5).
+static const unsigned short mp3LongBands[9][23] = {
+    { 0, 4, 8, 12, 16, 20, 24, 30, 36, 44, 52, 62, 74, 90, 110, 134, 162, 196, 238, 288, 342, 418, 576 },
+    { 0, 4, 8, 12, 16, 20, 24, 30, 36, 42, 50, 60, 72, 88, 106, 128, 156, 190, 230, 276, 330, 384, 576 },
+    { 0, 4, 8, 12, 16, 20, 24, 30, 36, 44, 54, 66, 82, 102, 126, 156, 194, 240, 296, 364, 448, 550, 576 },
+    { 0, 6, 12, 18, 24, 30, 36, 44, 54, 66, 80, 96, 116, 140, 168, 200, 238, 284, 336, 396, 464, 522, 576 },
+    { 0, 6, 12, 18, 24, 30, 36, 44, 54, 66, 80, 96, 114, 136, 162, 194, 232, 278, 332, 394, 464, 540, 576 },
+    { 0, 6, 12, 18, 24, 30, 36, 44, 54, 66, 80, 96, 116, 140, 168, 200, 238, 284, 336, 396, 464, 522, 576 },
+    { 0, 6, 12, 18, 24, 30, 36, 44, 54, 66, 80, 96, 116, 140, 168, 200, 238, 284, 336, 396, 464, 522, 576 },
+    { 0, 6, 12, 18, 24, 30, 36, 44, 54, 66, 80, 96, 116, 140, 168, 200, 238, 284, 336, 396, 464, 522, 576 },
+    { 0, 12, 24, 36, 48, 60, 72, 88, 108, 132, 160, 192, 232, 280, 336, 400, 476, 566, 568, 570, 572, 574, 576 }
+};
+static const unsigned char mp3ShortBands[9][14] = {
+    { 0, 4, 8, 12, 16, 22, 30, 40, 52, 66, 84, 106, 136, 192 },
+    { 0, 4, 8, 12, 16, 22, 28, 38, 50, 64, 80, 100, 126, 192 },
+    { 0, 4, 8, 12, 16, 22, 30, 42, 58, 78, 104, 138, 180, 192 },
+    { 0, 4, 8, 12, 18, 24, 32, 42, 56, 74, 100, 132, 174, 192 },
+    { 0, 4, 8, 12, 18, 26, 36, 48, 62, 80, 104, 136, 180, 192 },
+    { 0, 4, 8, 12, 18, 26, 36, 48, 62, 80, 104, 134, 174, 192 },
+    { 0, 4, 8, 12, 18, 26, 36, 48, 62, 80, 104, 134, 174, 192 },
+    { 0, 4, 8, 12, 18, 26, 36, 48, 62, 80, 104, 134, 174, 192 },
+    { 0, 8, 16, 24, 36, 52, 72, 96, 124, 160, 162, 164, 166, 192 }
+};
+
+static const unsigned char mp3Pretab[22] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 3, 3, 2, 0 };
+static const unsigned char mp3ScalefactorBits[2][16] = { // MPEG-1 slen1 and slen2 of scalefac_compress.
+    { 0, 0, 0, 0, 3, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4 },
+    { 0, 1, 2, 3, 0, 1, 2, 3, 1, 2, 3, 1, 2, 3, 2, 3 }
+};
+static const unsigned char mp3LSFScalefactors[6][3][4] = { // MPEG-2 nr_of_sfb: the number of scalefactors in the 4 parts, for long, short and mixed blocks.
+    { { 6, 5, 5, 5 }, { 9, 9, 9, 9 }, { 6, 9, 9, 9 } },
+    { { 6, 5, 7, 3 }, { 9, 9, 12, 6 }, { 6, 9, 12, 6 } },
+    { { 11, 10, 0, 0 }, { 18, 18, 0, 0 }, { 15, 18, 0, 0 } },
+    { { 7, 7, 7, 0 }, { 12, 12, 12, 0 }, { 6, 15, 12, 0 } },
+    { { 6, 6, 6, 3 }, { 12, 9, 9, 6 }, { 6, 12, 9, 6 } },
+    { { 8, 8, 5, 0 }, { 15, 12, 9, 0 }, { 6, 18, 9, 0 } }
+};
+static const float mp3AliasCoefficients[8] = { -0.6f, -0.535f, -0.33f, -0.185f, -0.095f, -0.041f, -0.0142f, -0.0037f };
+static const float mp3QuarterPowers[4] = { 1.0f, 1.18920712f, 1.41421356f, 1.68179283f }; // 2^(n/4).
+static const unsigned short mp3Bitrates[2][16] = { // kbps. MPEG-1, MPEG-2/2.5 layer 3.
+    { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0 },
+    { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0 }
+};
+static const unsigned int mp3Samplerates[3] = { 44100, 48000, 32000 };
+
+typedef struct mp3FrameHeader {
+    unsigned int bytes, samplerate, versionTag, bandIndex, mode, modeExtension, sideInfoBytes;
+    bool lsf, crc; // lsf: MPEG-2 or 2.5, one granule per frame.
+} mp3FrameHeader;
+
+typedef struct mp3Granule {
+    unsigned int part23Length, bigValues, globalGain, scalefacCompress, blockType, tableSelect[3], subblockGain[3], region1Start, region2Start, scalefacScale, count1Table;
+    bool mixedBlock, preflag, valid;
+} mp3Granule;
+
+typedef enum mp3Stage {
+    mp3Stage_Reservoir, // Only the main data is stored for the next frames.
+    mp3Stage_Overlap,   // Decoded until the IMDCT, for its overlap.
+    mp3Stage_Synthesis  // Decoded entirely.
+} mp3Stage;
+
+typedef struct mp3FloatDecoderInternals {
+    SuperpoweredSIMDMP3State state;
+    SuperpoweredSeekIndex *index;
+    const unsigned char *data, *end, *position; // The file, and the next frame.
+    unsigned char *map; // The mapping of open(), NULL for openMemory().
+    size_t mapBytes;
+    int64_t framePosition; // The sample position of the next frame.
+    unsigned int versionTag, skipSamples, reservoirBytes, scfsi[2];
+    mp3Granule granules[2][2];
+    unsigned char longScalefactors[2][22], shortScalefactors[2][13][3], longLimits[22], shortLimits[13][3]; // The limits are the illegal MPEG-2 intensity positions of the right channel.
+    int quantized[576];
+    float lines[2][576], reordered[576], subbands[576], pcm[2][576];
+    float aliasCs[8], aliasCa[8], intensity[7][2], intensityLSF[2][32][2];
+    unsigned char mainData[MP3_MAINDATABYTES];
+} mp3FloatDecoderInternals;
+
+typedef struct mp3BitReader {
+    const unsigned char *data;
+    unsigned int position; // In bits.
+} mp3BitReader;
+
+// 1 to 24 bits.
+static inline unsigned int peekBits(const mp3BitReader *reader, unsigned int bits) {
+    const unsigned char *p = reader->data + (reader->position >> 3);
+    unsigned int value = ((unsigned int)p[0] << 24) | ((unsigned int)p[1] << 16) | ((unsigned int)p[2] << 8) | (unsigned int)p[3];
+    return (value << (reader->position & 7)) >> (32 - bits);
+}
+
+static inline unsigned int readBits(mp3BitReader *reader, unsigned int bits) {
+    if (!bits) return 0;
+    unsigned int value = peekBits(reader, bits);
+    reader->position += bits;
+    return value;
+}
+
+static inline unsigned int huffmanValue(mp3BitReader *reader, const unsigned short *table, unsigned int bits) {
+    unsigned int entry = table[peekBits(reader, bits)];
+    while (entry & 0x8000) {
+        reader->position += bits;
+        bits = (entry >> 11) & 15;
+        entry = table[(entry & 0x7ff) + peekBits(reader, bits)];
+    }
+    reader->position += entry >> 8;
+    return entry & 0xff;
+}
+
+static bool parseHeader(const unsigned char *p, mp3FrameHeader *header) {
+    if ((p[0] != 0xff) || ((p[1] & 0xe0) != 0xe0)) return false;
+    unsigned int version = (p[1] >> 3) & 3, layer = (p[1] >> 1) & 3, bitrateIndex = p[2] >> 4, samplerateIndex = (p[2] >> 2) & 3, padding = (p[2] >> 1) & 1;
+    if ((version == 1) || (layer != 1) || (bitrateIndex == 0) || (bitrateIndex == 15) || (samplerateIndex == 3)) return false; // Reserved, free format or not layer 3.
+
+    header->lsf = (version != 3);
+    unsigned int shift = header->lsf ? ((version == 2) ? 1 : 2) : 0;
+    header->samplerate = mp3Samplerates[samplerateIndex] >> shift;
+    header->bandIndex = shift * 3 + samplerateIndex;
+    header->bytes = (header->lsf ? 72 : 144) * (mp3Bitrates[header->lsf ? 1 : 0][bitrateIndex] * 1000) / header->samplerate + padding;
+    header->crc = !(p[1] & 1);
+    header->mode = p[3] >> 6;
+    header->modeExtension = (p[3] >> 4) & 3;
+    header->sideInfoBytes = header->lsf ? ((header->mode == 3) ? 9 : 17) : ((header->mode == 3) ? 17 : 32);
+    header->versionTag = (p[1] & 0x1e) | (samplerateIndex << 5); // The same as SuperpoweredSeekIndex's, the frames are walked the same way.
+    return true;
+}
+
+// A frame is accepted if the next one follows right after it, with the same version, or it's the last one.
+static bool isFrame(const unsigned char *p, const unsigned char *end, mp3FrameHeader *header) {
+    if ((end - p < 7) || !parseHeader(p, header)) return false;
+    const unsigned char *next = p + header->bytes;
+    if (next > end) return false;
+    if (end - next < 7) return true;
+    mp3FrameHeader nextHeader;
+    return parseHeader(next, &nextHeader) && (nextHeader.versionTag == header->versionTag);
+}
+
+// The next frame, found the same way as SuperpoweredSeekIndex::build() finds it, so the sample positions are the same.
+static const unsigned char *nextFrame(mp3FloatDecoderInternals *internals, mp3FrameHeader *header) {
+    const unsigned char *p = internals->position, *end = internals->end;
+    while (end - p >= 7) {
+        if (parseHeader(p, header) && (header->versionTag == internals->versionTag) && (header->bytes <= (size_t)(end - p))) {
+            internals->position = p + header->bytes;
+            return p;
+        }
+        // Lost sync (damaged data or a tag at the end), search for the next frame.
+        do p++; while ((end - p >= 7) && (!isFrame(p, end, header) || (header->versionTag != internals->versionTag)));
+    }
+    internals->position = end;
+    return NULL;
+}
+
+static void readGranule(mp3BitReader *reader, const mp3FrameHeader *header, mp3Granule *granule) {
+    granule->part23Length = readBits(reader, 12);
+    granule->bigValues = readBits(reader, 9);
+    granule->globalGain = readBits(reader, 8);
+    granule->scalefacCompress = readBits(reader, header->lsf ? 9 : 4);
+    granule->valid = (granule->bigValues <= 288);
+    const unsigned short *longBands = mp3LongBands[header->bandIndex];
+
+    if (readBits(reader, 1)) { // Window switching.
+        granule->blockType = readBits(reader, 2);
+        granule->mixedBlock = readBits(reader, 1) && (granule->blockType == 2);
+        granule->tableSelect[0] = readBits(reader, 5);
+        granule->tableSelect[1] = readBits(reader, 5);
+        granule->tableSelect[2] = 0;
+        for (int window = 0; window < 3; window++) granule->subblockGain[window] = readBits(reader, 3);
+        if (!granule->blockType) granule->valid = false;
+        // The first region is 36 lines of short blocks (72 at 8000 Hz), or 8 long bands. There is no third region.
+        granule->region1Start = (granule->blockType == 2) ? ((header->bandIndex == 8) ? 72 : 36) : longBands[8];
+        granule->region2Start = 576;
+    } else {
+        granule->blockType = 0;
+        granule->mixedBlock = false;
+        for (int region = 0; region < 3; region++) granule->tableSelect[region] = readBits(reader, 5);
+        granule->subblockGain[0] = granule->subblockGain[1] = granule->subblockGain[2] = 0;
+        unsigned int region0Count = readBits(reader, 4), region1Count = readBits(reader, 3);
+        granule->region1Start = longBands[region0Count + 1];
+        granule->region2Start = longBands[(region0Count + region1Count + 2 < 22) ? region0Count + region1Count + 2 : 22];
+    }
+    granule->preflag = header->lsf ? false : (readBits(reader, 1) != 0); // MPEG-2: set by scalefac_compress.
+    granule->scalefacScale = readBits(reader, 1);
+    granule->count1Table = readBits(reader, 1);
+}
+
+// Returns with main_data_begin.
+static unsigned int readSideInfo(mp3FloatDecoderInternals *internals, const mp3FrameHeader *header, const unsigned char *sideInfo) {
+    mp3BitReader reader = { sideInfo, 0 };
+    unsigned int numChannels = (header->mode == 3) ? 1 : 2, numGranules = header->lsf ? 1 : 2, mainDataBegin;
+    if (header->lsf) {
+        mainDataBegin = readBits(&reader, 8);
+        reader.position += numChannels; // Private bits.
+    } else {
+        mainDataBegin = readBits(&reader, 9);
+        reader.position += (numChannels == 1) ? 5 : 3;
+        for (unsigned int channel = 0; channel < numChannels; channel++) internals->scfsi[channel] = readBits(&reader, 4);
+    }
+    for (unsigned int granule = 0; granule < numGranules; granule++) {
+        for (unsigned int channel = 0; channel < numChannels; channel++) readGranule(&reader, header, &internals->granules[granule][channel]);
+    }
+    return mainDataBegin;
+}
+
+static void readScalefactors(mp3FloatDecoderInternals *internals, mp3BitReader *reader, const mp3FrameHeader *header, mp3Granule *granule, unsigned int granuleIndex, unsigned int channel) {
+    unsigned char *longScalefactors = internals->longScalefactors[channel], (*shortScalefactors)[3] = internals->shortScalefactors[channel];
+
+    if (!header->lsf) {
+        unsigned int bits1 = mp3ScalefactorBits[0][granule->scalefacCompress], bits2 = mp3ScalefactorBits[1][granule->scalefacCompress];
+        if (granule->blockType == 2) {
+            if (granule->mixedBlock) for (int sfb = 0; sfb < 8; sfb++) longScalefactors[sfb] = (unsigned char)readBits(reader, bits1);
+            for (int sfb = granule->mixedBlock ? 3 : 0; sfb < 12; sfb++) {
+                for (int window = 0; window < 3; window++) shortScalefactors[sfb][window] = (unsigned char)readBits(reader, (sfb < 6) ? bits1 : bits2);
+            }
+        } else {
+            static const unsigned char groups[5] = { 0, 6, 11, 16, 21 };
+            for (int group = 0; group < 4; group++) {
+                if (granuleIndex && (internals->scfsi[channel] & (8 >> group))) continue; // The first granule's scalefactors are used.
+                for (int sfb = groups[group]; sfb < groups[group + 1]; sfb++) longScalefactors[sfb] = (unsigned char)readBits(reader, (group < 2) ? bits1 : bits2);
+            }
+        }
+        longScalefactors[21] = 0;
+        shortScalefactors[12][0] = shortScalefactors[12][1] = shortScalefactors[12][2] = 0;
+        return;
+    }
+
+    // MPEG-2: scalefac_compress selects the bits of 4 parts. The right channel of intensity stereo has its own table.
+    unsigned int compress = granule->scalefacCompress, bits[4] = { 0, 0, 0, 0 }, table;
+    if ((channel == 1) && (header->mode == 1) && (header->modeExtension & 1)) {
+        compress >>= 1;
+        if (compress < 180) {
+            bits[0] = compress / 36; bits[1] = (compress % 36) / 6; bits[2] = compress % 6;
+            table = 3;
+        } else if (compress < 244) {
+            compress -= 180;
+            bits[0] = (compress & 63) >> 4; bits[1] = (compress & 15) >> 2; bits[2] = compress & 3;
+            table = 4;
+        } else {
+            compress -= 244;
+            bits[0] = compress / 3; bits[1] = compress % 3;
+            table = 5;
+        }
+    } else if (compress < 400) {
+        bits[0] = (compress >> 4) / 5; bits[1] = (compress >> 4) % 5; bits[2] = (compress & 15) >> 2; bits[3] = compress & 3;
+        table = 0;
+    } else if (compress < 500) {
+        compress -= 400;
+        bits[0] = (compress >> 2) / 5; bits[1] = (compress >> 2) % 5; bits[2] = compress & 3;
+        table = 1;
+    } else {
+        compress -= 500;
+        bits[0] = compress / 3; bits[1] = compress % 3;
+        table = 2;
+        granule->preflag = true;
+    }
+
+    unsigned int blockIndex = (granule->blockType == 2) ? (granule->mixedBlock ? 2 : 1) : 0, index = 0;
+    memset(longScalefactors, 0, 22);
+    memset(shortScalefactors, 0, 13 * 3);
+    for (int part = 0; part < 4; part++) {
+        unsigned char limit = (unsigned char)((1 << bits[part]) - 1);
+        for (unsigned int n = 0; n < mp3LSFScalefactors[table][blockIndex][part]; n++, index++) {
+            unsigned char value = (unsigned char)readBits(reader, bits[part]);
+            if ((blockIndex == 0) || ((blockIndex == 2) && (index < 6))) {
+                longScalefactors[index] = value;
+                internals->longLimits[index] = limit;
+            } else {
+                unsigned int shortIndex = (blockIndex == 2) ? index - 6 + 9 : index, sfb = shortIndex / 3, window = shortIndex % 3; // Mixed blocks continue at short band 3.
+                shortScalefactors[sfb][window] = value;
+                internals->shortLimits[sfb][window] = limit;
+            }
+        }
+    }
+}
+
+// Decodes the big values and count1 regions. Returns with the number of lines that may be non-zero, or -1 if the granule is damaged.
+static int readHuffman(mp3BitReader *reader, unsigned int partEnd, const mp3Granule *granule, int *quantized) {
+    unsigned int line = 0, bigValuesEnd = granule->bigValues * 2, regionEnds[3] = { granule->region1Start, granule->region2Start, 576 };
+
+    for (int region = 0; region < 3; region++) {
+        unsigned int regionEnd = (regionEnds[region] < bigValuesEnd) ? regionEnds[region] : bigValuesEnd, select = granule->tableSelect[region];
+        if (line >= regionEnd) continue;
+        if ((select == 4) || (select == 14)) return -1; // Not used by the standard.
+        if (!select) {
+            memset(quantized + line, 0, (regionEnd - line) * sizeof(int));
+            line = regionEnd;
+            continue;
+        }
+
+        const unsigned short *table = mp3HuffmanLookup + mp3HuffmanTables[select].offset;
+        unsigned int bits = mp3HuffmanTables[select].bits, linbits = mp3HuffmanTables[select].linbits;
+        for (; line < regionEnd; line += 2) {
+            if (reader->position > partEnd) return -1;
+            unsigned int value = huffmanValue(reader, table, bits);
+            int x = (int)(value >> 4), y = (int)(value & 15);
+            if (x) {
+                if ((x == 15) && linbits) x += (int)readBits(reader, linbits);
+                if (readBits(reader, 1)) x = -x;
+            }
+            if (y) {
+                if ((y == 15) && linbits) y += (int)readBits(reader, linbits);
+                if (readBits(reader, 1)) y = -y;
+            }
+            quantized[line] = x;
+            quantized[line + 1] = y;
+        }
+    }
+
+    while ((line <= 572) && (reader->position < partEnd)) {
+        unsigned int value;
+        if (granule->count1Table) value = 15 - readBits(reader, 4);
+        else {
+            unsigned int entry = mp3Count1Lookup[peekBits(reader, 6)];
+            reader->position += entry >> 8;
+            value = entry & 15;
+        }
+        int values[4];
+        for (int n = 0; n < 4; n++) {
+            values[n] = (int)((value >> (3 - n)) & 1);
+            if (values[n] && readBits(reader, 1)) values[n] = -1;
+        }
+        if (reader->position > partEnd) break; // Some encoders write a last quadruple over the end of the granule, it's dropped.
+        memcpy(quantized + line, values, sizeof(values));
+        line += 4;
+    }
+    if (line < 576) memset(quantized + line, 0, (576 - line) * sizeof(int));
+    return (int)line;
+}
+
+// 2^(quarterSteps / 4).
+static inline float quarterPower(int quarterSteps) {
+    return ldexpf(mp3QuarterPowers[quarterSteps & 3], quarterSteps >> 2);
+}
+
+// Requantizes the lines in the order of the bitstream: short bands are window by window.
+static void requantize(mp3FloatDecoderInternals *internals, const mp3FrameHeader *header, const mp3Granule *granule, unsigned int channel, unsigned int nonZeroLines, float *lines) {
+    const unsigned short *longBands = mp3LongBands[header->bandIndex];
+    const unsigned char *shortBands = mp3ShortBands[header->bandIndex];
+    const unsigned char *longScalefactors = internals->longScalefactors[channel], (*shortScalefactors)[3] = internals->shortScalefactors[channel];
+    int gain = (int)granule->globalGain - 210, scale = granule->scalefacScale ? 4 : 2;
+    unsigned int longEnd = (granule->blockType != 2) ? 22 : (granule->mixedBlock ? (header->lsf ? 6 : 8) : 0), line = 0;
+
+    for (unsigned int sfb = 0; (sfb < longEnd) && (line < nonZeroLines); sfb++) {
+        unsigned int width = longBands[sfb + 1] - longBands[sfb];
+        int steps = gain - scale * (longScalefactors[sfb] + (granule->preflag ? mp3Pretab[sfb] : 0));
+        SuperpoweredSIMDMP3Dequantize(internals->quantized + line, lines + line, width, quarterPower(steps));
+        line += width;
+    }
+    if (granule->blockType == 2) for (unsigned int sfb = granule->mixedBlock ? 3 : 0; (sfb < 13) && (line < nonZeroLines); sfb++) {
+        unsigned int width = shortBands[sfb + 1] - shortBands[sfb];
+        for (int window = 0; window < 3; window++) {
+            int steps = gain - 8 * (int)granule->subblockGain[window] - scale * shortScalefactors[sfb][window];
+            SuperpoweredSIMDMP3Dequantize(internals->quantized + line, lines + line, width, quarterPower(steps));
+            line += width;
+        }
+    }
+    if (line < 576) memset(lines + line, 0, (576 - line) * sizeof(float));
+}
+
+static void midSide(float *left, float *right, unsigned int numberOfValues) {
+    for (unsigned int n = 0; n < numberOfValues; n++) {
+        float mid = left[n], side = right[n];
+        left[n] = (mid + side) * (float)M_SQRT1_2;
+        right[n] = (mid - side) * (float)M_SQRT1_2;
+    }
+}
+
+static void intensity(float *left, float *right, unsigned int numberOfValues, const float *ratio) {
+    for (unsigned int n = 0; n < numberOfValues; n++) {
+        float value = left[n];
+        left[n] = value * ratio[0];
+        right[n] = value * ratio[1];
+    }
+}
+
+static bool nonZero(const float *values, unsigned int numberOfValues) {
+    for (unsigned int n = 0; n < numberOfValues; n++) if (values[n] != 0.0f) return true;
+    return false;
+}
+
+// Intensity stereo in the bands above the last non-zero band of the right channel (in short blocks window by window), mid/side stereo (if on) in the others.
+// The band structure is the right channel's. The last band has no scalefactor, it uses the intensity position of the band before.
+static void intensityStereo(mp3FloatDecoderInternals *internals, const mp3FrameHeader *header, const mp3Granule *granule) {
+    float *left = internals->lines[0], *right = internals->lines[1];
+    const unsigned short *longBands = mp3LongBands[header->bandIndex];
+    const unsigned char *shortBands = mp3ShortBands[header->bandIndex];
+    const float (*ratios)[2] = header->lsf ? internals->intensityLSF[granule->scalefacCompress & 1] : internals->intensity;
+    bool midSideStereo = (header->modeExtension & 2) != 0, nonZeroWindows[3] = { false, false, false };
+    int longEnd = (granule->blockType != 2) ? 22 : (granule->mixedBlock ? (header->lsf ? 6 : 8) : 0), shortStart = (granule->blockType != 2) ? 13 : (granule->mixedBlock ? 3 : 0);
+    unsigned int line = 576;
+
+    for (int sfb = 12; sfb >= shortStart; sfb--) {
+        unsigned int width = shortBands[sfb + 1] - shortBands[sfb], band = (sfb == 12) ? 11 : (unsigned int)sfb;
+        for (int window = 2; window >= 0; window--) {
+            line -= width;
+            if (!nonZeroWindows[window]) nonZeroWindows[window] = nonZero(right + line, width);
+            unsigned int position = internals->shortScalefactors[1][band][window];
+            bool legal = header->lsf ? (position != internals->shortLimits[band][window]) : (position < 7);
+            if (!nonZeroWindows[window] && legal) intensity(left + line, right + line, width, ratios[position]);
+            else if (midSideStereo) midSide(left + line, right + line, width);
+        }
+    }
+
+    bool nonZeroLong = nonZeroWindows[0] || nonZeroWindows[1] || nonZeroWindows[2];
+    for (int sfb = longEnd - 1; sfb >= 0; sfb--) {
+        unsigned int width = longBands[sfb + 1] - longBands[sfb], band = (sfb == 21) ? 20 : (unsigned int)sfb;
+        line -= width;
+        if (!nonZeroLong) nonZeroLong = nonZero(right + line, width);
+        unsigned int position = internals->longScalefactors[1][band];
+        bool legal = header->lsf ? (position != internals->longLimits[band]) : (position < 7);
+        if (!nonZeroLong && legal) intensity(left + line, right + line, width, ratios[position]);
+        else if (midSideStereo) midSide(left + line, right + line, width);
+    }
+}
+
+// Short bands from the bitstream order (band, window, line) to the IMDCT's: line k of window w at 3 * k + w.
+static void reorder(const float *lines, float *output, const unsigned char *shortBands, unsigned int firstBand) {
+    unsigned int start = shortBands[firstBand] * 3;
+    memcpy(output, lines, start * sizeof(float));
+    for (unsigned int sfb = firstBand; sfb < 13; sfb++) {
+        unsigned int from = shortBands[sfb], width = shortBands[sfb + 1] - from;
+        const float *input = lines + from * 3;
+        for (unsigned int window = 0; window < 3; window++) {
+            for (unsigned int n = 0; n < width; n++) output[(from + n) * 3 + window] = input[window * width + n];
+        }
+    }
+}
+
+static void antialias(mp3FloatDecoderInternals *internals, float *lines, unsigned int numSubbands) {
+    for (unsigned int subband = 1; subband < numSubbands; subband++) {
+        float *lower = lines + subband * 18 - 1, *upper = lines + subband * 18;
+        for (int n = 0; n < 8; n++) {
+            float a = lower[-n], b = upper[n];
+            lower[-n] = a * internals->aliasCs[n] - b * internals->aliasCa[n];
+            upper[n] = b * internals->aliasCs[n] + a * internals->aliasCa[n];
+        }
+    }
+}
+
+// Scalefactors, Huffman decoding and requantization of one granule of one channel. Returns false if the granule is damaged.
+static bool readChannel(mp3FloatDecoderInternals *internals, const mp3FrameHeader *header, mp3BitReader *reader, unsigned int partEnd, unsigned int granuleIndex, unsigned int channel) {
+    mp3Granule *granule = &internals->granules[granuleIndex][channel];
+    if (!granule->valid) return false;
+    readScalefactors(internals, reader, header, granule, granuleIndex, channel);
+    if (reader->position > partEnd) return false;
+    int nonZeroLines = readHuffman(reader, partEnd, granule, internals->quantized);
+    if (nonZeroLines < 0) return false;
+    requantize(internals, header, granule, channel, (unsigned int)nonZeroLines, internals->lines[channel]);
+    return true;
+}
+
+// The main data of a frame is at the end of the reservoir, main_data_begin bytes before it is the beginning of this frame's data.
+static void decodeFrame(mp3FloatDecoderInternals *internals, const unsigned char *frame, const mp3FrameHeader *header, float *output, mp3Stage stage) {
+    unsigned int numChannels = (header->mode == 3) ? 1 : 2, numGranules = header->lsf ? 1 : 2, sideInfoStart = header->crc ? 6 : 4, mainDataBytes = 0;
+    int mainDataBegin = -1; // Unknown: the frame is damaged.
+
+    if (sideInfoStart + header->sideInfoBytes <= header->bytes) {
+        unsigned char sideInfo[32 + 4]; // Padding for the bit reader.
+        memset(sideInfo, 0, sizeof(sideInfo));
+        memcpy(sideInfo, frame + sideInfoStart, header->sideInfoBytes);
+        mainDataBegin = (int)readSideInfo(internals, header, sideInfo);
+        mainDataBytes = header->bytes - sideInfoStart - header->sideInfoBytes;
+        memcpy(internals->mainData + internals->reservoirBytes, frame + sideInfoStart + header->sideInfoBytes, mainDataBytes);
+    }
+    unsigned int totalBytes = internals->reservoirBytes + mainDataBytes;
+    memset(internals->mainData + totalBytes, 0, MP3_READERPADDING);
+    bool intact = (mainDataBegin >= 0) && ((unsigned int)mainDataBegin <= internals->reservoirBytes); // The beginning may be before the first frame decoded.
+
+    if (stage != mp3Stage_Reservoir) {
+        mp3BitReader reader = { internals->mainData + internals->reservoirBytes - (intact ? mainDataBegin : 0), 0 };
+        unsigned int availableBits = intact ? ((unsigned int)mainDataBegin + mainDataBytes) * 8 : 0, partStart = 0;
+
+        for (unsigned int granuleIndex = 0; granuleIndex < numGranules; granuleIndex++) {
+            bool decoded[2] = { false, false };
+            for (unsigned int channel = 0; channel < numChannels; channel++) {
+                mp3Granule *granule = &internals->granules[granuleIndex][channel];
+                unsigned int partEnd = intact ? partStart + granule->part23Length : 0;
+                if (intact && (partEnd <= availableBits)) {
+                    reader.position = partStart;
+                    decoded[channel] = readChannel(internals, header, &reader, partEnd, granuleIndex, channel);
+                }
+                if (!decoded[channel]) memset(internals->lines[channel], 0, sizeof(internals->lines[channel]));
+                partStart = partEnd;
+            }
+
+            if ((header->mode == 1) && decoded[0] && decoded[1]) {
+                if (header->modeExtension & 1) intensityStereo(internals, header, &internals->granules[granuleIndex][1]);
+                else if (header->modeExtension & 2) midSide(internals->lines[0], internals->lines[1], 576);
+            }
+
+            for (unsigned int channel = 0; channel < numChannels; channel++) {
+                mp3Granule *granule = &internals->granules[granuleIndex][channel];
+                int blockType = decoded[channel] ? (int)granule->blockType : 0;
+                bool mixedBlock = decoded[channel] && granule->mixedBlock;
+                float *lines = internals->lines[channel];
+                if (blockType == 2) {
+                    if (mixedBlock) antialias(internals, lines, 2);
+                    reorder(lines, internals->reordered, mp3ShortBands[header->bandIndex], mixedBlock ? 3 : 0);
+                    lines = internals->reordered;
+                } else antialias(internals, lines, 32);
+
+                SuperpoweredSIMDMP3IMDCT(&internals->state, channel, lines, internals->subbands, blockType, mixedBlock);
+                if (stage == mp3Stage_Synthesis) SuperpoweredSIMDMP3Synthesis(&internals->state, channel, internals->subbands, internals->pcm[channel], 18);
+            }
+            if (output) SuperpoweredSIMDInterleave(internals->pcm[0], internals->pcm[numChannels - 1], output + granuleIndex * 576 * 2, 576);
+        }
+    }
+
+    // Keep the end of the main data for the next frames.
+    unsigned int keep = (totalBytes < MP3_MAXRESERVOIRBYTES) ? totalBytes : MP3_MAXRESERVOIRBYTES;
+    memmove(internals->mainData, internals->mainData + totalBytes - keep, keep);
+    internals->reservoirBytes = keep;
+}
+
+// Decoding starts at a frame, without bit reservoir and history.
+static void startAt(mp3FloatDecoderInternals *internals, int64_t byteOffset, int64_t framePosition) {
+    internals->position = internals->data + byteOffset;
+    internals->framePosition = framePosition;
+    internals->reservoirBytes = internals->skipSamples = 0;
+    SuperpoweredSIMDMP3Init(&internals->state);
+}
+
+static void closeFile(mp3FloatDecoderInternals *internals) {
+    if (internals->map) munmap(internals->map, internals->mapBytes);
+    internals->map = NULL;
+    internals->data = internals->end = internals->position = NULL;
+}
+
+static void clearProperties(SuperpoweredMP3FloatDecoder *decoder) {
+    decoder->durationSeconds = 0;
+    decoder->durationSamples = decoder->samplePosition = 0;
+    decoder->samplerate = decoder->samplesPerFrame = decoder->numChannels = 0;
+}
+
+static const char *openData(SuperpoweredMP3FloatDecoder *decoder, mp3FloatDecoderInternals *internals, const unsigned char *data, size_t bytes) {
+    // Only files beginning with an ID3v2 tag or a layer 3 frame header are scanned, other formats are not read entirely.
+    if ((bytes < 16) || (memcmp(data, "ID3", 3) && ((data[0] != 0xff) || ((data[1] & 0xe6) != 0xe2)))) return "Not an MP3 (layer 3) file.";
+    const char *error = internals->index->buildMemory(data, bytes);
+    if (error) return error;
+    int64_t byteOffset, framePosition;
+    mp3FrameHeader header;
+    if ((internals->index->kind != SuperpoweredDecoder_MP3) || !internals->index->getEntry(0, &byteOffset, &framePosition) || !parseHeader(data + byteOffset, &header)) return "Not an MP3 (layer 3) file.";
+
+    internals->data = data;
+    internals->end = data + bytes;
+    internals->versionTag = header.versionTag;
+    startAt(internals, byteOffset, 0);
+    decoder->samplerate = header.samplerate;
+    decoder->samplesPerFrame = header.lsf ? 576 : 1152;
+    decoder->numChannels = (header.mode == 3) ? 1 : 2;
+    decoder->durationSamples = internals->index->durationSamples;
+    decoder->durationSeconds = (double)decoder->durationSamples / (double)decoder->samplerate;
+    return NULL;
+}
+
+SuperpoweredMP3FloatDecoder::SuperpoweredMP3FloatDecoder() : durationSeconds(0), durationSamples(0), samplePosition(0), samplerate(0), samplesPerFrame(0), numChannels(0) {
+    internals = new mp3FloatDecoderInternals;
+    memset(internals, 0, sizeof(mp3FloatDecoderInternals));
+    internals->index = new SuperpoweredSeekIndex();
+
+    for (int n = 0; n < 8; n++) {
+        float c = mp3AliasCoefficients[n], root = sqrtf(1.0f + c * c);
+        internals->aliasCs[n] = 1.0f / root;
+        internals->aliasCa[n] = c / root;
+    }
+    for (int position = 0; position < 7; position++) { // MPEG-1: tan(position * pi / 12) is the ratio of the channels.
+        double ratio = tan((double)position * M_PI / 12.0);
+        internals->intensity[position][0] = (position == 6) ? 1.0f : (float)(ratio / (1.0 + ratio));
+        internals->intensity[position][1] = (position == 6) ? 0.0f : (float)(1.0 / (1.0 + ratio));
+    }
+    for (int scale = 0; scale < 2; scale++) for (int position = 0; position < 32; position++) { // MPEG-2: odd positions attenuate the left channel, even positions the right.
+        float value = (float)pow(scale ? M_SQRT1_2 : pow(2.0, -0.25), (double)((position + 1) >> 1));
+        internals->intensityLSF[scale][position][0] = (position & 1) ? value : 1.0f;
+        internals->intensityLSF[scale][position][1] = (position & 1) ? 1.0f : value;
+    }
+}
+
+SuperpoweredMP3FloatDecoder::~SuperpoweredMP3FloatDecoder() {
+    closeFile(internals);
+    delete internals->index;
+    delete internals;
+}
+
+const char *SuperpoweredMP3FloatDecoder::open(const char *path) {
+    closeFile(internals);
+    clearProperties(this);
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return "Can't open file.";
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (st.st_size < 16) || ((uint64_t)st.st_size > (size_t)-1)) {
+        close(fd);
+        return "Not an MP3 (layer 3) file.";
+    }
+    size_t mapBytes = (size_t)st.st_size;
+    void *map = mmap(NULL, mapBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return "Can't map file.";
+
+    const char *error = openData(this, internals, (const unsigned char *)map, mapBytes);
+    if (error) {
+        munmap(map, mapBytes);
+        internals->data = internals->end = internals->position = NULL;
+        clearProperties(this);
+        return error;
+    }
+    internals->map = (unsigned char *)map;
+    internals->mapBytes = mapBytes;
+    return NULL;
+}
+
+const char *SuperpoweredMP3FloatDecoder::openMemory(const void *data, size_t bytes) {
+    closeFile(internals);
+    clearProperties(this);
+    const char *error = openData(this, internals, (const unsigned char *)data, bytes);
+    if (error) {
+        internals->data = internals->end = internals->position = NULL;
+        clearProperties(this);
+    }
+    return error;
+}
+
+unsigned char SuperpoweredMP3FloatDecoder::decode(float *output, unsigned int *samples) {
+    if (!internals->data) {
+        *samples = 0;
+        return SUPERPOWEREDDECODER_ERROR;
+    }
+    unsigned int requested = *samples, decoded = 0;
+    do {
+        mp3FrameHeader header;
+        const unsigned char *frame = nextFrame(internals, &header);
+        if (!frame) break;
+        float *frameOutput = output + decoded * 2;
+        decodeFrame(internals, frame, &header, frameOutput, mp3Stage_Synthesis);
+        internals->framePosition += samplesPerFrame;
+
+        unsigned int frameSamples = samplesPerFrame;
+        if (internals->skipSamples) { // The rest of a precise seek.
+            frameSamples -= internals->skipSamples;
+            memmove(frameOutput, frameOutput + internals->skipSamples * 2, frameSamples * 2 * sizeof(float));
+            internals->skipSamples = 0;
+        }
+        decoded += frameSamples;
+    } while (decoded + samplesPerFrame <= requested);
+
+    *samples = decoded;
+    samplePosition += decoded;
+    return decoded ? SUPERPOWEREDDECODER_OK : SUPERPOWEREDDECODER_EOF;
+}
+
+int64_t SuperpoweredMP3FloatDecoder::seekTo(int64_t sample, bool precise) {
+    if (!internals->data) return samplePosition;
+    if (sample < 0) sample = 0;
+    if (sample >= durationSamples) {
+        internals->position = internals->end;
+        internals->framePosition = durationSamples;
+        internals->skipSamples = 0;
+        return samplePosition = durationSamples;
+    }
+
+    // The frame before the position's frame gives the IMDCT overlap and the synthesis history. The frame before that gives the overlap of the frame before (in MPEG-2 a frame is one granule).
+    // SuperpoweredSeekIndex::find() returns with a frame early enough to have the bit reservoir of the frame before the frame it's asked for.
+    int64_t frameStart = sample - sample % samplesPerFrame, byteOffset, framePosition;
+    if (!internals->index->find((frameStart >= samplesPerFrame) ? frameStart - samplesPerFrame : 0, &byteOffset, &framePosition)) return samplePosition;
+    startAt(internals, byteOffset, framePosition);
+
+    while (internals->framePosition < frameStart) {
+        mp3FrameHeader header;
+        const unsigned char *frame = nextFrame(internals, &header);
+        if (!frame) break;
+        int64_t framesBefore = (frameStart - internals->framePosition) / samplesPerFrame;
+        decodeFrame(internals, frame, &header, NULL, (framesBefore > 2) ? mp3Stage_Reservoir : ((framesBefore == 2) ? mp3Stage_Overlap : mp3Stage_Synthesis));
+        internals->framePosition += samplesPerFrame;
+    }
+
+    internals->skipSamples = precise ? (unsigned int)(sample - frameStart) : 0;
+    return samplePosition = precise ? sample : frameStart;
+}
@@ -0,0 +1,82 @@
+#ifndef Header_SuperpoweredMP3FloatDecoder
+#define Header_SuperpoweredMP3FloatDecoder
+
+#include "SuperpoweredDecoder.h"
+#include <stddef.h>
+
+struct mp3FloatDecoderInternals;
+
+/**
+ @brief MP3 (MPEG-1, MPEG-2 and MPEG-2.5 layer 3) decoder with 32-bit floating point output, built on the MP3 stages of SuperpoweredSIMD.h. SuperpoweredFloatDecoder decodes MP3 files with it.
+
+ There is no 16-bit stage: the frequency lines are requantized to floating point, and the synthesis filterbank writes the floating point output directly.
+ The file is memory-mapped, or read from memory without a copy. open() scans the frame headers with SuperpoweredSeekIndex, for the exact duration and for seeking.
+ Seeking is sample exact: decoding starts early enough to have the bit reservoir, the IMDCT overlap and the synthesis history of the position, so the output is the same as decoding from the beginning.
+ Sample positions count from the first audio frame, as in SuperpoweredSeekIndex: the Xing/Info/VBRI frame is skipped, the encoder and decoder delays are not removed (no gapless trimming).
+ The file must begin with an ID3v2 tag or a frame header. Free format streams and layer 1 and 2 are not supported.
+
+ Thread safety: single threaded, not thread safe.
+
+ @param durationSeconds The duration of the current file in seconds. Read only.
+ @param durationSamples The duration of the current file in samples. Read only.
+ @param samplePosition The current position in samples. May change after each decode() or seekTo(). Read only.
+ @param samplerate The sample rate of the current file. Read only.
+ @param samplesPerFrame The samples in one frame: 1152 (MPEG-1) or 576 (MPEG-2 and 2.5). Read only.
+ @param numChannels The number of channels of the current file. The output is always stereo. Read only.
+ */
+class SuperpoweredMP3FloatDecoder {
+public:
+// READ ONLY properties
+    double durationSeconds;
+    int64_t durationSamples, samplePosition;
+    unsigned int samplerate, samplesPerFrame, numChannels;
+
+    SuperpoweredMP3FloatDecoder();
+    ~SuperpoweredMP3FloatDecoder();
+
+    /**
+     @brief Opens an MP3 file. Closes the previous file.
+
+     @return NULL if successful, or an error string.
+
+     @param path Full file system path.
+     */
+    const char *open(const char *path);
+
+    /**
+     @brief Opens an MP3 file in memory, without copying it. Closes the previous file.
+
+     @return NULL if successful, or an error string.
+
+     @param data The file's data. Must stay valid until the next open or the destruction of the decoder.
+     @param bytes The size of the data in bytes.
+     */
+    const char *openMemory(const void *data, size_t bytes);
+
+    /**
+     @brief Decodes whole frames, as many as fit into the requested number of samples, but at least one.
+
+     @return End of file (0), ok (1) or error (2).
+
+     @param output The buffer to put 32-bit floating point interleaved stereo audio. Must be at least this big: (*samples * 8) + 32768 bytes.
+     @param samples On input, the requested number of samples. Should be >= samplesPerFrame. On return, the samples decoded.
+     */
+    unsigned char decode(float *output, unsigned int *samples);
+
+    /**
+     @brief Jumps to a specific position.
+
+     @return The new position.
+
+     @param sample The position (a sample index).
+     @param precise If false, the new position is the beginning of the frame of the position. If true, the new position is exactly the requested one.
+     */
+    int64_t seekTo(int64_t sample, bool precise);
+
+private:
+    mp3FloatDecoderInternals *internals;
+    SuperpoweredMP3FloatDecoder(const SuperpoweredMP3FloatDecoder&);
+    SuperpoweredMP3FloatDecoder& operator=(const SuperpoweredMP3FloatDecoder&);
+};
+
+#endif
@@ -0,0 +1,240 @@
+#include "SuperpoweredMappedAudioSource.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// One mapped file, shared by the source and the items pointing into it.
+typedef struct mappedFile {
+    SuperpoweredAudiobufferOwner owner; // clientData points to this.
+    unsigned char *map, *data;
+    size_t mapBytes, advisedFrom, advisedUntil; // The readahead hints cover these data offsets.
+    int64_t dataBytes;
+    int retainCount;
+    bool mapped; // False for memory of the caller (openMemory).
+} mappedFile;
+
+static void fileRetain(void *clientData, void *) {
+    __atomic_add_fetch(&((mappedFile *)clientData)->retainCount, 1, __ATOMIC_RELAXED);
+}
+
+static void fileRelease(void *clientData, void *) {
+    mappedFile *file = (mappedFile *)clientData;
+    if (__atomic_sub_fetch(&file->retainCount, 1, __ATOMIC_ACQ_REL) != 0) return;
+    if (file->mapped) munmap(file->map, file->mapBytes);
+    free(file);
+}
+
+static inline unsigned int readLE16(const unsigned char *p) { return p[0] | (p[1] << 8); }
+static inline unsigned int readLE32(const unsigned char *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24); }
+static inline unsigned int readBE16(const unsigned char *p) { return (p[0] << 8) | p[1]; }
+static inline unsigned int readBE32(const unsigned char *p) { return ((unsigned int)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3]; }
+
+// 80-bit IEEE 754 extended precision, the sample rate in AIFF files.
+static double readExtended(const unsigned char *p) {
+    int exponent = ((p[0] & 0x7f) << 8) | p[1];
+    uint64_t mantissa = 0;
+    for (int n = 2; n < 10; n++) mantissa = (mantissa << 8) | p[n];
+    double value = ldexp((double)mantissa, exponent - 16383 - 63);
+    return (p[0] & 0x80) ? -value : value;
+}
+
+// Walks the chunks of a WAV file. Returns with an error string or NULL.
+static const char *parseWAV(SuperpoweredMappedAudioSource *source, mappedFile *file) {
+    const unsigned char *p = file->map + 12, *end = file->map + file->mapBytes;
+    bool hasFormat = false;
+    unsigned int formatTag = 0, blockAlign = 0;
+
+    while (p + 8 <= end) {
+        unsigned int chunkBytes = readLE32(p + 4);
+        const unsigned char *chunk = p + 8;
+
+        if (!memcmp(p, "fmt ", 4) && (chunkBytes >= 16) && (chunk + 16 <= end)) {
+            formatTag = readLE16(chunk);
+            source->numChannels = readLE16(chunk + 2);
+            source->samplerate = readLE32(chunk + 4);
+            blockAlign = readLE16(chunk + 12);
+            source->bitsPerSample = readLE16(chunk + 14);
+            if ((formatTag == 0xfffe) && (chunkBytes >= 26) && (chunk + 26 <= end)) formatTag = readLE16(chunk + 24); // Extensible: the sub format.
+            hasFormat = true;
+        } else if (!memcmp(p, "data", 4)) {
+            if (!hasFormat) return "WAV data before format.";
+            file->data = (unsigned char *)chunk;
+            file->dataBytes = (int64_t)(end - chunk);
+            if ((chunkBytes != 0) && (chunkBytes != 0xffffffff) && (chunkBytes < file->dataBytes)) file->dataBytes = chunkBytes; // 0 or -1: still being written.
+            break;
+        }
+        p = chunk + chunkBytes + (chunkBytes & 1);
+        if (p < chunk) break; // Overflow.
+    }
+
+    if (!hasFormat || !file->data) return "Not a valid WAV file.";
+    if ((formatTag != 1) && (formatTag != 3)) return "Compressed WAV files are not supported.";
+    source->isFloat = (formatTag == 3);
+    source->bigEndian = false;
+    source->bytesPerSample = blockAlign ? blockAlign : source->numChannels * ((source->bitsPerSample + 7) / 8);
+    source->kind = SuperpoweredDecoder_WAV;
+    return NULL;
+}
+
+// Walks the chunks of an AIFF or AIFC file. Returns with an error string or NULL.
+static const char *parseAIFF(SuperpoweredMappedAudioSource *source, mappedFile *file, bool aifc) {
+    const unsigned char *p = file->map + 12, *end = file->map + file->mapBytes;
+    bool hasFormat = false;
+
+    source->bigEndian = true;
+    source->isFloat = false;
+    while (p + 8 <= end) {
+        unsigned int chunkBytes = readBE32(p + 4);
+        const unsigned char *chunk = p + 8;
+
+        if (!memcmp(p, "COMM", 4) && (chunkBytes >= 18) && (chunk + 18 <= end)) {
+            source->numChannels = readBE16(chunk);
+            source->bitsPerSample = readBE16(chunk + 6);
+            source->samplerate = (unsigned int)(readExtended(chunk + 8) + 0.5);
+            if (aifc && (chunkBytes >= 22) && (chunk + 22 <= end)) {
+                const unsigned char *compression = chunk + 18;
+                if (!memcmp(compression, "sowt", 4)) source->bigEndian = false;
+                else if (!memcmp(compression, "fl32", 4) || !memcmp(compression, "FL32", 4)) source->isFloat = true;
+                else if (memcmp(compression, "NONE", 4)) return "Compressed AIFF files are not supported.";
+            }
+            hasFormat = true;
+        } else if (!memcmp(p, "SSND", 4) && (chunk + 8 <= end)) {
+            unsigned int offset = readBE32(chunk);
+            if ((chunkBytes < 8 + offset) || (chunk + 8 + offset > end)) return "Not a valid AIFF file.";
+            file->data = (unsigned char *)chunk + 8 + offset;
+            file->dataBytes = (int64_t)(end - file->data);
+            if (chunkBytes - 8 - offset < file->dataBytes) file->dataBytes = chunkBytes - 8 - offset;
+        }
+        p = chunk + chunkBytes + (chunkBytes & 1);
+        if (p < chunk) break; // Overflow.
+    }
+
+    if (!hasFormat || !file->data) return "Not a valid AIFF file.";
+    source->bytesPerSample = source->numChannels * ((source->bitsPerSample + 7) / 8);
+    source->kind = SuperpoweredDecoder_AIFF;
+    return NULL;
+}
+
+// Asks the system to read ahead of the bytes about to be used, when less than half of the readahead is left.
+static void readahead(mappedFile *file, size_t fromByte, size_t toByte, unsigned int readaheadBytes) {
+    if (!file->mapped) return;
+    if ((fromByte < file->advisedFrom) || (fromByte > file->advisedUntil)) file->advisedFrom = file->advisedUntil = fromByte; // Seek, start again from here.
+    else if (toByte + readaheadBytes / 2 <= file->advisedUntil) return;
+
+    size_t until = toByte + readaheadBytes;
+    if (until > (size_t)file->dataBytes) until = (size_t)file->dataBytes;
+    if (until <= file->advisedUntil) return;
+    uintptr_t from = ((uintptr_t)(file->data + file->advisedUntil)) & ~(uintptr_t)(sysconf(_SC_PAGESIZE) - 1);
+    madvise((void *)from, (size_t)((uintptr_t)(file->data + until) - from), MADV_WILLNEED);
+    file->advisedUntil = until;
+}
+
+SuperpoweredMappedAudioSource::SuperpoweredMappedAudioSource(unsigned int readaheadBytes) : durationSamples(0), samplePosition(0), samplerate(0), numChannels(0), bitsPerSample(0), bytesPerSample(0), isFloat(false), bigEndian(false), kind(SuperpoweredDecoder_WAV), file(NULL), readaheadBytes(readaheadBytes) {
+}
+
+SuperpoweredMappedAudioSource::~SuperpoweredMappedAudioSource() {
+    if (file) fileRelease(file, NULL);
+}
+
+// Takes a mapping or memory, and parses the headers.
+static const char *openData(SuperpoweredMappedAudioSource *source, mappedFile **fileOut, unsigned char *map, size_t mapBytes, bool mapped) {
+    mappedFile *newFile = (mappedFile *)malloc(sizeof(mappedFile));
+    if (!newFile) {
+        if (mapped) munmap(map, mapBytes);
+        return "Out of memory.";
+    }
+    memset(newFile, 0, sizeof(mappedFile));
+    newFile->map = map;
+    newFile->mapBytes = mapBytes;
+    newFile->mapped = mapped;
+    newFile->retainCount = 1; // The source's reference.
+    newFile->owner.retain = fileRetain;
+    newFile->owner.release = fileRelease;
+    newFile->owner.clientData = newFile;
+
+    const char *error;
+    if (!memcmp(newFile->map, "RIFF", 4) && !memcmp(newFile->map + 8, "WAVE", 4)) error = parseWAV(source, newFile);
+    else if (!memcmp(newFile->map, "FORM", 4) && (!memcmp(newFile->map + 8, "AIFF", 4) || !memcmp(newFile->map + 8, "AIFC", 4))) error = parseAIFF(source, newFile, newFile->map[11] == 'C');
+    else error = "Not a WAV or AIFF file.";
+    if (!error && (!source->numChannels || !source->bitsPerSample || !source->bytesPerSample || !source->samplerate)) error = "Invalid audio format.";
+    if (error) {
+        fileRelease(newFile, NULL);
+        return error;
+    }
+
+    if (mapped) madvise(newFile->map, newFile->mapBytes, MADV_SEQUENTIAL);
+    *fileOut = newFile;
+    return NULL;
+}
+
+static void closeData(SuperpoweredMappedAudioSource *source, mappedFile **file) {
+    if (*file) {
+        fileRelease(*file, NULL);
+        *file = NULL;
+    }
+    source->durationSamples = source->samplePosition = 0;
+}
+
+const char *SuperpoweredMappedAudioSource::open(const char *path) {
+    closeData(this, &file);
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return "Can not open the file.";
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (st.st_size < 12) || ((uint64_t)st.st_size > (size_t)-1)) {
+        close(fd);
+        return "Invalid file size.";
+    }
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping keeps the file open.
+    if (map == MAP_FAILED) return "Can not map the file.";
+
+    const char *error = openData(this, &file, (unsigned char *)map, (size_t)st.st_size, true);
+    if (!error) durationSamples = file->dataBytes / bytesPerSample;
+    return error;
+}
+
+const char *SuperpoweredMappedAudioSource::openMemory(const void *data, size_t bytes) {
+    closeData(this, &file);
+    if (!data || (bytes < 12)) return "Invalid data size.";
+    const char *error = openData(this, &file, (unsigned char *)data, bytes, false);
+    if (!error) durationSamples = file->dataBytes / bytesPerSample;
+    return error;
+}
+
+bool SuperpoweredMappedAudioSource::getElement(int64_t fromSample, int numSamples, SuperpoweredAudiobufferlistElement *element) {
+    if (!file || (fromSample < 0) || (fromSample >= durationSamples) || (numSamples < 1)) return false;
+    if (fromSample + numSamples > durationSamples) numSamples = (int)(durationSamples - fromSample);
+
+    size_t fromByte = (size_t)fromSample * bytesPerSample;
+    readahead(file, fromByte, fromByte + (size_t)numSamples * bytesPerSample, readaheadBytes);
+    fileRetain(file, NULL);
+
+    element->buffers[0] = file->data + fromByte;
+    element->buffers[1] = element->buffers[2] = element->buffers[3] = NULL;
+    element->samplePosition = fromSample;
+    element->startSample = 0;
+    element->endSample = numSamples;
+    element->samplesUsed = (float)numSamples;
+    return true;
+}
+
+int SuperpoweredMappedAudioSource::append(SuperpoweredAudiobufferChain *chain, int numSamples) {
+    SuperpoweredAudiobufferlistElement element;
+    if (!getElement(samplePosition, numSamples, &element)) return 0;
+    chain->append(&element, &file->owner);
+    samplePosition += element.endSample;
+    return element.endSample;
+}
+
+void SuperpoweredMappedAudioSource::seekTo(int64_t sample) {
+    samplePosition = (sample < 0) ? 0 : ((sample > durationSamples) ? durationSamples : sample);
+}
+
+const SuperpoweredAudiobufferOwner *SuperpoweredMappedAudioSource::getOwner() {
+    return file ? &file->owner : NULL;
+}
@@ -0,0 +1,103 @@
+#ifndef Header_SuperpoweredMappedAudioSource
+#define Header_SuperpoweredMappedAudioSource
+
+#include "SuperpoweredAudioBufferChain.h"
+#include "SuperpoweredDecoder.h"
+
+struct mappedFile;
+
+/**
+ @brief Uncompressed WAV and AIFF source, memory-mapping the file instead of decoding it.
+
+ The audio is exposed as list items pointing directly into the mapped file, in the file's own format (no conversion, no copy). Opening is O(1) in the file size: only the chunk headers are read, the pages are loaded by the system when the audio is accessed, with readahead hints (madvise) ahead of the read position.
+ The items are retained and released like pool buffers, by the owner of the source. The mapping stays alive while any item or the source itself exists, so items can outlive the source.
+
+ Supported files: WAV (PCM, IEEE float, extensible) and AIFF/AIFC (NONE, sowt, fl32), any number of channels and bit depth.
+ The file is mapped entirely, so files bigger than about 1 GB may not open in a 32-bit process.
+
+ Thread safety: single threaded, not thread safe. The items can be used and released on any thread.
+
+ @param durationSamples The duration of the file in samples. Read only.
+ @param samplePosition The read position of append(), in samples. Read only.
+ @param samplerate The sample rate of the file. Read only.
+ @param numChannels The number of channels. Read only.
+ @param bitsPerSample The bits of one sample of one channel. Read only.
+ @param bytesPerSample The size of one sample with all channels (the bytesPerSample of a SuperpoweredAudiobufferChain fed by this source). Read only.
+ @param isFloat True for IEEE float samples. Read only.
+ @param bigEndian True if the samples are big-endian (AIFF). Read only.
+ @param kind SuperpoweredDecoder_WAV or SuperpoweredDecoder_AIFF. Read only.
+ */
+class SuperpoweredMappedAudioSource {
+public:
+// READ ONLY properties
+    int64_t durationSamples, samplePosition;
+    unsigned int samplerate, numChannels, bitsPerSample, bytesPerSample;
+    bool isFloat, bigEndian;
+    SuperpoweredDecoder_Kind kind;
+
+    /**
+     @param readaheadBytes The system is asked to read this many bytes ahead of the read position.
+     */
+    SuperpoweredMappedAudioSource(unsigned int readaheadBytes = 4 * 1024 * 1024);
+    ~SuperpoweredMappedAudioSource();
+
+    /**
+     @brief Opens a file. Closes the previous file, the items of the previous file stay valid.
+
+     @return NULL if successful, or an error string.
+
+     @param path Full file system path.
+     */
+    const char *open(const char *path);
+
+    /**
+     @brief Opens a WAV or AIFF file in memory, without copying it. Closes the previous file, the items of the previous file stay valid.
+
+     @return NULL if successful, or an error string.
+
+     @param data The file's data. Must stay valid as long as the source or any of its items exist.
+     @param bytes The size of the data in bytes.
+     */
+    const char *openMemory(const void *data, size_t bytes);
+
+    /**
+     @brief Appends audio from the read position to a chain, and moves the read position.
+
+     @return The number of samples appended, 0 at the end of the file.
+
+     @param chain The chain, created with this source's bytesPerSample. The item's buffers[0] points into the mapped file.
+     @param numSamples The number of samples to append.
+     */
+    int append(SuperpoweredAudiobufferChain *chain, int numSamples);
+
+    /**
+     @brief Returns with a list item pointing into the mapped file, retained once. Doesn't move the read position.
+
+     @return False if the range is outside of the file.
+
+     @param fromSample The first sample.
+     @param numSamples The number of samples, limited to the end of the file.
+     @param element Output. Release buffers[0] with the retain/release functions of getOwner().
+     */
+    bool getElement(int64_t fromSample, int numSamples, SuperpoweredAudiobufferlistElement *element);
+
+    /**
+     @brief Sets the read position.
+
+     @param sample The new read position in samples.
+     */
+    void seekTo(int64_t sample);
+
+    /**
+     @return The owner of the items of the current file, NULL if no file is open. Valid as long as items of the file exist.
+     */
+    const SuperpoweredAudiobufferOwner *getOwner();
+
+private:
+    mappedFile *file;
+    unsigned int readaheadBytes;
+    SuperpoweredMappedAudioSource(const SuperpoweredMappedAudioSource&);
+    SuperpoweredMappedAudioSource& operator=(const SuperpoweredMappedAudioSource&);
+};
+
+#endif
@@ -0,0 +1,162 @@
+#include "SuperpoweredParallelDecoder.h"
+#include "SuperpoweredSIMD.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#define JOBSPERTHREAD 4 // More jobs than threads, so a slow range doesn't leave the other threads waiting at the end.
+#define DECODESAMPLES 4096
+
+typedef struct rangeJob {
+    int64_t startSample, endSample, byteOffset, byteLength; // The range to output, and the bytes to decode (with warm-up).
+    int64_t decodeStartSample; // The position of the first decoded frame.
+    float *output;
+} rangeJob;
+
+typedef struct parallelJobs {
+    const char *path;
+    rangeJob *jobs;
+    unsigned int numJobs, nextJob;
+    const char *error;
+} parallelJobs;
+
+static const char *decodeRange(const char *path, rangeJob *job, short int *pcm) {
+    SuperpoweredDecoder decoder;
+    const char *error = decoder.open(path, false, (int)job->byteOffset, (int)job->byteLength);
+    if (error) return error;
+
+    int64_t position = job->decodeStartSample;
+    while (position < job->endSample) {
+        unsigned int samples = DECODESAMPLES;
+        if ((decoder.decode(pcm, &samples) != SUPERPOWEREDDECODER_OK) || !samples) break;
+
+        int64_t from = (position > job->startSample) ? position : job->startSample, to = position + samples; // Drop the warm-up.
+        if (to > job->endSample) to = job->endSample;
+        if (to > from) SuperpoweredSIMDShortIntToFloat(pcm + (from - position) * 2, job->output + (from - job->startSample) * 2, (unsigned int)(to - from));
+        position += samples;
+    }
+    return (position < job->endSample) ? "The decoder returned less samples than the frames in a range." : NULL;
+}
+
+static void *worker(void *param) {
+    parallelJobs *jobs = (parallelJobs *)param;
+    short int *pcm = (short int *)malloc(DECODESAMPLES * 4 + 16384);
+    if (!pcm) {
+        const char *error = "Out of memory.";
+        __atomic_store_n(&jobs->error, error, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    while (!__atomic_load_n(&jobs->error, __ATOMIC_RELAXED)) {
+        unsigned int job = __atomic_fetch_add(&jobs->nextJob, 1, __ATOMIC_RELAXED);
+        if (job >= jobs->numJobs) break;
+        const char *error = decodeRange(jobs->path, &jobs->jobs[job], pcm);
+        if (error) __atomic_store_n(&jobs->error, error, __ATOMIC_RELAXED);
+    }
+    free(pcm);
+    return NULL;
+}
+
+// Splits the file into ranges at index entries.
+static const char *makeJobs(SuperpoweredSeekIndex *index, unsigned int numThreads, rangeJob **jobsOut, unsigned int *numJobsOut) {
+    if (!index->numEntries || ((index->kind != SuperpoweredDecoder_MP3) && (index->kind != SuperpoweredDecoder_AAC))) return "No index.";
+    if (index->fileBytes > INT_MAX) return "The file is too big.";
+
+    unsigned int numJobs = numThreads * JOBSPERTHREAD;
+    if (numJobs > index->numEntries) numJobs = index->numEntries;
+    rangeJob *jobs = (rangeJob *)malloc(numJobs * sizeof(rangeJob));
+    if (!jobs) return "Out of memory.";
+
+    for (unsigned int n = 0; n < numJobs; n++) {
+        rangeJob *job = &jobs[n];
+        int64_t startOffset, endOffset;
+        index->getEntry((unsigned int)((uint64_t)index->numEntries * n / numJobs), &startOffset, &job->startSample);
+        if (n == numJobs - 1) { // Till the end of the file, including any tag after the last frame.
+            endOffset = index->fileBytes;
+            job->endSample = index->durationSamples;
+        } else index->getEntry((unsigned int)((uint64_t)index->numEntries * (n + 1) / numJobs), &endOffset, &job->endSample);
+
+        index->find(job->startSample, &job->byteOffset, &job->decodeStartSample);
+        job->byteLength = endOffset - job->byteOffset;
+        job->output = NULL;
+    }
+
+    *jobsOut = jobs;
+    *numJobsOut = numJobs;
+    return NULL;
+}
+
+static const char *runJobs(const char *path, rangeJob *jobs, unsigned int numJobs, unsigned int numThreads) {
+    parallelJobs shared;
+    shared.path = path;
+    shared.jobs = jobs;
+    shared.numJobs = numJobs;
+    shared.nextJob = 0;
+    shared.error = NULL;
+
+    if (numThreads > numJobs) numThreads = numJobs;
+    pthread_t *threads = (pthread_t *)malloc(numThreads * sizeof(pthread_t));
+    if (!threads) return "Out of memory.";
+    unsigned int numStarted = 0;
+    while ((numStarted < numThreads - 1) && !pthread_create(&threads[numStarted], NULL, worker, &shared)) numStarted++;
+    worker(&shared); // The calling thread works too.
+    for (unsigned int n = 0; n < numStarted; n++) pthread_join(threads[n], NULL);
+    free(threads);
+    return shared.error;
+}
+
+static unsigned int threadCount(unsigned int numThreads) {
+    if (numThreads) return numThreads;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return (cores > 0) ? (unsigned int)cores : 1;
+}
+
+const char *SuperpoweredParallelDecoder::decode(const char *path, SuperpoweredSeekIndex *index, float *output, unsigned int numThreads) {
+    numThreads = threadCount(numThreads);
+    rangeJob *jobs;
+    unsigned int numJobs;
+    const char *error = makeJobs(index, numThreads, &jobs, &numJobs);
+    if (error) return error;
+
+    for (unsigned int n = 0; n < numJobs; n++) jobs[n].output = output + jobs[n].startSample * 2;
+    error = runJobs(path, jobs, numJobs, numThreads);
+    free(jobs);
+    return error;
+}
+
+const char *SuperpoweredParallelDecoder::decode(const char *path, SuperpoweredSeekIndex *index, SuperpoweredAudiopointerList *list, unsigned int numThreads) {
+    numThreads = threadCount(numThreads);
+    rangeJob *jobs;
+    unsigned int numJobs;
+    const char *error = makeJobs(index, numThreads, &jobs, &numJobs);
+    if (error) return error;
+
+    for (unsigned int n = 0; n < numJobs; n++) { // allocBuffer can not be called concurrently, the buffers are allocated here.
+        int64_t bytes = (jobs[n].endSample - jobs[n].startSample) * 8;
+        jobs[n].output = (bytes <= UINT_MAX) ? (float *)SuperpoweredAudiobufferPool::allocBuffer((unsigned int)bytes) : NULL;
+        if (!jobs[n].output) {
+            error = "Out of memory.";
+            break;
+        }
+    }
+    if (!error) error = runJobs(path, jobs, numJobs, numThreads);
+
+    for (unsigned int n = 0; n < numJobs; n++) {
+        if (!jobs[n].output) break;
+        if (error) {
+            SuperpoweredAudiobufferPool::releaseBuffer(jobs[n].output);
+            continue;
+        }
+        SuperpoweredAudiobufferlistElement element;
+        memset(&element, 0, sizeof(element));
+        element.buffers[0] = jobs[n].output;
+        element.samplePosition = jobs[n].startSample;
+        element.endSample = (int)(jobs[n].endSample - jobs[n].startSample);
+        element.samplesUsed = (float)element.endSample;
+        list->append(&element);
+    }
+    free(jobs);
+    return error;
+}
@@ -0,0 +1,42 @@
+#ifndef Header_SuperpoweredParallelDecoder
+#define Header_SuperpoweredParallelDecoder
+
+#include "SuperpoweredSeekIndex.h"
+#include "SuperpoweredAudioBuffers.h"
+
+/**
+ @brief Decodes entire MP3 or ADTS AAC files on multiple threads, for offline processing (analysis, import).
+
+ The file is split into frame ranges at the entries of a SuperpoweredSeekIndex. Each range is decoded by its own SuperpoweredDecoder on a worker thread. A worker starts decoding at the frame that SuperpoweredSeekIndex::find() returns, so the bit reservoir and overlap are warmed up, then drops the warm-up samples. Every range is written to its own place in the output, so the result is the same as decoding on one thread.
+
+ Sample positions are the positions of the index: the first audio frame is sample 0, there is no encoder delay (gapless) trimming.
+ Returns with an error if the decoder returns less samples for a range than the frames in it.
+ */
+class SuperpoweredParallelDecoder {
+public:
+    /**
+     @brief Decodes a file into a buffer. Blocks until finished.
+
+     @return NULL if successful, or an error string.
+
+     @param path Full file system path.
+     @param index The index of the file, built or loaded already.
+     @param output 32-bit floating point interleaved stereo output. Must be at least index->durationSamples * 8 bytes big.
+     @param numThreads The number of worker threads. 0 means the number of CPU cores.
+     */
+    static const char *decode(const char *path, SuperpoweredSeekIndex *index, float *output, unsigned int numThreads = 0);
+
+    /**
+     @brief Decodes a file and appends it to a list, one item per range. Blocks until finished.
+
+     @return NULL if successful, or an error string. Nothing is appended on error.
+
+     @param path Full file system path.
+     @param index The index of the file, built or loaded already.
+     @param list The list, created for 32-bit floating point stereo audio (8 bytes per sample). The buffers are allocated by SuperpoweredAudiobufferPool::allocBuffer(), don't call it on other threads meanwhile.
+     @param numThreads The number of worker threads. 0 means the number of CPU cores.
+     */
+    static const char *decode(const char *path, SuperpoweredSeekIndex *index, SuperpoweredAudiopointerList *list, unsigned int numThreads = 0);
+};
+
+#endif
@@ -0,0 +1,1109 @@
+#include "SuperpoweredSIMD.h"
+#include "SuperpoweredSimple.h"
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+
+#if defined(__i386__) || defined(__x86_64__)
+#define SUPERPOWEREDSIMD_X86
+#include <immintrin.h>
+#include <cpuid.h>
+#endif
+
+// The minimum tile of SuperpoweredSIMDAddN in vectors. Large enough to hide the per-input setup, small enough to keep the sums in registers.
+#define SUPERPOWEREDSIMD_ADDNTILE 8
+
+// The true peak filter reads back this many samples.
+#define SUPERPOWEREDSIMD_METERHISTORY (SUPERPOWEREDSIMD_TRUEPEAKTAPS - 1)
+
+// One code path: a function for every kernel.
+typedef struct simdKernels {
+    void (*volume)(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfSamples);
+    void (*changeVolume)(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfSamples);
+    void (*volumeAdd)(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfSamples);
+    void (*changeVolumeAdd)(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfSamples);
+    float (*peak)(float *input, unsigned int numberOfValues);
+    void (*shortIntToFloatPeaks)(short int *input, float *output, unsigned int numberOfSamples, float *peaks);
+    void (*shortIntToFloat)(short int *input, float *output, unsigned int numberOfSamples, unsigned int numChannels);
+    void (*floatToShortInt)(float *input, short int *output, unsigned int numberOfSamples, unsigned int numChannels);
+    void (*interleave)(float *left, float *right, float *output, unsigned int numberOfSamples);
+    void (*interleaveAdd)(float *left, float *right, float *output, unsigned int numberOfSamples);
+    void (*deInterleave)(float *input, float *left, float *right, unsigned int numberOfSamples);
+    void (*deInterleaveAdd)(float *input, float *left, float *right, unsigned int numberOfSamples);
+    bool (*hasNonFinite)(float *buffer, unsigned int numberOfValues);
+    void (*add1)(float *input, float *output, unsigned int numberOfValues);
+    void (*add2)(float *inputA, float *inputB, float *output, unsigned int numberOfValues);
+    void (*add4)(float *inputA, float *inputB, float *inputC, float *inputD, float *output, unsigned int numberOfValues);
+    void (*rampInterleaved)(float *input, float *output, const float *volumeStart, const float *volumeEnd, const float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels, bool add);
+    void (*rampPlanar)(float **inputs, float **outputs, const float *volumeStart, const float *volumeEnd, const float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels, bool add);
+    void (*interleaveN)(float **inputs, float *output, unsigned int numberOfSamples, unsigned int numChannels);
+    void (*deInterleaveN)(float *input, float **outputs, unsigned int numberOfSamples, unsigned int numChannels);
+    void (*convertVolumeMeter)(const void *input, int inputFormat, void *output, int outputFormat, const float *volumeStart, const float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels, float *peaks, float *sums);
+    void (*addN)(float **inputs, const float *gainsStart, const float *gainsEnd, float *output, unsigned int numberOfSamples, unsigned int numChannels, unsigned int numInputs);
+    void (*meter)(SuperpoweredSIMDMeterState *state, const float *input, unsigned int numberOfSamples, float *peaks, float *squares, float *truePeaks, float *loudness);
+    unsigned int (*scrub)(float *buffer, unsigned int numberOfValues, unsigned int numChannels, bool hold, unsigned int *firstIndex);
+    void (*floatToHalf)(const float *input, unsigned short int *output, unsigned int numberOfValues);
+    void (*halfToFloat)(const unsigned short int *input, float *output, unsigned int numberOfValues);
+    void (*mp3Dequantize)(const int *input, float *output, unsigned int numberOfValues, float multiplier);
+    void (*mp3IMDCT)(SuperpoweredSIMDMP3State *state, unsigned int channel, const float *input, float *output, int blockType, bool mixedBlock);
+    void (*mp3Synthesis)(SuperpoweredSIMDMP3State *state, unsigned int channel, const float *input, float *output, unsigned int numberOfSlots);
+} simdKernels;
+
+// The gain change per sample of a channel. volumeEnd or volumeChange is NULL, both NULL means constant volume.
+static inline float rampStep(const float *volumeStart, const float *volumeEnd, const float *volumeChange, unsigned int channel, unsigned int numberOfSamples) {
+    if (volumeChange) return volumeChange[channel];
+    if (!volumeEnd) return 0;
+    return numberOfSamples ? (volumeEnd[channel] - volumeStart[channel]) / (float)numberOfSamples : 0;
+}
+
+// Sample formats: int to float scale, float to int multiplier and clipping range.
+// Floating point formats are not clipped.
+static const float formatScale[6] = { 1.0f / 128.0f, 1.0f / 32768.0f, 1.0f / 8388608.0f, 1.0f / 2147483648.0f, 1.0f, 1.0f };
+static const float formatMultiplier[6] = { 127.0f, 32767.0f, 8388607.0f, 2147483647.0f, 1.0f, 1.0f };
+static const float formatLow[6] = { -128.0f, -32768.0f, -8388608.0f, -2147483648.0f, 0, 0 };
+static const float formatHigh[6] = { 127.0f, 32767.0f, 8388607.0f, 2147483520.0f, 0, 0 }; // The largest float below 2^31.
+
+// 24-bit audio is packed, 3 bytes little endian.
+static inline int read24(const void *input, unsigned int index) {
+    const unsigned char *bytes = (const unsigned char *)input + index * 3;
+    return (int)(((unsigned int)bytes[0] << 8) | ((unsigned int)bytes[1] << 16) | ((unsigned int)bytes[2] << 24)) >> 8;
+}
+
+static inline void write24(void *output, unsigned int index, int value) {
+    unsigned char *bytes = (unsigned char *)output + index * 3;
+    bytes[0] = (unsigned char)value;
+    bytes[1] = (unsigned char)(value >> 8);
+    bytes[2] = (unsigned char)(value >> 16);
+}
+
+// IEEE half precision with round to nearest even, the same as F16C. Overflow becomes infinity, NaN becomes a quiet NaN.
+// The bit tricks are from Fabian Giesen's public domain half conversion code, the SSE2 code path does the same with vectors.
+static inline unsigned short int floatToHalf(float value) {
+    unsigned int bits, sign, result;
+    memcpy(&bits, &value, sizeof(bits));
+    sign = bits & 0x80000000;
+    bits ^= sign;
+
+    if (bits >= 0x47800000) result = (bits > 0x7f800000) ? 0x7e00 : 0x7c00; // 65536 and above: infinity or NaN.
+    else if (bits < 0x38800000) { // Below 2^-14: denormal or zero. Adding 0.5 rounds the value to a multiple of 2^-24 in the low bits.
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        f += 0.5f;
+        memcpy(&result, &f, sizeof(result));
+        result -= 0x3f000000;
+    } else result = (bits + 0xc8000fff + ((bits >> 13) & 1)) >> 13; // Rebias the exponent, round the mantissa to nearest even.
+
+    return (unsigned short int)(result | (sign >> 16));
+}
+
+static inline float halfToFloat(unsigned short int half) {
+    unsigned int bits = ((unsigned int)half & 0x7fff) << 13, exponent = bits & 0x0f800000;
+    bits += 0x38000000; // Rebias the exponent.
+    if (exponent == 0x0f800000) bits += 0x38000000; // Infinity or NaN.
+    else if (!exponent) { // Denormal or zero: renormalize.
+        float f;
+        bits += 0x00800000;
+        memcpy(&f, &bits, sizeof(f));
+        f -= 6.103515625e-05f; // 2^-14
+        memcpy(&bits, &f, sizeof(bits));
+    }
+    bits |= ((unsigned int)half & 0x8000) << 16;
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+// Returns with the raw value, not scaled.
+static inline float loadSample(const void *input, unsigned int index, int format) {
+    switch (format) {
+        case SuperpoweredSIMDFormat_Int8: return (float)((const signed char *)input)[index];
+        case SuperpoweredSIMDFormat_Int16: return (float)((const short int *)input)[index];
+        case SuperpoweredSIMDFormat_Int24: return (float)read24(input, index);
+        case SuperpoweredSIMDFormat_Int32: return (float)((const int *)input)[index];
+        case SuperpoweredSIMDFormat_Float16: return halfToFloat(((const unsigned short int *)input)[index]);
+        default: return ((const float *)input)[index];
+    }
+}
+
+// The value must be scaled and clipped already.
+static inline void storeSample(void *output, unsigned int index, int format, float value) {
+    switch (format) {
+        case SuperpoweredSIMDFormat_Int8: ((signed char *)output)[index] = (signed char)lrintf(value); break;
+        case SuperpoweredSIMDFormat_Int16: ((short int *)output)[index] = (short int)lrintf(value); break;
+        case SuperpoweredSIMDFormat_Int24: write24(output, index, (int)lrintf(value)); break;
+        case SuperpoweredSIMDFormat_Int32: ((int *)output)[index] = (int)lrintf(value); break;
+        case SuperpoweredSIMDFormat_Float16: ((unsigned short int *)output)[index] = floatToHalf(value); break;
+        default: ((float *)output)[index] = value;
+    }
+}
+
+// Converts with volume from fromFrame, and adds to the maximum and the sum of squares of every channel (if not NULL).
+static inline void convertVolumeMeterScalar(const void *input, int inputFormat, void *output, int outputFormat, const float *volumeStart, const float *volumeEnd, unsigned int fromFrame, unsigned int numberOfSamples, unsigned int numChannels, float *peaks, float *sums) {
+    float scale = formatScale[inputFormat], multiplier = formatMultiplier[outputFormat], low = formatLow[outputFormat], high = formatHigh[outputFormat];
+    bool clip = (outputFormat < SuperpoweredSIMDFormat_Float32);
+
+    for (unsigned int channel = 0; channel < numChannels; channel++) {
+        float gain = volumeStart ? volumeStart[channel] : 1.0f, step = volumeStart ? rampStep(volumeStart, volumeEnd, NULL, channel, numberOfSamples) : 0;
+        for (unsigned int frame = fromFrame, index = fromFrame * numChannels + channel; frame < numberOfSamples; frame++, index += numChannels) {
+            float value = loadSample(input, index, inputFormat) * scale * (gain + step * (float)frame);
+            if (peaks && (fabsf(value) > peaks[channel])) peaks[channel] = fabsf(value);
+            if (sums) sums[channel] += value * value;
+            if (clip) {
+                value *= multiplier;
+                if (value > high) value = high; else if (value < low) value = low;
+            }
+            storeSample(output, index, outputFormat, value);
+        }
+    }
+}
+
+// Adds the inputs with gain to the output, between fromFrame and toFrame. One input at a time, so keep the range small.
+static inline void addNScalar(float **inputs, const float *gainsStart, const float *gainsEnd, float *output, unsigned int fromFrame, unsigned int toFrame, unsigned int numberOfSamples, unsigned int numChannels, unsigned int numInputs) {
+    for (unsigned int i = 0; i < numInputs; i++) {
+        const float *input = inputs[i];
+        float gain = gainsStart ? gainsStart[i] : 1.0f, step = gainsStart ? rampStep(gainsStart, gainsEnd, NULL, i, numberOfSamples) : 0;
+        for (unsigned int frame = fromFrame, index = fromFrame * numChannels; frame < toFrame; frame++) {
+            float g = gain + step * (float)frame;
+            for (unsigned int channel = 0; channel < numChannels; channel++, index++) output[index] += input[index] * g;
+        }
+    }
+}
+
+// ITU-R BS.1770-4 Annex 2, the 4 phases of the 4x oversampling filter.
+static const float truePeakCoefficients[4][SUPERPOWEREDSIMD_TRUEPEAKTAPS] = {
+    { 0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f, -0.0594482421875f, 0.1373291015625f, 0.9721679687500f, -0.1022949218750f, 0.0476074218750f, -0.0266113281250f, 0.0148925781250f, -0.0083007812500f },
+    { -0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f, -0.1665039062500f, 0.4650878906250f, 0.7797851562500f, -0.2003173828125f, 0.1015625000000f, -0.0582275390625f, 0.0330810546875f, -0.0189208984375f },
+    { -0.0189208984375f, 0.0330810546875f, -0.0582275390625f, 0.1015625000000f, -0.2003173828125f, 0.7797851562500f, 0.4650878906250f, -0.1665039062500f, 0.0891113281250f, -0.0517578125000f, 0.0292968750000f, -0.0291748046875f },
+    { -0.0083007812500f, 0.0148925781250f, -0.0266113281250f, 0.0476074218750f, -0.1022949218750f, 0.9721679687500f, 0.1373291015625f, -0.0594482421875f, 0.0332031250000f, -0.0196533203125f, 0.0109863281250f, 0.0017089843750f }
+};
+
+// A sample of the meter's input. Negative frames are in the history of the previous buffer.
+static inline float meterSample(const SuperpoweredSIMDMeterState *state, const float *input, int frame, unsigned int channel) {
+    if (frame >= 0) return input[(unsigned int)frame * state->numChannels + channel];
+    return state->history[(unsigned int)(SUPERPOWEREDSIMD_METERHISTORY + frame) * state->numChannels + channel];
+}
+
+// Adds the peak, the sum of squares and the true peak between fromFrame and toFrame to the results (if not NULL).
+static inline void meterScalar(const SuperpoweredSIMDMeterState *state, const float *input, unsigned int fromFrame, unsigned int toFrame, float *peaks, float *squares, float *truePeaks) {
+    unsigned int numChannels = state->numChannels;
+    for (unsigned int channel = 0; channel < numChannels; channel++) {
+        for (unsigned int frame = fromFrame; frame < toFrame; frame++) {
+            float value = input[frame * numChannels + channel], absolute = fabsf(value);
+            if (peaks && (absolute > peaks[channel])) peaks[channel] = absolute;
+            if (squares) squares[channel] += value * value;
+            if (!truePeaks) continue;
+            if (absolute > truePeaks[channel]) truePeaks[channel] = absolute;
+            for (int phase = 0; phase < 4; phase++) {
+                float sum = 0;
+                for (int tap = 0; tap < SUPERPOWEREDSIMD_TRUEPEAKTAPS; tap++) sum += truePeakCoefficients[phase][tap] * meterSample(state, input, (int)frame - tap, channel);
+                if (fabsf(sum) > truePeaks[channel]) truePeaks[channel] = fabsf(sum);
+            }
+        }
+    }
+}
+
+// The K-weighting filters between fromFrame and toFrame, adds the sum of squares of their output to loudness.
+// Two biquads in transposed direct form II. Double precision, because the poles of the high-pass are very close to the unit circle.
+// The recursion is the bottleneck: two channels run together, so their recursions overlap, and the feedback is subtracted last to keep the dependency chain short.
+static inline void kWeightingScalar(SuperpoweredSIMDMeterState *state, const float *input, unsigned int fromFrame, unsigned int toFrame, float *loudness) {
+    const double *c = state->coefficients;
+    unsigned int numChannels = state->numChannels;
+    for (unsigned int first = 0; first < numChannels; first += 2) {
+        unsigned int second = (first + 1 < numChannels) ? first + 1 : first; // An odd channel runs twice, harmlessly.
+        double *za = state->filters[first], *zb = state->filters[second];
+        double z0[2] = { za[0], zb[0] }, z1[2] = { za[1], zb[1] }, z2[2] = { za[2], zb[2] }, z3[2] = { za[3], zb[3] }, sum[2] = { 0, 0 };
+
+        for (unsigned int frame = fromFrame, index = fromFrame * numChannels; frame < toFrame; frame++, index += numChannels) {
+            double x[2] = { input[index + first], input[index + second] };
+            for (int n = 0; n < 2; n++) {
+                double y = c[0] * x[n] + z0[n];
+                z0[n] = (c[1] * x[n] + z1[n]) - c[3] * y;
+                z1[n] = c[2] * x[n] - c[4] * y;
+                double w = c[5] * y + z2[n];
+                z2[n] = (c[6] * y + z3[n]) - c[8] * w;
+                z3[n] = c[7] * y - c[9] * w;
+                sum[n] += w * w;
+            }
+        }
+
+        // The states decay to denormals in silence.
+        for (int n = 0; n < 2; n++) {
+            double *z = n ? zb : za;
+            z[0] = (fabs(z0[n]) < 1e-30) ? 0 : z0[n];
+            z[1] = (fabs(z1[n]) < 1e-30) ? 0 : z1[n];
+            z[2] = (fabs(z2[n]) < 1e-30) ? 0 : z2[n];
+            z[3] = (fabs(z3[n]) < 1e-30) ? 0 : z3[n];
+        }
+        loudness[first] += (float)sum[0];
+        if (second != first) loudness[second] += (float)sum[1];
+    }
+}
+
+// Replaces infinity and NaN between fromIndex and toIndex with zero or the previous value of the channel, and flushes denormals to zero.
+// Adds the replaced values to count, firstIndex is set at the first one.
+static inline void scrubScalar(float *buffer, unsigned int fromIndex, unsigned int toIndex, unsigned int numChannels, bool hold, unsigned int *count, unsigned int *firstIndex) {
+    for (unsigned int n = fromIndex; n < toIndex; n++) {
+        unsigned int bits;
+        memcpy(&bits, buffer + n, sizeof(bits));
+        unsigned int exponent = bits & 0x7f800000;
+        if (exponent == 0x7f800000) {
+            if (!*count) *firstIndex = n;
+            (*count)++;
+            buffer[n] = (hold && (n >= numChannels)) ? buffer[n - numChannels] : 0;
+        } else if (!exponent && (bits & 0x7fffff)) buffer[n] = 0;
+    }
+}
+
+// The first 257 values of the synthesis window D[] of ISO/IEC 11172-3 Annex B, multiplied by 65536 (the table has 1/65536 steps).
+// The rest is symmetric: D[512 - i] = -D[i], except at multiples of 64, where D[512 - i] = D[i].
+static const int mp3SynthesisWindow[257] = {
+    0, -1, -1, -1, -1, -1, -1, -2, -2, -2, -2, -3, -3, -4, -4, -5,
+    -5, -6, -7, -7, -8, -9, -10, -11, -13, -14, -16, -17, -19, -21, -24, -26,
+    -29, -31, -35, -38, -41, -45, -49, -53, -58, -63, -68, -73, -79, -85, -91, -97,
+    -104, -111, -117, -125, -132, -139, -147, -154, -161, -169, -176, -183, -190, -196, -202, -208,
+    213, 218, 222, 225, 227, 228, 228, 227, 224, 221, 215, 208, 200, 189, 177, 163,
+    146, 127, 106, 83, 57, 29, -2, -36, -72, -111, -153, -197, -244, -294, -347, -401,
+    -459, -519, -581, -645, -711, -779, -848, -919, -991, -1064, -1137, -1210, -1283, -1356, -1428, -1498,
+    -1567, -1634, -1698, -1759, -1817, -1870, -1919, -1962, -2001, -2032, -2057, -2075, -2085, -2087, -2080, -2063,
+    2037, 2000, 1952, 1893, 1822, 1739, 1644, 1535, 1414, 1280, 1131, 970, 794, 605, 402, 185,
+    -45, -288, -545, -814, -1095, -1388, -1692, -2006, -2330, -2663, -3004, -3351, -3705, -4063, -4425, -4788,
+    -5153, -5517, -5879, -6237, -6589, -6935, -7271, -7597, -7910, -8209, -8491, -8755, -8998, -9219, -9416, -9585,
+    -9727, -9838, -9916, -9959, -9966, -9935, -9863, -9750, -9592, -9389, -9139, -8840, -8492, -8092, -7640, -7134,
+    6574, 5959, 5288, 4561, 3776, 2935, 2037, 1082, 70, -998, -2122, -3300, -4533, -5818, -7154, -8540,
+    -9975, -11455, -12980, -14548, -16155, -17799, -19478, -21189, -22929, -24694, -26482, -28289, -30112, -31947, -33791, -35640,
+    -37489, -39336, -41176, -43006, -44821, -46617, -48390, -50137, -51853, -53534, -55178, -56778, -58333, -59838, -61289, -62684,
+    -64019, -65290, -66494, -67629, -68692, -69679, -70590, -71420, -72169, -72835, -73415, -73908, -74313, -74630, -74856, -74992,
+    75038
+};
+
+// |value|^(4/3) as value * cbrt(|value|). The cube root starts from the exponent divided by 3, then 3 Newton steps. The vector code paths do the same.
+static inline float mp3Power(float value) {
+    float absolute = fabsf(value), root;
+    unsigned int bits;
+    memcpy(&bits, &absolute, sizeof(bits));
+    bits = (unsigned int)((float)bits * (1.0f / 3.0f)) + 0x2a514067;
+    memcpy(&root, &bits, sizeof(root));
+    for (int n = 0; n < 3; n++) root = (root + root + absolute / (root * root)) * (1.0f / 3.0f);
+    return value * root;
+}
+
+// The IMDCT of one subband's 18 lines, windowed. Only the unique half of the outputs is calculated, the symmetries make the rest.
+static inline void mp3LongScalar(const SuperpoweredSIMDMP3State *state, const float *input, int blockType, float *z) {
+    const float *window = state->windows + blockType * 36;
+    float t[18];
+    for (int n = 0; n < 18; n++) {
+        float sum = 0;
+        for (int k = 0; k < 18; k++) sum += input[k] * state->imdct36[k * 18 + n];
+        t[n] = sum;
+    }
+    for (int n = 0; n < 9; n++) {
+        z[n] = t[n] * window[n];
+        z[17 - n] = -t[n] * window[17 - n];
+        z[18 + n] = t[9 + n] * window[18 + n];
+        z[35 - n] = t[9 + n] * window[35 - n];
+    }
+}
+
+// The 3 IMDCTs of a short block, windowed and overlapped.
+static inline void mp3ShortScalar(const SuperpoweredSIMDMP3State *state, const float *input, float *z) {
+    const float *window = state->windows + 2 * 36;
+    memset(z, 0, 36 * sizeof(float));
+    for (int w = 0; w < 3; w++) {
+        float t[6], y[12];
+        for (int n = 0; n < 6; n++) {
+            float sum = 0;
+            for (int k = 0; k < 6; k++) sum += input[3 * k + w] * state->imdct12[k * 6 + n];
+            t[n] = sum;
+        }
+        for (int n = 0; n < 3; n++) {
+            y[n] = t[n];
+            y[5 - n] = -t[n];
+            y[6 + n] = t[3 + n];
+            y[11 - n] = t[3 + n];
+        }
+        for (int n = 0; n < 12; n++) z[6 + 6 * w + n] += y[n] * window[n];
+    }
+}
+
+// The 64 values of the synthesis history from the 32 unique matrixing results.
+static inline void mp3FillV(float *v, const float *c) {
+    for (int i = 0; i < 16; i++) v[i] = c[16 + i];
+    v[16] = 0;
+    for (int i = 17; i < 33; i++) v[i] = -c[48 - i];
+    for (int i = 33; i < 64; i++) v[i] = -c[(i < 48) ? 48 - i : i - 48];
+}
+
+// Where the 16 terms of every output sample are in the synthesis history, relative to its beginning.
+static inline unsigned int mp3WindowOffset(unsigned int term) {
+    return (term >> 1) * 128 + ((term & 1) ? 96 : 0);
+}
+
+static inline unsigned int greatestCommonDivisor(unsigned int a, unsigned int b) {
+    while (b) {
+        unsigned int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// ---- Generic: the library's SuperpoweredSimple.h functions. ----
+
+// SuperpoweredPeak() needs a multiple of 8 values.
+static float genericPeak(float *input, unsigned int numberOfValues) {
+    unsigned int multipleOf8 = numberOfValues & ~7u;
+    float peak = multipleOf8 ? SuperpoweredPeak(input, multipleOf8) : 0;
+    for (unsigned int n = multipleOf8; n < numberOfValues; n++) if (fabsf(input[n]) > peak) peak = fabsf(input[n]);
+    return peak;
+}
+
+static void genericShortIntToFloatPeaks(short int *input, float *output, unsigned int numberOfSamples, float *peaks) {
+    SuperpoweredShortIntToFloat(input, output, numberOfSamples, peaks);
+}
+
+static void genericShortIntToFloat(short int *input, float *output, unsigned int numberOfSamples, unsigned int numChannels) {
+    SuperpoweredShortIntToFloat(input, output, numberOfSamples, numChannels);
+}
+
+// There are no N-channel functions in the library.
+static void genericRampInterleaved(float *input, float *output, const float *volumeStart, const float *volumeEnd, const float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels, bool add) {
+    for (unsigned int channel = 0; channel < numChannels; channel++) {
+        float gain = volumeStart[channel], step = rampStep(volumeStart, volumeEnd, volumeChange, channel, numberOfSamples);
+        float *i = input + channel, *o = output + channel;
+        for (unsigned int n = 0; n < numberOfSamples; n++, i += numChannels, o += numChannels, gain += step) {
+            if (add) *o += *i * gain; else *o = *i * gain;
+        }
+    }
+}
+
+static void genericRampPlanar(float **inputs, float **outputs, const float *volumeStart, const float *volumeEnd, const float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels, bool add) {
+    for (unsigned int channel = 0; channel < numChannels; channel++) {
+        float gain = volumeStart[channel], step = rampStep(volumeStart, volumeEnd, volumeChange, channel, numberOfSamples);
+        float *i = inputs[channel], *o = outputs[channel];
+        for (unsigned int n = 0; n < numberOfSamples; n++, gain += step) {
+            if (add) o[n] += i[n] * gain; else o[n] = i[n] * gain;
+        }
+    }
+}
+
+static void genericInterleaveN(float **inputs, float *output, unsigned int numberOfSamples, unsigned int numChannels) {
+    if (numChannels == 2) SuperpoweredInterleave(inputs[0], inputs[1], output, numberOfSamples);
+    else for (unsigned int channel = 0; channel < numChannels; channel++) {
+        float *i = inputs[channel], *o = output + channel;
+        for (unsigned int n = 0; n < numberOfSamples; n++, o += numChannels) *o = i[n];
+    }
+}
+
+static void genericDeInterleaveN(float *input, float **outputs, unsigned int numberOfSamples, unsigned int numChannels) {
+    if (numChannels == 2) SuperpoweredDeInterleave(input, outputs[0], outputs[1], numberOfSamples);
+    else for (unsigned int channel = 0; channel < numChannels; channel++) {
+        float *i = input + channel, *o = outputs[channel];
+        for (unsigned int n = 0; n < numberOfSamples; n++, i += numChannels) o[n] = *i;
+    }
+}
+
+static void genericConvertVolumeMeter(const void *input, int inputFormat, void *output, int outputFormat, const float *volumeStart, const float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels, float *peaks, float *sums) {
+    convertVolumeMeterScalar(input, inputFormat, output, outputFormat, volumeStart, volumeEnd, 0, numberOfSamples, numChannels, peaks, sums);
+}
+
+// Blocks of 64 samples, so the output block stays in the L1 cache while all inputs are added.
+static void genericAddN(float **inputs, const float *gainsStart, const float *gainsEnd, float *output, unsigned int numberOfSamples, unsigned int numChannels, unsigned int numInputs) {
+    for (unsigned int frame = 0; frame < numberOfSamples; frame += 64) {
+        addNScalar(inputs, gainsStart, gainsEnd, output, frame, (frame + 64 < numberOfSamples) ? frame + 64 : numberOfSamples, numberOfSamples, numChannels, numInputs);
+    }
+}
+
+// Blocks of 64 samples, so the K-weighting filters read the block from the L1 cache.
+static void genericMeter(SuperpoweredSIMDMeterState *state, const float *input, unsigned int numberOfSamples, float *peaks, float *squares, float *truePeaks, float *loudness) {
+    for (unsigned int frame = 0; frame < numberOfSamples; frame += 64) {
+        unsigned int toFrame = (frame + 64 < numberOfSamples) ? frame + 64 : numberOfSamples;
+        meterScalar(state, input, frame, toFrame, peaks, squares, truePeaks);
+        if (loudness) kWeightingScalar(state, input, frame, toFrame, loudness);
+    }
+}
+
+static unsigned int genericScrub(float *buffer, unsigned int numberOfValues, unsigned int numChannels, bool hold, unsigned int *firstIndex) {
+    unsigned int count = 0;
+    scrubScalar(buffer, 0, numberOfValues, numChannels, hold, &count, firstIndex);
+    return count;
+}
+
+static void genericFloatToHalf(const float *input, unsigned short int *output, unsigned int numberOfValues) {
+    for (unsigned int n = 0; n < numberOfValues; n++) output[n] = floatToHalf(input[n]);
+}
+
+static void genericHalfToFloat(const unsigned short int *input, float *output, unsigned int numberOfValues) {
+    for (unsigned int n = 0; n < numberOfValues; n++) output[n] = halfToFloat(input[n]);
+}
+
+// There is no MP3 synthesis in the library's public API.
+static void genericMP3Dequantize(const int *input, float *output, unsigned int numberOfValues, float multiplier) {
+    for (unsigned int n = 0; n < numberOfValues; n++) output[n] = mp3Power((float)input[n]) * multiplier;
+}
+
+static void genericMP3IMDCT(SuperpoweredSIMDMP3State *state, unsigned int channel, const float *input, float *output, int blockType, bool mixedBlock) {
+    float *overlap = state->overlap[channel];
+    for (int subband = 0; subband < 32; subband++) {
+        float z[36];
+        if ((blockType != 2) || (mixedBlock && (subband < 2))) mp3LongScalar(state, input + subband * 18, (blockType == 2) ? 0 : blockType, z);
+        else mp3ShortScalar(state, input + subband * 18, z);
+
+        for (int slot = 0; slot < 18; slot++) {
+            float value = z[slot] + overlap[slot * 32 + subband];
+            overlap[slot * 32 + subband] = z[18 + slot];
+            output[slot * 32 + subband] = (subband & slot & 1) ? -value : value; // Frequency inversion.
+        }
+    }
+}
+
+static void genericMP3Synthesis(SuperpoweredSIMDMP3State *state, unsigned int channel, const float *input, float *output, unsigned int numberOfSlots) {
+    float *history = state->v[channel];
+    for (unsigned int slot = 0; slot < numberOfSlots; slot++, input += 32, output += 32) {
+        float c[32];
+        for (int j = 0; j < 32; j++) {
+            float sum = 0;
+            for (int k = 0; k < 32; k++) sum += input[k] * state->synthesis[k * 32 + j];
+            c[j] = sum;
+        }
+        unsigned int offset = state->vOffset[channel] = (state->vOffset[channel] - 64) & 1023;
+        mp3FillV(history + offset, c);
+
+        for (int j = 0; j < 32; j++) {
+            float sum = 0;
+            for (unsigned int term = 0; term < 16; term++) sum += history[((offset + mp3WindowOffset(term)) & 1023) + j] * state->window[term * 32 + j];
+            output[j] = sum;
+        }
+    }
+}
+
+static const simdKernels genericKernels = {
+    SuperpoweredVolume, SuperpoweredChangeVolume, SuperpoweredVolumeAdd, SuperpoweredChangeVolumeAdd,
+    genericPeak, genericShortIntToFloatPeaks, genericShortIntToFloat, SuperpoweredFloatToShortInt,
+    SuperpoweredInterleave, SuperpoweredInterleaveAdd, SuperpoweredDeInterleave, SuperpoweredDeInterleaveAdd,
+    SuperpoweredHasNonFinite, SuperpoweredAdd1, SuperpoweredAdd2, SuperpoweredAdd4,
+    genericRampInterleaved, genericRampPlanar, genericInterleaveN, genericDeInterleaveN,
+    genericConvertVolumeMeter, genericAddN, genericMeter, genericScrub,
+    genericFloatToHalf, genericHalfToFloat,
+    genericMP3Dequantize, genericMP3IMDCT, genericMP3Synthesis
+};
+
+#ifdef SUPERPOWEREDSIMD_X86
+
+// ---- SSE2: 4 floats. ----
+
+#define SIMD_NAME(name) name##SSE2
+#define SIMD_FUNCTION static __attribute__((target("sse2")))
+#define SIMD_WIDTH 4
+typedef __m128 simdFloatSSE2;
+#define simdFloat simdFloatSSE2
+#define SIMD_LOAD(p) _mm_loadu_ps(p)
+#define SIMD_STORE(p, v) _mm_storeu_ps(p, v)
+#define SIMD_SET1(f) _mm_set1_ps(f)
+#define SIMD_ZERO() _mm_setzero_ps()
+#define SIMD_ADD(a, b) _mm_add_ps(a, b)
+#define SIMD_MUL(a, b) _mm_mul_ps(a, b)
+#define SIMD_DIV(a, b) _mm_div_ps(a, b)
+#define SIMD_MIN(a, b) _mm_min_ps(a, b)
+#define SIMD_MAX(a, b) _mm_max_ps(a, b)
+#define SIMD_ABS(v) _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)))
+#define SIMD_LOADSHORTS(p) loadShortsSSE2(p)
+#define SIMD_STORESHORTS(p, v) storeShortsSSE2(p, v)
+#define SIMD_INTERLEAVE(l, r, o) interleaveVectorsSSE2(l, r, o)
+#define SIMD_DEINTERLEAVE(i, l, r) deInterleaveVectorsSSE2(i, &l, &r)
+#define SIMD_NONFINITE(v) nonFiniteSSE2(v)
+#define SIMD_NONFINITEBITS(v) nonFiniteBitsSSE2(v)
+#define SIMD_DENORMALBITS(v) denormalBitsSSE2(v)
+#define SIMD_SCRUB(v) scrubSSE2(v)
+#define SIMD_LOADHALFS(p) loadHalfsSSE2(p)
+#define SIMD_STOREHALFS(p, v) storeHalfsSSE2(p, v)
+#define SIMD_LOADCHARS(p) loadCharsSSE2(p)
+#define SIMD_STORECHARS(p, v) storeCharsSSE2(p, v)
+#define SIMD_LOADINTS(p) _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)(p)))
+#define SIMD_STOREINTS(p, v) _mm_storeu_si128((__m128i *)(p), _mm_cvtps_epi32(v))
+#define SIMD_CBRTGUESS(v) _mm_castsi128_ps(_mm_add_epi32(_mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_castps_si128(v)), _mm_set1_ps(1.0f / 3.0f))), _mm_set1_epi32(0x2a514067)))
+
+SIMD_FUNCTION inline __m128 loadShortsSSE2(const short int *input) {
+    __m128i shorts = _mm_loadl_epi64((const __m128i *)input);
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(shorts, shorts), 16)); // Sign extension.
+}
+
+SIMD_FUNCTION inline void storeShortsSSE2(short int *output, __m128 v) {
+    __m128i ints = _mm_cvtps_epi32(v);
+    _mm_storel_epi64((__m128i *)output, _mm_packs_epi32(ints, ints));
+}
+
+SIMD_FUNCTION inline __m128 loadCharsSSE2(const signed char *input) {
+    int bytes;
+    memcpy(&bytes, input, 4);
+    __m128i chars = _mm_cvtsi32_si128(bytes);
+    chars = _mm_unpacklo_epi8(chars, chars);
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(chars, chars), 24)); // Sign extension.
+}
+
+SIMD_FUNCTION inline void storeCharsSSE2(signed char *output, __m128 v) {
+    __m128i ints = _mm_cvtps_epi32(v), shorts = _mm_packs_epi32(ints, ints);
+    int bytes = _mm_cvtsi128_si32(_mm_packs_epi16(shorts, shorts));
+    memcpy(output, &bytes, 4);
+}
+
+SIMD_FUNCTION inline void interleaveVectorsSSE2(__m128 left, __m128 right, float *output) {
+    _mm_storeu_ps(output, _mm_unpacklo_ps(left, right));
+    _mm_storeu_ps(output + 4, _mm_unpackhi_ps(left, right));
+}
+
+SIMD_FUNCTION inline void deInterleaveVectorsSSE2(const float *input, __m128 *left, __m128 *right) {
+    __m128 a = _mm_loadu_ps(input), b = _mm_loadu_ps(input + 4);
+    *left = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    *right = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+// The exponent is all ones for infinity and NaN.
+SIMD_FUNCTION inline int nonFiniteSSE2(__m128 v) {
+    __m128i exponent = _mm_set1_epi32(0x7f800000);
+    return _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(_mm_castps_si128(v), exponent), exponent));
+}
+
+// One bit per lane.
+SIMD_FUNCTION inline int nonFiniteBitsSSE2(__m128 v) {
+    __m128i exponent = _mm_set1_epi32(0x7f800000);
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_castps_si128(v), exponent), exponent)));
+}
+
+// Denormals have a zero exponent and a non-zero mantissa, the bits of the absolute value are between 1 and 0x7fffff.
+SIMD_FUNCTION inline int denormalBitsSSE2(__m128 v) {
+    __m128i bits = _mm_and_si128(_mm_castps_si128(v), _mm_set1_epi32(0x7fffffff));
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(_mm_cmpgt_epi32(bits, _mm_setzero_si128()), _mm_cmplt_epi32(bits, _mm_set1_epi32(0x800000)))));
+}
+
+// The exponent is all ones or all zeros: infinity, NaN, denormal (or zero) becomes zero.
+SIMD_FUNCTION inline __m128 scrubSSE2(__m128 v) {
+    __m128i exponentMask = _mm_set1_epi32(0x7f800000), exponent = _mm_and_si128(_mm_castps_si128(v), exponentMask);
+    __m128i zero = _mm_or_si128(_mm_cmpeq_epi32(exponent, exponentMask), _mm_cmpeq_epi32(exponent, _mm_setzero_si128()));
+    return _mm_andnot_ps(_mm_castsi128_ps(zero), v);
+}
+
+// No F16C: the bit tricks of halfToFloat, with the special cases selected by masks.
+SIMD_FUNCTION inline __m128 loadHalfsSSE2(const unsigned short int *input) {
+    __m128i halfs = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)input), _mm_setzero_si128());
+    __m128i exponentMask = _mm_set1_epi32(0x0f800000), rebias = _mm_set1_epi32(0x38000000);
+    __m128i bits = _mm_slli_epi32(_mm_and_si128(halfs, _mm_set1_epi32(0x7fff)), 13), exponent = _mm_and_si128(bits, exponentMask);
+    bits = _mm_add_epi32(bits, rebias);
+    bits = _mm_add_epi32(bits, _mm_and_si128(_mm_cmpeq_epi32(exponent, exponentMask), rebias));
+    __m128i denormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+    __m128i renormalized = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(0x00800000))), _mm_set1_ps(6.103515625e-05f)));
+    bits = _mm_or_si128(_mm_and_si128(denormal, renormalized), _mm_andnot_si128(denormal, bits));
+    return _mm_castsi128_ps(_mm_or_si128(bits, _mm_slli_epi32(_mm_and_si128(halfs, _mm_set1_epi32(0x8000)), 16)));
+}
+
+// The bit tricks of floatToHalf.
+SIMD_FUNCTION inline void storeHalfsSSE2(unsigned short int *output, __m128 v) {
+    __m128i bits = _mm_castps_si128(v), sign = _mm_and_si128(bits, _mm_set1_epi32((int)0x80000000));
+    bits = _mm_xor_si128(bits, sign);
+    __m128i special = _mm_cmpgt_epi32(bits, _mm_set1_epi32(0x477fffff)), nan = _mm_cmpgt_epi32(bits, _mm_set1_epi32(0x7f800000));
+    __m128i denormal = _mm_cmplt_epi32(bits, _mm_set1_epi32(0x38800000));
+    __m128i infinityOrNaN = _mm_or_si128(_mm_set1_epi32(0x7c00), _mm_and_si128(nan, _mm_set1_epi32(0x0200)));
+    __m128i small = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(bits), _mm_set1_ps(0.5f))), _mm_set1_epi32(0x3f000000));
+    __m128i normal = _mm_add_epi32(_mm_add_epi32(bits, _mm_set1_epi32((int)0xc8000fff)), _mm_and_si128(_mm_srli_epi32(bits, 13), _mm_set1_epi32(1)));
+    normal = _mm_srli_epi32(normal, 13);
+    __m128i result = _mm_or_si128(_mm_and_si128(denormal, small), _mm_andnot_si128(denormal, normal));
+    result = _mm_or_si128(_mm_and_si128(special, infinityOrNaN), _mm_andnot_si128(special, result));
+    result = _mm_or_si128(result, _mm_srli_epi32(sign, 16));
+    result = _mm_srai_epi32(_mm_slli_epi32(result, 16), 16); // Sign extension, so the signed saturation of the pack keeps the bits.
+    _mm_storel_epi64((__m128i *)output, _mm_packs_epi32(result, result));
+}
+
+#include "SuperpoweredSIMDKernels.inc"
+
+// ---- AVX2: 8 floats. ----
+
+#define SIMD_NAME(name) name##AVX2
+#define SIMD_FUNCTION static __attribute__((target("avx2,f16c")))
+#define SIMD_WIDTH 8
+typedef __m256 simdFloatAVX2;
+#define simdFloat simdFloatAVX2
+#define SIMD_LOAD(p) _mm256_loadu_ps(p)
+#define SIMD_STORE(p, v) _mm256_storeu_ps(p, v)
+#define SIMD_SET1(f) _mm256_set1_ps(f)
+#define SIMD_ZERO() _mm256_setzero_ps()
+#define SIMD_ADD(a, b) _mm256_add_ps(a, b)
+#define SIMD_MUL(a, b) _mm256_mul_ps(a, b)
+#define SIMD_DIV(a, b) _mm256_div_ps(a, b)
+#define SIMD_MIN(a, b) _mm256_min_ps(a, b)
+#define SIMD_MAX(a, b) _mm256_max_ps(a, b)
+#define SIMD_ABS(v) _mm256_and_ps(v, _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff)))
+#define SIMD_LOADSHORTS(p) loadShortsAVX2(p)
+#define SIMD_STORESHORTS(p, v) storeShortsAVX2(p, v)
+#define SIMD_INTERLEAVE(l, r, o) interleaveVectorsAVX2(l, r, o)
+#define SIMD_DEINTERLEAVE(i, l, r) deInterleaveVectorsAVX2(i, &l, &r)
+#define SIMD_NONFINITE(v) nonFiniteAVX2(v)
+#define SIMD_NONFINITEBITS(v) nonFiniteBitsAVX2(v)
+#define SIMD_DENORMALBITS(v) denormalBitsAVX2(v)
+#define SIMD_SCRUB(v) scrubAVX2(v)
+#define SIMD_LOADHALFS(p) _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(p)))
+#define SIMD_STOREHALFS(p, v) _mm_storeu_si128((__m128i *)(p), _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT))
+#define SIMD_LOADCHARS(p) _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)(p))))
+#define SIMD_STORECHARS(p, v) storeCharsAVX2(p, v)
+#define SIMD_LOADINTS(p) _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i *)(p)))
+#define SIMD_STOREINTS(p, v) _mm256_storeu_si256((__m256i *)(p), _mm256_cvtps_epi32(v))
+#define SIMD_CBRTGUESS(v) _mm256_castsi256_ps(_mm256_add_epi32(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_castps_si256(v)), _mm256_set1_ps(1.0f / 3.0f))), _mm256_set1_epi32(0x2a514067)))
+
+SIMD_FUNCTION inline __m256 loadShortsAVX2(const short int *input) {
+    return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)input)));
+}
+
+SIMD_FUNCTION inline void storeShortsAVX2(short int *output, __m256 v) {
+    __m256i ints = _mm256_cvtps_epi32(v);
+    _mm_storeu_si128((__m128i *)output, _mm_packs_epi32(_mm256_castsi256_si128(ints), _mm256_extracti128_si256(ints, 1)));
+}
+
+SIMD_FUNCTION inline void storeCharsAVX2(signed char *output, __m256 v) {
+    __m256i ints = _mm256_cvtps_epi32(v);
+    __m128i shorts = _mm_packs_epi32(_mm256_castsi256_si128(ints), _mm256_extracti128_si256(ints, 1));
+    _mm_storel_epi64((__m128i *)output, _mm_packs_epi16(shorts, shorts));
+}
+
+// Unpack works within 128-bit lanes, the lanes are put in order after.
+SIMD_FUNCTION inline void interleaveVectorsAVX2(__m256 left, __m256 right, float *output) {
+    __m256 low = _mm256_unpacklo_ps(left, right), high = _mm256_unpackhi_ps(left, right);
+    _mm256_storeu_ps(output, _mm256_permute2f128_ps(low, high, 0x20));
+    _mm256_storeu_ps(output + 8, _mm256_permute2f128_ps(low, high, 0x31));
+}
+
+SIMD_FUNCTION inline void deInterleaveVectorsAVX2(const float *input, __m256 *left, __m256 *right) {
+    __m256 a = _mm256_loadu_ps(input), b = _mm256_loadu_ps(input + 8);
+    *left = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+    *right = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+SIMD_FUNCTION inline int nonFiniteAVX2(__m256 v) {
+    __m256i exponent = _mm256_set1_epi32(0x7f800000);
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_castps_si256(v), exponent), exponent));
+}
+
+SIMD_FUNCTION inline int nonFiniteBitsAVX2(__m256 v) {
+    __m256i exponent = _mm256_set1_epi32(0x7f800000);
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_castps_si256(v), exponent), exponent)));
+}
+
+SIMD_FUNCTION inline int denormalBitsAVX2(__m256 v) {
+    __m256i bits = _mm256_and_si256(_mm256_castps_si256(v), _mm256_set1_epi32(0x7fffffff));
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(_mm256_cmpgt_epi32(bits, _mm256_setzero_si256()), _mm256_cmpgt_epi32(_mm256_set1_epi32(0x800000), bits))));
+}
+
+SIMD_FUNCTION inline __m256 scrubAVX2(__m256 v) {
+    __m256i exponentMask = _mm256_set1_epi32(0x7f800000), exponent = _mm256_and_si256(_mm256_castps_si256(v), exponentMask);
+    __m256i zero = _mm256_or_si256(_mm256_cmpeq_epi32(exponent, exponentMask), _mm256_cmpeq_epi32(exponent, _mm256_setzero_si256()));
+    return _mm256_andnot_ps(_mm256_castsi256_ps(zero), v);
+}
+
+#include "SuperpoweredSIMDKernels.inc"
+
+// ---- AVX-512: 16 floats. ----
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized" // False positives in GCC's own AVX-512 headers.
+#endif
+
+#define SIMD_NAME(name) name##AVX512
+#define SIMD_FUNCTION static __attribute__((target("avx512f")))
+#define SIMD_WIDTH 16
+typedef __m512 simdFloatAVX512;
+#define simdFloat simdFloatAVX512
+#define SIMD_LOAD(p) _mm512_loadu_ps(p)
+#define SIMD_STORE(p, v) _mm512_storeu_ps(p, v)
+#define SIMD_SET1(f) _mm512_set1_ps(f)
+#define SIMD_ZERO() _mm512_setzero_ps()
+#define SIMD_ADD(a, b) _mm512_add_ps(a, b)
+#define SIMD_MUL(a, b) _mm512_mul_ps(a, b)
+#define SIMD_DIV(a, b) _mm512_div_ps(a, b)
+#define SIMD_MIN(a, b) _mm512_min_ps(a, b)
+#define SIMD_MAX(a, b) _mm512_max_ps(a, b)
+#define SIMD_ABS(v) _mm512_castsi512_ps(_mm512_and_epi32(_mm512_castps_si512(v), _mm512_set1_epi32(0x7fffffff)))
+#define SIMD_LOADSHORTS(p) _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *)(p))))
+#define SIMD_STORESHORTS(p, v) _mm256_storeu_si256((__m256i *)(p), _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(v)))
+#define SIMD_INTERLEAVE(l, r, o) interleaveVectorsAVX512(l, r, o)
+#define SIMD_DEINTERLEAVE(i, l, r) deInterleaveVectorsAVX512(i, &l, &r)
+#define SIMD_NONFINITE(v) nonFiniteAVX512(v)
+#define SIMD_NONFINITEBITS(v) nonFiniteAVX512(v)
+#define SIMD_DENORMALBITS(v) denormalBitsAVX512(v)
+#define SIMD_SCRUB(v) scrubAVX512(v)
+#define SIMD_LOADHALFS(p) _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)(p)))
+#define SIMD_STOREHALFS(p, v) _mm256_storeu_si256((__m256i *)(p), _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT))
+#define SIMD_LOADCHARS(p) _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i *)(p))))
+#define SIMD_STORECHARS(p, v) _mm_storeu_si128((__m128i *)(p), _mm512_cvtsepi32_epi8(_mm512_cvtps_epi32(v)))
+#define SIMD_LOADINTS(p) _mm512_cvtepi32_ps(_mm512_loadu_si512((const void *)(p)))
+#define SIMD_STOREINTS(p, v) _mm512_storeu_si512((void *)(p), _mm512_cvtps_epi32(v))
+#define SIMD_CBRTGUESS(v) _mm512_castsi512_ps(_mm512_add_epi32(_mm512_cvttps_epi32(_mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_castps_si512(v)), _mm512_set1_ps(1.0f / 3.0f))), _mm512_set1_epi32(0x2a514067)))
+
+SIMD_FUNCTION inline void interleaveVectorsAVX512(__m512 left, __m512 right, float *output) {
+    const __m512i low = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+    const __m512i high = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+    _mm512_storeu_ps(output, _mm512_permutex2var_ps(left, low, right));
+    _mm512_storeu_ps(output + 16, _mm512_permutex2var_ps(left, high, right));
+}
+
+SIMD_FUNCTION inline void deInterleaveVectorsAVX512(const float *input, __m512 *left, __m512 *right) {
+    const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const __m512i odd = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+    __m512 a = _mm512_loadu_ps(input), b = _mm512_loadu_ps(input + 16);
+    *left = _mm512_permutex2var_ps(a, even, b);
+    *right = _mm512_permutex2var_ps(a, odd, b);
+}
+
+SIMD_FUNCTION inline int nonFiniteAVX512(__m512 v) {
+    __m512i exponent = _mm512_set1_epi32(0x7f800000);
+    return (int)_mm512_cmpeq_epi32_mask(_mm512_and_epi32(_mm512_castps_si512(v), exponent), exponent);
+}
+
+SIMD_FUNCTION inline int denormalBitsAVX512(__m512 v) {
+    __m512i bits = _mm512_and_epi32(_mm512_castps_si512(v), _mm512_set1_epi32(0x7fffffff));
+    return (int)_mm512_mask_cmplt_epi32_mask(_mm512_cmpgt_epi32_mask(bits, _mm512_setzero_si512()), bits, _mm512_set1_epi32(0x800000));
+}
+
+SIMD_FUNCTION inline __m512 scrubAVX512(__m512 v) {
+    __m512i exponentMask = _mm512_set1_epi32(0x7f800000), exponent = _mm512_and_epi32(_mm512_castps_si512(v), exponentMask);
+    __mmask16 zero = _mm512_cmpeq_epi32_mask(exponent, exponentMask) | _mm512_cmpeq_epi32_mask(exponent, _mm512_setzero_si512());
+    return _mm512_maskz_mov_ps((__mmask16)~zero, v);
+}
+
+#include "SuperpoweredSIMDKernels.inc"
+
+// Reads XCR0: which registers the operating system saves on context switches.
+static unsigned int readXCR0() {
+    unsigned int eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return eax;
+}
+
+static SuperpoweredSIMDLevel detectLevel() {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return SuperpoweredSIMDLevel_Generic;
+    if (!(edx & (1 << 26))) return SuperpoweredSIMDLevel_Generic; // SSE2
+    // AVX needs OSXSAVE and the OS saving the XMM and YMM registers.
+    if (!(ecx & (1 << 27)) || !(ecx & (1 << 28)) || ((readXCR0() & 0x6) != 0x6)) return SuperpoweredSIMDLevel_SSE2;
+    bool f16c = (ecx & (1 << 29)) != 0; // Every AVX2 CPU has it, checked anyway.
+    if (__get_cpuid_max(0, 0) < 7) return SuperpoweredSIMDLevel_SSE2;
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    if (!(ebx & (1 << 5)) || !f16c) return SuperpoweredSIMDLevel_SSE2; // AVX2
+    // AVX-512 needs the OS saving the opmask and ZMM registers too.
+    if (!(ebx & (1 << 16)) || ((readXCR0() & 0xe6) != 0xe6)) return SuperpoweredSIMDLevel_AVX2;
+    return SuperpoweredSIMDLevel_AVX512;
+}
+
+static const simdKernels *levelKernels[4] = { &genericKernels, &kernelsSSE2, &kernelsAVX2, &kernelsAVX512 };
+
+#else
+
+static SuperpoweredSIMDLevel detectLevel() {
+    return SuperpoweredSIMDLevel_Generic;
+}
+
+static const simdKernels *levelKernels[4] = { &genericKernels, NULL, NULL, NULL };
+
+#endif
+
+// Set at the first call. Detection is idempotent, so a race only detects twice.
+static int supportedLevel = -1, activeLevel = -1;
+static const simdKernels *activeKernels = NULL;
+
+static const simdKernels *kernels() {
+    const simdKernels *k = __atomic_load_n(&activeKernels, __ATOMIC_ACQUIRE);
+    if (k) return k;
+    SuperpoweredSIMDLevel level = SuperpoweredSIMDGetSupportedLevel();
+    k = levelKernels[level];
+    __atomic_store_n(&activeLevel, (int)level, __ATOMIC_RELAXED);
+    __atomic_store_n(&activeKernels, k, __ATOMIC_RELEASE);
+    return k;
+}
+
+SuperpoweredSIMDLevel SuperpoweredSIMDGetSupportedLevel() {
+    int level = __atomic_load_n(&supportedLevel, __ATOMIC_RELAXED);
+    if (level < 0) {
+        level = (int)detectLevel();
+        __atomic_store_n(&supportedLevel, level, __ATOMIC_RELAXED);
+    }
+    return (SuperpoweredSIMDLevel)level;
+}
+
+SuperpoweredSIMDLevel SuperpoweredSIMDGetLevel() {
+    kernels();
+    return (SuperpoweredSIMDLevel)__atomic_load_n(&activeLevel, __ATOMIC_RELAXED);
+}
+
+bool SuperpoweredSIMDSetLevel(SuperpoweredSIMDLevel level) {
+    if ((level < SuperpoweredSIMDLevel_Generic) || (level > SuperpoweredSIMDGetSupportedLevel()) || !levelKernels[level]) return false;
+    __atomic_store_n(&activeLevel, (int)level, __ATOMIC_RELAXED);
+    __atomic_store_n(&activeKernels, levelKernels[level], __ATOMIC_RELEASE);
+    return true;
+}
+
+const char *SuperpoweredSIMDLevelName(SuperpoweredSIMDLevel level) {
+    switch (level) {
+        case SuperpoweredSIMDLevel_SSE2: return "SSE2";
+        case SuperpoweredSIMDLevel_AVX2: return "AVX2";
+        case SuperpoweredSIMDLevel_AVX512: return "AVX-512";
+        default: return "Generic";
+    }
+}
+
+void SuperpoweredSIMDVolume(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfSamples) {
+    kernels()->volume(input, output, volumeStart, volumeEnd, numberOfSamples);
+}
+
+void SuperpoweredSIMDChangeVolume(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfSamples) {
+    kernels()->changeVolume(input, output, volumeStart, volumeChange, numberOfSamples);
+}
+
+void SuperpoweredSIMDVolumeAdd(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfSamples) {
+    kernels()->volumeAdd(input, output, volumeStart, volumeEnd, numberOfSamples);
+}
+
+void SuperpoweredSIMDChangeVolumeAdd(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfSamples) {
+    kernels()->changeVolumeAdd(input, output, volumeStart, volumeChange, numberOfSamples);
+}
+
+float SuperpoweredSIMDPeak(float *input, unsigned int numberOfValues) {
+    return kernels()->peak(input, numberOfValues);
+}
+
+void SuperpoweredSIMDShortIntToFloat(short int *input, float *output, unsigned int numberOfSamples, float *peaks) {
+    kernels()->shortIntToFloatPeaks(input, output, numberOfSamples, peaks);
+}
+
+void SuperpoweredSIMDShortIntToFloat(short int *input, float *output, unsigned int numberOfSamples, unsigned int numChannels) {
+    kernels()->shortIntToFloat(input, output, numberOfSamples, numChannels);
+}
+
+void SuperpoweredSIMDFloatToShortInt(float *input, short int *output, unsigned int numberOfSamples, unsigned int numChannels) {
+    kernels()->floatToShortInt(input, output, numberOfSamples, numChannels);
+}
+
+void SuperpoweredSIMDInterleave(float *left, float *right, float *output, unsigned int numberOfSamples) {
+    kernels()->interleave(left, right, output, numberOfSamples);
+}
+
+void SuperpoweredSIMDInterleaveAdd(float *left, float *right, float *output, unsigned int numberOfSamples) {
+    kernels()->interleaveAdd(left, right, output, numberOfSamples);
+}
+
+void SuperpoweredSIMDDeInterleave(float *input, float *left, float *right, unsigned int numberOfSamples) {
+    kernels()->deInterleave(input, left, right, numberOfSamples);
+}
+
+void SuperpoweredSIMDDeInterleaveAdd(float *input, float *left, float *right, unsigned int numberOfSamples) {
+    kernels()->deInterleaveAdd(input, left, right, numberOfSamples);
+}
+
+bool SuperpoweredSIMDHasNonFinite(float *buffer, unsigned int numberOfValues) {
+    return kernels()->hasNonFinite(buffer, numberOfValues);
+}
+
+void SuperpoweredSIMDAdd1(float *input, float *output, unsigned int numberOfValues) {
+    kernels()->add1(input, output, numberOfValues);
+}
+
+void SuperpoweredSIMDAdd2(float *inputA, float *inputB, float *output, unsigned int numberOfValues) {
+    kernels()->add2(inputA, inputB, output, numberOfValues);
+}
+
+void SuperpoweredSIMDAdd4(float *inputA, float *inputB, float *inputC, float *inputD, float *output, unsigned int numberOfValues) {
+    kernels()->add4(inputA, inputB, inputC, inputD, output, numberOfValues);
+}
+
+void SuperpoweredSIMDVolumeN(float *input, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels) {
+    kernels()->rampInterleaved(input, output, volumeStart, volumeEnd, NULL, numberOfSamples, numChannels, false);
+}
+
+void SuperpoweredSIMDChangeVolumeN(float *input, float *output, float *volumeStart, float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels) {
+    kernels()->rampInterleaved(input, output, volumeStart, NULL, volumeChange, numberOfSamples, numChannels, false);
+}
+
+void SuperpoweredSIMDVolumeAddN(float *input, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels) {
+    kernels()->rampInterleaved(input, output, volumeStart, volumeEnd, NULL, numberOfSamples, numChannels, true);
+}
+
+void SuperpoweredSIMDChangeVolumeAddN(float *input, float *output, float *volumeStart, float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels) {
+    kernels()->rampInterleaved(input, output, volumeStart, NULL, volumeChange, numberOfSamples, numChannels, true);
+}
+
+void SuperpoweredSIMDVolumePlanar(float **inputs, float **outputs, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels) {
+    kernels()->rampPlanar(inputs, outputs, volumeStart, volumeEnd, NULL, numberOfSamples, numChannels, false);
+}
+
+void SuperpoweredSIMDChangeVolumePlanar(float **inputs, float **outputs, float *volumeStart, float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels) {
+    kernels()->rampPlanar(inputs, outputs, volumeStart, NULL, volumeChange, numberOfSamples, numChannels, false);
+}
+
+void SuperpoweredSIMDVolumeAddPlanar(float **inputs, float **outputs, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels) {
+    kernels()->rampPlanar(inputs, outputs, volumeStart, volumeEnd, NULL, numberOfSamples, numChannels, true);
+}
+
+void SuperpoweredSIMDChangeVolumeAddPlanar(float **inputs, float **outputs, float *volumeStart, float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels) {
+    kernels()->rampPlanar(inputs, outputs, volumeStart, NULL, volumeChange, numberOfSamples, numChannels, true);
+}
+
+void SuperpoweredSIMDInterleaveN(float **inputs, float *output, unsigned int numberOfSamples, unsigned int numChannels) {
+    kernels()->interleaveN(inputs, output, numberOfSamples, numChannels);
+}
+
+void SuperpoweredSIMDDeInterleaveN(float *input, float **outputs, unsigned int numberOfSamples, unsigned int numChannels) {
+    kernels()->deInterleaveN(input, outputs, numberOfSamples, numChannels);
+}
+
+void SuperpoweredSIMDToFloat(void *input, SuperpoweredSIMDFormat inputFormat, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels, float *peaks, float *rms) {
+    SuperpoweredSIMDConvert(input, inputFormat, output, SuperpoweredSIMDFormat_Float32, volumeStart, volumeEnd, numberOfSamples, numChannels, peaks, rms);
+}
+
+void SuperpoweredSIMDFromFloat(float *input, void *output, SuperpoweredSIMDFormat outputFormat, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels, float *peaks, float *rms) {
+    SuperpoweredSIMDConvert(input, SuperpoweredSIMDFormat_Float32, output, outputFormat, volumeStart, volumeEnd, numberOfSamples, numChannels, peaks, rms);
+}
+
+void SuperpoweredSIMDConvert(void *input, SuperpoweredSIMDFormat inputFormat, void *output, SuperpoweredSIMDFormat outputFormat, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels, float *peaks, float *rms) {
+    if (peaks) memset(peaks, 0, numChannels * sizeof(float));
+    if (rms) memset(rms, 0, numChannels * sizeof(float));
+    kernels()->convertVolumeMeter(input, inputFormat, output, outputFormat, volumeStart, volumeEnd, numberOfSamples, numChannels, peaks, rms);
+    if (rms && numberOfSamples) for (unsigned int channel = 0; channel < numChannels; channel++) rms[channel] = sqrtf(rms[channel] / (float)numberOfSamples);
+}
+
+void SuperpoweredSIMDAddN(float **inputs, float *gainsStart, float *gainsEnd, float *output, unsigned int numberOfSamples, unsigned int numChannels, unsigned int numInputs) {
+    kernels()->addN(inputs, gainsStart, gainsEnd, output, numberOfSamples, numChannels, numInputs);
+}
+
+// K-weighting: a high shelf and a high-pass, designed from the ITU-R BS.1770-4 analog prototypes, so the filters are right at any sample rate (the published coefficients are for 48 kHz).
+static void kWeightingCoefficients(double *c, double samplerate) {
+    double K = tan(M_PI * 1681.974450955533 / samplerate), Q = 0.7071752369554196;
+    double Vh = pow(10.0, 3.999843853973347 / 20.0), Vb = pow(Vh, 0.4996667741545416), a0 = 1.0 + K / Q + K * K;
+    c[0] = (Vh + Vb * K / Q + K * K) / a0;
+    c[1] = 2.0 * (K * K - Vh) / a0;
+    c[2] = (Vh - Vb * K / Q + K * K) / a0;
+    c[3] = 2.0 * (K * K - 1.0) / a0;
+    c[4] = (1.0 - K / Q + K * K) / a0;
+
+    K = tan(M_PI * 38.13547087602444 / samplerate);
+    Q = 0.5003270373238773;
+    a0 = 1.0 + K / Q + K * K;
+    c[5] = 1.0;
+    c[6] = -2.0;
+    c[7] = 1.0;
+    c[8] = 2.0 * (K * K - 1.0) / a0;
+    c[9] = (1.0 - K / Q + K * K) / a0;
+}
+
+bool SuperpoweredSIMDMeterInit(SuperpoweredSIMDMeterState *state, unsigned int samplerate, unsigned int numChannels) {
+    if (!samplerate || !numChannels || (numChannels > SUPERPOWEREDSIMD_MAXMETERCHANNELS)) return false;
+    memset(state, 0, sizeof(SuperpoweredSIMDMeterState));
+    state->numChannels = numChannels;
+    kWeightingCoefficients(state->coefficients, samplerate);
+    return true;
+}
+
+void SuperpoweredSIMDMeter(SuperpoweredSIMDMeterState *state, float *input, unsigned int numberOfSamples, float *peaks, float *sumSquares, float *truePeaks, float *loudness) {
+    unsigned int numChannels = state->numChannels;
+    if (peaks) memset(peaks, 0, numChannels * sizeof(float));
+    if (sumSquares) memset(sumSquares, 0, numChannels * sizeof(float));
+    if (truePeaks) memset(truePeaks, 0, numChannels * sizeof(float));
+    if (loudness) memset(loudness, 0, numChannels * sizeof(float));
+    kernels()->meter(state, input, numberOfSamples, peaks, sumSquares, truePeaks, loudness);
+
+    // The last samples for the true peak filter of the next buffer.
+    unsigned int historyValues = SUPERPOWEREDSIMD_METERHISTORY * numChannels, numberOfValues = numberOfSamples * numChannels;
+    if (numberOfValues >= historyValues) memcpy(state->history, input + numberOfValues - historyValues, historyValues * sizeof(float));
+    else {
+        memmove(state->history, state->history + numberOfValues, (historyValues - numberOfValues) * sizeof(float));
+        memcpy(state->history + historyValues - numberOfValues, input, numberOfValues * sizeof(float));
+    }
+}
+
+float SuperpoweredSIMDLoudness(float *loudness, unsigned int numberOfSamples, unsigned int numChannels, float *channelWeights) {
+    double sum = 0;
+    for (unsigned int channel = 0; channel < numChannels; channel++) sum += (channelWeights ? channelWeights[channel] : 1.0f) * loudness[channel];
+    if (!numberOfSamples || (sum <= 0)) return -INFINITY;
+    return (float)(-0.691 + 10.0 * log10(sum / (double)numberOfSamples));
+}
+
+void SuperpoweredSIMDMP3Init(SuperpoweredSIMDMP3State *state) {
+    memset(state, 0, sizeof(SuperpoweredSIMDMP3State));
+    for (int k = 0; k < 18; k++) for (int n = 0; n < 18; n++) { // Outputs 0-8 and 18-26.
+        int m = (n < 9) ? n : n + 9;
+        state->imdct36[k * 18 + n] = (float)cos(M_PI / 72.0 * (double)((2 * m + 19) * (2 * k + 1)));
+    }
+    for (int k = 0; k < 6; k++) for (int n = 0; n < 6; n++) { // Outputs 0-2 and 6-8.
+        int m = (n < 3) ? n : n + 3;
+        state->imdct12[k * 6 + n] = (float)cos(M_PI / 24.0 * (double)((2 * m + 7) * (2 * k + 1)));
+    }
+
+    float *window = state->windows;
+    for (int n = 0; n < 36; n++) window[n] = (float)sin(M_PI / 36.0 * (n + 0.5)); // Normal.
+    window += 36;
+    for (int n = 0; n < 18; n++) window[n] = (float)sin(M_PI / 36.0 * (n + 0.5)); // Start.
+    for (int n = 18; n < 24; n++) window[n] = 1.0f;
+    for (int n = 24; n < 30; n++) window[n] = (float)sin(M_PI / 12.0 * (n - 18 + 0.5));
+    window += 36;
+    for (int n = 0; n < 12; n++) window[n] = (float)sin(M_PI / 12.0 * (n + 0.5)); // Short.
+    window += 36;
+    for (int n = 6; n < 12; n++) window[n] = (float)sin(M_PI / 12.0 * (n - 6 + 0.5)); // Stop.
+    for (int n = 12; n < 18; n++) window[n] = 1.0f;
+    for (int n = 18; n < 36; n++) window[n] = (float)sin(M_PI / 36.0 * (n + 0.5));
+
+    for (int k = 0; k < 32; k++) for (int j = 0; j < 32; j++) state->synthesis[k * 32 + j] = (float)cos(M_PI / 64.0 * (double)(j * (2 * k + 1)));
+    for (int n = 0; n <= 256; n++) {
+        float value = (float)mp3SynthesisWindow[n] * (1.0f / 65536.0f);
+        state->window[n] = value;
+        if (n) state->window[512 - n] = (n & 63) ? -value : value;
+    }
+}
+
+void SuperpoweredSIMDMP3Dequantize(int *input, float *output, unsigned int numberOfValues, float multiplier) {
+    kernels()->mp3Dequantize(input, output, numberOfValues, multiplier);
+}
+
+void SuperpoweredSIMDMP3IMDCT(SuperpoweredSIMDMP3State *state, unsigned int channel, float *input, float *output, int blockType, bool mixedBlock) {
+    kernels()->mp3IMDCT(state, channel, input, output, blockType, mixedBlock);
+}
+
+void SuperpoweredSIMDMP3Synthesis(SuperpoweredSIMDMP3State *state, unsigned int channel, float *input, float *output, unsigned int numberOfSlots) {
+    kernels()->mp3Synthesis(state, channel, input, output, numberOfSlots);
+}
+
+unsigned int SuperpoweredSIMDScrub(float *buffer, unsigned int numberOfSamples, unsigned int numChannels, bool holdLastGood, unsigned int *firstIndex) {
+    unsigned int numberOfValues = numberOfSamples * numChannels, first = numberOfValues;
+    unsigned int count = kernels()->scrub(buffer, numberOfValues, numChannels, holdLastGood, &first);
+    if (firstIndex) *firstIndex = first;
+    return count;
+}
+
+// FTZ (flush to zero) is bit 15 of MXCSR, DAZ (denormals are zero) is bit 6. On ARM, FZ is bit 24 of FPCR/FPSCR, it does both.
+#if defined(SUPERPOWEREDSIMD_X86)
+#define SUPERPOWEREDSIMD_DENORMALBITS 0x8040
+static inline unsigned int readFloatingPointControl() { return _mm_getcsr(); }
+static inline void writeFloatingPointControl(unsigned int value) { _mm_setcsr(value); }
+#elif defined(__aarch64__)
+#define SUPERPOWEREDSIMD_DENORMALBITS (1 << 24)
+static inline unsigned int readFloatingPointControl() { uint64_t value; __asm__ __volatile__("mrs %0, fpcr" : "=r"(value)); return (unsigned int)value; }
+static inline void writeFloatingPointControl(unsigned int value) { uint64_t v = value; __asm__ __volatile__("msr fpcr, %0" : : "r"(v)); }
+#elif defined(__arm__) && defined(__ARM_FP)
+#define SUPERPOWEREDSIMD_DENORMALBITS (1 << 24)
+static inline unsigned int readFloatingPointControl() { unsigned int value; __asm__ __volatile__("vmrs %0, fpscr" : "=r"(value)); return value; }
+static inline void writeFloatingPointControl(unsigned int value) { __asm__ __volatile__("vmsr fpscr, %0" : : "r"(value)); }
+#else
+#define SUPERPOWEREDSIMD_DENORMALBITS 0
+static inline unsigned int readFloatingPointControl() { return 0; }
+static inline void writeFloatingPointControl(unsigned int) {}
+#endif
+
+SuperpoweredSIMDDenormalGuard::SuperpoweredSIMDDenormalGuard() {
+    previous = readFloatingPointControl();
+    if ((previous & SUPERPOWEREDSIMD_DENORMALBITS) != SUPERPOWEREDSIMD_DENORMALBITS) writeFloatingPointControl(previous | SUPERPOWEREDSIMD_DENORMALBITS);
+}
+
+SuperpoweredSIMDDenormalGuard::~SuperpoweredSIMDDenormalGuard() {
+    if ((previous & SUPERPOWEREDSIMD_DENORMALBITS) != SUPERPOWEREDSIMD_DENORMALBITS) writeFloatingPointControl(previous);
+}
+
+void SuperpoweredSIMDFloatToHalf(float *input, unsigned short int *output, unsigned int numberOfValues) {
+    kernels()->floatToHalf(input, output, numberOfValues);
+}
+
+void SuperpoweredSIMDHalfToFloat(unsigned short int *input, float *output, unsigned int numberOfValues) {
+    kernels()->halfToFloat(input, output, numberOfValues);
+}
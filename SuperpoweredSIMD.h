@@ -0,0 +1,605 @@
+#ifndef Header_SuperpoweredSIMD
+#define Header_SuperpoweredSIMD
+
+/**
+ @file SuperpoweredSIMD.h
+ @brief Runtime dispatched versions of the SuperpoweredSimple.h functions.
+
+ The SuperpoweredSimple.h functions in the library have one code path per CPU architecture.
+ The functions here do the same, but pick the widest vector unit of the CPU at runtime: SSE2, AVX2 or AVX-512 on x86.
+ The CPU is detected with CPUID at the first call, the operating system's support for the wide registers is checked too.
+ On other CPUs (ARM) the functions call the SuperpoweredSimple.h functions in the library.
+ The N-channel, planar, conversion, summing, metering and MP3 synthesis functions have no counterpart in the library, they run plain C on other CPUs.
+
+ Unlike SuperpoweredPeak(), these functions accept any number of values, there is no multiple of 8 limitation.
+ All functions are thread-safe and real-time safe, they don't allocate memory and don't block.
+ */
+
+/**
+ @brief Interleaved audio with this many channels or less is processed with vectors by the N-channel volume functions. Above this, the values are processed one by one.
+ */
+#define SUPERPOWEREDSIMD_MAXVECTORCHANNELS 32
+
+/**
+ @brief The maximum number of channels of a meter.
+ */
+#define SUPERPOWEREDSIMD_MAXMETERCHANNELS 32
+
+/**
+ @brief The length of the true peak interpolation filter of every phase, in samples (ITU-R BS.1770-4 Annex 2).
+ */
+#define SUPERPOWEREDSIMD_TRUEPEAKTAPS 12
+
+/**
+ @brief The number of channels of an MP3 synthesis state.
+ */
+#define SUPERPOWEREDSIMD_MP3CHANNELS 2
+
+/**
+ @brief The code paths.
+ */
+typedef enum SuperpoweredSIMDLevel {
+    SuperpoweredSIMDLevel_Generic = 0, ///< The SuperpoweredSimple.h functions in the library.
+    SuperpoweredSIMDLevel_SSE2 = 1,    ///< 128-bit vectors, every x86-64 CPU.
+    SuperpoweredSIMDLevel_AVX2 = 2,    ///< 256-bit vectors.
+    SuperpoweredSIMDLevel_AVX512 = 3   ///< 512-bit vectors (AVX-512F).
+} SuperpoweredSIMDLevel;
+
+/**
+ @brief Sample formats of the conversion functions. Integer formats are signed.
+ */
+typedef enum SuperpoweredSIMDFormat {
+    SuperpoweredSIMDFormat_Int8 = 0,   ///< 8-bit (signed char).
+    SuperpoweredSIMDFormat_Int16 = 1,  ///< 16-bit (short int).
+    SuperpoweredSIMDFormat_Int24 = 2,  ///< 24-bit packed, 3 bytes per value, little endian.
+    SuperpoweredSIMDFormat_Int32 = 3,  ///< 32-bit (int).
+    SuperpoweredSIMDFormat_Float32 = 4, ///< 32-bit floating point.
+    SuperpoweredSIMDFormat_Float16 = 5  ///< IEEE half precision floating point (unsigned short int), for storage. 11 bits of precision, not clipped.
+} SuperpoweredSIMDFormat;
+
+/**
+ @brief The state of a meter. Keeps the true peak and K-weighting filters continuous from buffer to buffer. Set up with SuperpoweredSIMDMeterInit(), don't change the fields.
+
+ @param filters The K-weighting filter states of every channel.
+ @param coefficients The K-weighting filter coefficients, b0, b1, b2, a1, a2 of both stages.
+ @param history The last SUPERPOWEREDSIMD_TRUEPEAKTAPS - 1 samples, interleaved.
+ @param numChannels The number of channels.
+ */
+typedef struct SuperpoweredSIMDMeterState {
+    double filters[SUPERPOWEREDSIMD_MAXMETERCHANNELS][4];
+    double coefficients[10];
+    float history[(SUPERPOWEREDSIMD_TRUEPEAKTAPS - 1) * SUPERPOWEREDSIMD_MAXMETERCHANNELS];
+    unsigned int numChannels;
+} SuperpoweredSIMDMeterState;
+
+/**
+ @brief The state of the MP3 IMDCT and polyphase synthesis of a stream, with the tables. Set up with SuperpoweredSIMDMP3Init(), don't change the fields.
+
+ @param imdct36 The long block IMDCT matrix.
+ @param imdct12 The short block IMDCT matrix.
+ @param windows The IMDCT windows of the block types. The short window (block type 2) is 12 values.
+ @param synthesis The polyphase matrixing matrix.
+ @param window The synthesis window.
+ @param overlap The second half of the previous granule's IMDCT output of every channel, [time slot][subband].
+ @param v The synthesis history of every channel, circular.
+ @param vOffset The beginning of the synthesis history of every channel.
+ */
+typedef struct SuperpoweredSIMDMP3State {
+    float imdct36[18 * 18], imdct12[6 * 6], windows[4 * 36], synthesis[32 * 32], window[512];
+    float overlap[SUPERPOWEREDSIMD_MP3CHANNELS][18 * 32];
+    float v[SUPERPOWEREDSIMD_MP3CHANNELS][1024];
+    unsigned int vOffset[SUPERPOWEREDSIMD_MP3CHANNELS];
+} SuperpoweredSIMDMP3State;
+
+/**
+ @fn SuperpoweredSIMDGetSupportedLevel();
+ @return Returns with the best code path of the CPU and the operating system.
+ */
+SuperpoweredSIMDLevel SuperpoweredSIMDGetSupportedLevel();
+
+/**
+ @fn SuperpoweredSIMDGetLevel();
+ @return Returns with the code path the functions below are running now.
+ */
+SuperpoweredSIMDLevel SuperpoweredSIMDGetLevel();
+
+/**
+ @fn SuperpoweredSIMDSetLevel(SuperpoweredSIMDLevel level);
+ @brief Forces a code path, for benchmarking and testing. Thread-safe, but don't call it while audio is processing if you want consistent results.
+
+ @return False if the CPU doesn't support the code path. The current code path stays then.
+ @param level The code path. Every level up to SuperpoweredSIMDGetSupportedLevel() can be set.
+ */
+bool SuperpoweredSIMDSetLevel(SuperpoweredSIMDLevel level);
+
+/**
+ @fn SuperpoweredSIMDLevelName(SuperpoweredSIMDLevel level);
+ @return Returns with the name of a code path, such as "AVX2".
+ */
+const char *SuperpoweredSIMDLevelName(SuperpoweredSIMDLevel level);
+
+/**
+ @fn SuperpoweredSIMDVolume(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfSamples);
+ @brief Same as SuperpoweredVolume(). Applies volume on a single stereo interleaved buffer.
+
+ @param input Input buffer.
+ @param output Output buffer. Can be equal to input (in-place processing).
+ @param volumeStart Volume for the first sample.
+ @param volumeEnd Volume for the last sample. Volume will be smoothly calculated between start end end.
+ @param numberOfSamples The number of samples to process.
+ */
+void SuperpoweredSIMDVolume(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfSamples);
+
+/**
+ @fn SuperpoweredSIMDChangeVolume(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfSamples);
+ @brief Same as SuperpoweredChangeVolume(). Applies volume on a single stereo interleaved buffer.
+
+ @param input Input buffer.
+ @param output Output buffer. Can be equal to input (in-place processing).
+ @param volumeStart Volume for the first sample.
+ @param volumeChange Change volume by this amount for every sample.
+ @param numberOfSamples The number of samples to process.
+ */
+void SuperpoweredSIMDChangeVolume(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfSamples);
+
+/**
+ @fn SuperpoweredSIMDVolumeAdd(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfSamples);
+ @brief Same as SuperpoweredVolumeAdd(). Applies volume on a single stereo interleaved buffer and adds it to the audio in the output buffer.
+
+ @param input Input buffer.
+ @param output Output buffer.
+ @param volumeStart Volume for the first sample.
+ @param volumeEnd Volume for the last sample. Volume will be smoothly calculated between start end end.
+ @param numberOfSamples The number of samples to process.
+ */
+void SuperpoweredSIMDVolumeAdd(float *input, float *output, float volumeStart, float volumeEnd, unsigned int numberOfSamples);
+
+/**
+ @fn SuperpoweredSIMDChangeVolumeAdd(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfSamples);
+ @brief Same as SuperpoweredChangeVolumeAdd(). Applies volume on a single stereo interleaved buffer and adds it to the audio in the output buffer.
+
+ @param input Input buffer.
+ @param output Output buffer.
+ @param volumeStart Volume for the first sample.
+ @param volumeChange Change volume by this amount for every sample.
+ @param numberOfSamples The number of samples to process.
+ */
+void SuperpoweredSIMDChangeVolumeAdd(float *input, float *output, float volumeStart, float volumeChange, unsigned int numberOfSamples);
+
+/**
+ @fn SuperpoweredSIMDPeak(float *input, unsigned int numberOfValues);
+ @return Same as SuperpoweredPeak(). Returns with the peak value.
+
+ @param input An array of floating point values.
+ @param numberOfValues The number of values to process. (2 * numberOfSamples for stereo input) Any number.
+ */
+float SuperpoweredSIMDPeak(float *input, unsigned int numberOfValues);
+
+/**
+ @fn SuperpoweredSIMDShortIntToFloat(short int *input, float *output, unsigned int numberOfSamples, float *peaks);
+ @brief Same as SuperpoweredShortIntToFloat(). Converts a stereo interleaved 16-bit signed integer input to stereo interleaved 32-bit float output.
+
+ @param input Stereo interleaved 16-bit input.
+ @param output Stereo interleaved 32-bit output.
+ @param numberOfSamples The number of samples to process.
+ @param peaks Peak value result (2 floats: left peak, right peak).
+ */
+void SuperpoweredSIMDShortIntToFloat(short int *input, float *output, unsigned int numberOfSamples, float *peaks);
+
+/**
+ @fn SuperpoweredSIMDShortIntToFloat(short int *input, float *output, unsigned int numberOfSamples, unsigned int numChannels);
+ @brief Same as SuperpoweredShortIntToFloat(). Converts 16-bit signed integer input to 32-bit float output.
+
+ @param input Input buffer.
+ @param output Output buffer.
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels. One sample may be 1 value (1 channels) or N values (N channels).
+ */
+void SuperpoweredSIMDShortIntToFloat(short int *input, float *output, unsigned int numberOfSamples, unsigned int numChannels = 2);
+
+/**
+ @fn SuperpoweredSIMDFloatToShortInt(float *input, short int *output, unsigned int numberOfSamples, unsigned int numChannels);
+ @brief Same as SuperpoweredFloatToShortInt(). Converts 32-bit float input to 16-bit signed integer output, with clipping.
+
+ @param input Input buffer.
+ @param output Output buffer.
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels. One sample may be 1 value (1 channels) or N values (N channels).
+ */
+void SuperpoweredSIMDFloatToShortInt(float *input, short int *output, unsigned int numberOfSamples, unsigned int numChannels = 2);
+
+/**
+ @fn SuperpoweredSIMDInterleave(float *left, float *right, float *output, unsigned int numberOfSamples);
+ @brief Same as SuperpoweredInterleave(). Makes an interleaved output from two input channels.
+
+ @param left Input for left channel.
+ @param right Input for right channel.
+ @param output Interleaved output.
+ @param numberOfSamples The number of samples to process.
+ */
+void SuperpoweredSIMDInterleave(float *left, float *right, float *output, unsigned int numberOfSamples);
+
+/**
+ @fn SuperpoweredSIMDInterleaveAdd(float *left, float *right, float *output, unsigned int numberOfSamples);
+ @brief Same as SuperpoweredInterleaveAdd(). Makes an interleaved audio from two input channels and adds the result to the output.
+
+ @param left Input for left channel.
+ @param right Input for right channel.
+ @param output Interleaved output.
+ @param numberOfSamples The number of samples to process.
+ */
+void SuperpoweredSIMDInterleaveAdd(float *left, float *right, float *output, unsigned int numberOfSamples);
+
+/**
+ @fn SuperpoweredSIMDDeInterleave(float *input, float *left, float *right, unsigned int numberOfSamples);
+ @brief Same as SuperpoweredDeInterleave(). Deinterleaves an interleaved input.
+
+ @param input Interleaved input.
+ @param left Output for left channel.
+ @param right Output for right channel.
+ @param numberOfSamples The number of samples to process.
+ */
+void SuperpoweredSIMDDeInterleave(float *input, float *left, float *right, unsigned int numberOfSamples);
+
+/**
+ @fn SuperpoweredSIMDDeInterleaveAdd(float *input, float *left, float *right, unsigned int numberOfSamples);
+ @brief Same as SuperpoweredDeInterleaveAdd(). Deinterleaves an interleaved input and adds the results to the output channels.
+
+ @param input Interleaved input.
+ @param left Output for left channel.
+ @param right Output for right channel.
+ @param numberOfSamples The number of samples to process.
+ */
+void SuperpoweredSIMDDeInterleaveAdd(float *input, float *left, float *right, unsigned int numberOfSamples);
+
+/**
+ @fn SuperpoweredSIMDHasNonFinite(float *buffer, unsigned int numberOfValues);
+ @brief Same as SuperpoweredHasNonFinite(). Checks if the samples has non-valid samples, such as infinity or NaN (not a number).
+
+ @param buffer The buffer to check.
+ @param numberOfValues Number of values in buffer. For stereo buffers, multiply by two!
+ */
+bool SuperpoweredSIMDHasNonFinite(float *buffer, unsigned int numberOfValues);
+
+/**
+ @fn SuperpoweredSIMDAdd1(float *input, float *output, unsigned int numberOfValues);
+ @brief Same as SuperpoweredAdd1(). Adds the input to the output: output[n] += input[n].
+ */
+void SuperpoweredSIMDAdd1(float *input, float *output, unsigned int numberOfValues);
+
+/**
+ @fn SuperpoweredSIMDAdd2(float *inputA, float *inputB, float *output, unsigned int numberOfValues);
+ @brief Same as SuperpoweredAdd2(). Adds two inputs to the output: output[n] += inputA[n] + inputB[n].
+ */
+void SuperpoweredSIMDAdd2(float *inputA, float *inputB, float *output, unsigned int numberOfValues);
+
+/**
+ @fn SuperpoweredSIMDAdd4(float *inputA, float *inputB, float *inputC, float *inputD, float *output, unsigned int numberOfValues);
+ @brief Same as SuperpoweredAdd4(). Adds four inputs to the output: output[n] += inputA[n] + inputB[n] + inputC[n] + inputD[n].
+ */
+void SuperpoweredSIMDAdd4(float *inputA, float *inputB, float *inputC, float *inputD, float *output, unsigned int numberOfValues);
+
+/**
+ @fn SuperpoweredSIMDVolumeN(float *input, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels);
+ @brief Applies volume on a single interleaved buffer with any number of channels, with a different volume for every channel.
+
+ @param input Input buffer.
+ @param output Output buffer. Can be equal to input (in-place processing).
+ @param volumeStart Volume for the first sample, numChannels values.
+ @param volumeEnd Volume for the last sample, numChannels values. Volume will be smoothly calculated between start end end.
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels. One sample is numChannels values.
+ */
+void SuperpoweredSIMDVolumeN(float *input, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels);
+
+/**
+ @fn SuperpoweredSIMDChangeVolumeN(float *input, float *output, float *volumeStart, float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels);
+ @brief Applies volume on a single interleaved buffer with any number of channels, with a different volume for every channel.
+
+ @param input Input buffer.
+ @param output Output buffer. Can be equal to input (in-place processing).
+ @param volumeStart Volume for the first sample, numChannels values.
+ @param volumeChange Change volume by this amount for every sample, numChannels values.
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels. One sample is numChannels values.
+ */
+void SuperpoweredSIMDChangeVolumeN(float *input, float *output, float *volumeStart, float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels);
+
+/**
+ @fn SuperpoweredSIMDVolumeAddN(float *input, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels);
+ @brief Applies volume on a single interleaved buffer with any number of channels and adds it to the audio in the output buffer.
+
+ @param input Input buffer.
+ @param output Output buffer.
+ @param volumeStart Volume for the first sample, numChannels values.
+ @param volumeEnd Volume for the last sample, numChannels values. Volume will be smoothly calculated between start end end.
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels. One sample is numChannels values.
+ */
+void SuperpoweredSIMDVolumeAddN(float *input, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels);
+
+/**
+ @fn SuperpoweredSIMDChangeVolumeAddN(float *input, float *output, float *volumeStart, float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels);
+ @brief Applies volume on a single interleaved buffer with any number of channels and adds it to the audio in the output buffer.
+
+ @param input Input buffer.
+ @param output Output buffer.
+ @param volumeStart Volume for the first sample, numChannels values.
+ @param volumeChange Change volume by this amount for every sample, numChannels values.
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels. One sample is numChannels values.
+ */
+void SuperpoweredSIMDChangeVolumeAddN(float *input, float *output, float *volumeStart, float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels);
+
+/**
+ @fn SuperpoweredSIMDVolumePlanar(float **inputs, float **outputs, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels);
+ @brief Applies volume on planar (non-interleaved) audio, with a different volume for every channel.
+
+ @param inputs Input buffers, one for every channel.
+ @param outputs Output buffers, one for every channel. Can be equal to inputs (in-place processing).
+ @param volumeStart Volume for the first sample, numChannels values.
+ @param volumeEnd Volume for the last sample, numChannels values. Volume will be smoothly calculated between start end end.
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels.
+ */
+void SuperpoweredSIMDVolumePlanar(float **inputs, float **outputs, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels);
+
+/**
+ @fn SuperpoweredSIMDChangeVolumePlanar(float **inputs, float **outputs, float *volumeStart, float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels);
+ @brief Applies volume on planar (non-interleaved) audio, with a different volume for every channel.
+
+ @param inputs Input buffers, one for every channel.
+ @param outputs Output buffers, one for every channel. Can be equal to inputs (in-place processing).
+ @param volumeStart Volume for the first sample, numChannels values.
+ @param volumeChange Change volume by this amount for every sample, numChannels values.
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels.
+ */
+void SuperpoweredSIMDChangeVolumePlanar(float **inputs, float **outputs, float *volumeStart, float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels);
+
+/**
+ @fn SuperpoweredSIMDVolumeAddPlanar(float **inputs, float **outputs, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels);
+ @brief Applies volume on planar (non-interleaved) audio and adds it to the audio in the output buffers.
+
+ @param inputs Input buffers, one for every channel.
+ @param outputs Output buffers, one for every channel.
+ @param volumeStart Volume for the first sample, numChannels values.
+ @param volumeEnd Volume for the last sample, numChannels values. Volume will be smoothly calculated between start end end.
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels.
+ */
+void SuperpoweredSIMDVolumeAddPlanar(float **inputs, float **outputs, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels);
+
+/**
+ @fn SuperpoweredSIMDChangeVolumeAddPlanar(float **inputs, float **outputs, float *volumeStart, float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels);
+ @brief Applies volume on planar (non-interleaved) audio and adds it to the audio in the output buffers.
+
+ @param inputs Input buffers, one for every channel.
+ @param outputs Output buffers, one for every channel.
+ @param volumeStart Volume for the first sample, numChannels values.
+ @param volumeChange Change volume by this amount for every sample, numChannels values.
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels.
+ */
+void SuperpoweredSIMDChangeVolumeAddPlanar(float **inputs, float **outputs, float *volumeStart, float *volumeChange, unsigned int numberOfSamples, unsigned int numChannels);
+
+/**
+ @fn SuperpoweredSIMDInterleaveN(float **inputs, float *output, unsigned int numberOfSamples, unsigned int numChannels);
+ @brief Makes an interleaved output from any number of input channels.
+
+ @param inputs Input buffers, one for every channel.
+ @param output Interleaved output.
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels.
+ */
+void SuperpoweredSIMDInterleaveN(float **inputs, float *output, unsigned int numberOfSamples, unsigned int numChannels);
+
+/**
+ @fn SuperpoweredSIMDDeInterleaveN(float *input, float **outputs, unsigned int numberOfSamples, unsigned int numChannels);
+ @brief Deinterleaves an interleaved input with any number of channels.
+
+ @param input Interleaved input.
+ @param outputs Output buffers, one for every channel.
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels.
+ */
+void SuperpoweredSIMDDeInterleaveN(float *input, float **outputs, unsigned int numberOfSamples, unsigned int numChannels);
+
+/**
+ @fn SuperpoweredSIMDConvert(void *input, SuperpoweredSIMDFormat inputFormat, void *output, SuperpoweredSIMDFormat outputFormat, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels, float *peaks, float *rms);
+ @brief Converts interleaved audio between sample formats, applies volume and measures every channel, in one pass over the memory.
+
+ Replaces a conversion, a volume and a peak pass at an audio I/O boundary, such as SuperpoweredShortIntToFloat() + SuperpoweredVolume() + SuperpoweredPeak().
+ Integer output is clipped. The meters measure the floating point audio after volume, before clipping.
+
+ @param input Input buffer.
+ @param inputFormat Input sample format.
+ @param output Output buffer. Can be equal to input if the formats have the same size.
+ @param outputFormat Output sample format.
+ @param volumeStart Volume for the first sample, numChannels values. NULL means 1.0 for every channel.
+ @param volumeEnd Volume for the last sample, numChannels values. Volume will be smoothly calculated between start end end. NULL means no change (volumeStart for every sample).
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels. One sample is numChannels values.
+ @param peaks Peak value result for every channel (numChannels floats). Can be NULL.
+ @param rms RMS value result for every channel (numChannels floats). Can be NULL.
+ */
+void SuperpoweredSIMDConvert(void *input, SuperpoweredSIMDFormat inputFormat, void *output, SuperpoweredSIMDFormat outputFormat, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels, float *peaks, float *rms);
+
+/**
+ @fn SuperpoweredSIMDToFloat(void *input, SuperpoweredSIMDFormat inputFormat, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels, float *peaks, float *rms);
+ @brief Converts integer (or floating point) audio input to floating point with volume and metering in one pass. Same as SuperpoweredSIMDConvert() with floating point output.
+ */
+void SuperpoweredSIMDToFloat(void *input, SuperpoweredSIMDFormat inputFormat, float *output, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels, float *peaks, float *rms);
+
+/**
+ @fn SuperpoweredSIMDFromFloat(float *input, void *output, SuperpoweredSIMDFormat outputFormat, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels, float *peaks, float *rms);
+ @brief Converts floating point audio to integer (or floating point) audio output with volume and metering in one pass. Same as SuperpoweredSIMDConvert() with floating point input.
+ */
+void SuperpoweredSIMDFromFloat(float *input, void *output, SuperpoweredSIMDFormat outputFormat, float *volumeStart, float *volumeEnd, unsigned int numberOfSamples, unsigned int numChannels, float *peaks, float *rms);
+
+/**
+ @fn SuperpoweredSIMDAddN(float **inputs, float *gainsStart, float *gainsEnd, float *output, unsigned int numberOfSamples, unsigned int numChannels, unsigned int numInputs);
+ @brief Adds any number of inputs to the output with a gain for every input: output[n] += inputs[0][n] * gain[0] + inputs[1][n] * gain[1] + ...
+
+ The output is processed in small tiles, and all inputs are added to a tile before moving on. The output is read and written once, regardless of the number of inputs.
+
+ @param inputs Input buffers, numInputs pointers. Every input is interleaved with numChannels channels.
+ @param gainsStart Gain for the first sample, numInputs values. NULL means 1.0 for every input.
+ @param gainsEnd Gain for the last sample, numInputs values. Gain will be smoothly calculated between start end end. NULL means no change (gainsStart for every sample).
+ @param output Output buffer, interleaved with numChannels channels.
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels. One sample is numChannels values.
+ @param numInputs The number of inputs.
+ */
+void SuperpoweredSIMDAddN(float **inputs, float *gainsStart, float *gainsEnd, float *output, unsigned int numberOfSamples, unsigned int numChannels, unsigned int numInputs);
+
+/**
+ @fn SuperpoweredSIMDMeterInit(SuperpoweredSIMDMeterState *state, unsigned int samplerate, unsigned int numChannels);
+ @brief Sets up a meter and clears its history. Call it again to reset the meter, or when the sample rate changes.
+
+ @return False if numChannels is 0 or more than SUPERPOWEREDSIMD_MAXMETERCHANNELS.
+ @param state The meter.
+ @param samplerate The sample rate in Hz.
+ @param numChannels The number of channels.
+ */
+bool SuperpoweredSIMDMeterInit(SuperpoweredSIMDMeterState *state, unsigned int samplerate, unsigned int numChannels);
+
+/**
+ @fn SuperpoweredSIMDMeter(SuperpoweredSIMDMeterState *state, float *input, unsigned int numberOfSamples, float *peaks, float *sumSquares, float *truePeaks, float *loudness);
+ @brief Measures every channel of interleaved audio in one pass: peak, sum of squares, true peak and K-weighted loudness.
+
+ The true peak is the highest absolute value of the audio oversampled 4x with the ITU-R BS.1770-4 interpolation filter, and never less than the peak.
+ The loudness is the sum of squares of the K-weighted (ITU-R BS.1770-4) audio. Add the loudness and the number of samples of 400 ms (momentary) or 3 s (short-term) of buffers, then pass the sums to SuperpoweredSIMDLoudness().
+ Both filters continue in the next call, so pass the buffers of a stream in order with the same state.
+
+ @param state The meter.
+ @param input Input buffer, interleaved with the meter's number of channels.
+ @param numberOfSamples The number of samples to process.
+ @param peaks Peak value result for every channel. Can be NULL.
+ @param sumSquares Sum of squares result for every channel. Can be NULL.
+ @param truePeaks True peak result for every channel. Can be NULL, the oversampling is skipped then.
+ @param loudness K-weighted sum of squares result for every channel. Can be NULL, the K-weighting is skipped then. Don't switch between NULL and not NULL on the same state, the filters would continue from an old state.
+ */
+void SuperpoweredSIMDMeter(SuperpoweredSIMDMeterState *state, float *input, unsigned int numberOfSamples, float *peaks, float *sumSquares, float *truePeaks, float *loudness);
+
+/**
+ @fn SuperpoweredSIMDLoudness(float *loudness, unsigned int numberOfSamples, unsigned int numChannels, float *channelWeights);
+ @return Returns with the loudness in LUFS (LKFS), or -INFINITY for silence.
+
+ @param loudness The K-weighted sums of squares of every channel, from SuperpoweredSIMDMeter().
+ @param numberOfSamples The number of samples the sums were taken from.
+ @param numChannels The number of channels.
+ @param channelWeights The weight of every channel: 1.0 for front channels, 1.41 for the surround channels, 0 for the LFE channel. NULL means 1.0 for every channel.
+ */
+float SuperpoweredSIMDLoudness(float *loudness, unsigned int numberOfSamples, unsigned int numChannels, float *channelWeights);
+
+/**
+ @fn SuperpoweredSIMDFloatToHalf(float *input, unsigned short int *output, unsigned int numberOfValues);
+ @brief Converts floating point audio to IEEE half precision (float16), rounding to nearest even. Uses F16C on x86 CPUs with AVX2.
+
+ Half precision audio takes half the memory of 32-bit floating point, with 11 bits of precision (about 66 dB signal to noise ratio at full scale, more at lower levels, as floating point). Good for caches and long buffers.
+ Store them in SuperpoweredAudiobufferPool buffers of numberOfValues * 2 bytes. SuperpoweredSIMDConvert() with SuperpoweredSIMDFormat_Float16 converts with volume and metering too.
+
+ @param input Input buffer.
+ @param output Output buffer. Values above 65504 become infinity.
+ @param numberOfValues The number of values to convert.
+ */
+void SuperpoweredSIMDFloatToHalf(float *input, unsigned short int *output, unsigned int numberOfValues);
+
+/**
+ @fn SuperpoweredSIMDHalfToFloat(unsigned short int *input, float *output, unsigned int numberOfValues);
+ @brief Converts IEEE half precision (float16) audio to floating point. Exact, every half value has a floating point value.
+
+ @param input Input buffer.
+ @param output Output buffer.
+ @param numberOfValues The number of values to convert.
+ */
+void SuperpoweredSIMDHalfToFloat(unsigned short int *input, float *output, unsigned int numberOfValues);
+
+/**
+ @fn SuperpoweredSIMDScrub(float *buffer, unsigned int numberOfSamples, unsigned int numChannels, bool holdLastGood, unsigned int *firstIndex);
+ @brief Repairs interleaved audio in place, in one pass: replaces infinity and NaN values and flushes denormals to zero.
+
+ Use it instead of SuperpoweredHasNonFinite() and a repair loop. Clean parts of the buffer are only read, not written.
+
+ @return The number of infinity and NaN values replaced.
+ @param buffer The buffer.
+ @param numberOfSamples The number of samples to process.
+ @param numChannels The number of channels. One sample is numChannels values.
+ @param holdLastGood Replace infinity and NaN with the last good value of the same channel, instead of zero. Zero at the beginning of the buffer.
+ @param firstIndex Returns with the index of the first infinity or NaN value, counted in values (not samples), or numberOfSamples * numChannels if there was none. Can be NULL.
+ */
+unsigned int SuperpoweredSIMDScrub(float *buffer, unsigned int numberOfSamples, unsigned int numChannels, bool holdLastGood, unsigned int *firstIndex);
+
+/**
+ @fn SuperpoweredSIMDMP3Init(SuperpoweredSIMDMP3State *state);
+ @brief Sets up an MP3 synthesis state and clears the history of every channel. Call it again to reset the history, after seeking for example.
+
+ The MP3 functions are standalone floating point requantization, IMDCT and polyphase synthesis stages of an MP3 (MPEG-1/2 layer 3) decoder, for decoders built on this code.
+ SuperpoweredMP3FloatDecoder is built on them, SuperpoweredFloatDecoder decodes MP3 files with it. SuperpoweredDecoder has its own fixed-point code in the library and doesn't use them, so they don't change its decoding speed.
+ Tests/SuperpoweredSIMDMP3Benchmark.cpp measures the stages one by one, Tests/SuperpoweredMP3FloatDecoderTest.cpp the decode throughput of SuperpoweredMP3FloatDecoder on every code path.
+ The synthesis window is the D[] table of ISO/IEC 11172-3 Annex B, the output of SuperpoweredSIMDMP3Synthesis() is in the -1.0 to 1.0 range.
+
+ @param state The state.
+ */
+void SuperpoweredSIMDMP3Init(SuperpoweredSIMDMP3State *state);
+
+/**
+ @fn SuperpoweredSIMDMP3Dequantize(int *input, float *output, unsigned int numberOfValues, float multiplier);
+ @brief MP3 requantization: output[n] = sign(input[n]) * |input[n]|^(4/3) * multiplier.
+
+ The power is calculated with vectors (not a table), the relative error is below 1e-6.
+
+ @param input The Huffman decoded values. The absolute values must be 8206 or less.
+ @param output Output buffer.
+ @param numberOfValues The number of values to process.
+ @param multiplier The gain of the values: 2^(global gain and scale factors / 4), as the standard describes.
+ */
+void SuperpoweredSIMDMP3Dequantize(int *input, float *output, unsigned int numberOfValues, float multiplier);
+
+/**
+ @fn SuperpoweredSIMDMP3IMDCT(SuperpoweredSIMDMP3State *state, unsigned int channel, float *input, float *output, int blockType, bool mixedBlock);
+ @brief The IMDCT, windowing and overlap-add of one granule of one channel, with the frequency inversion of the odd subbands. The vector code paths process several subbands at once.
+
+ @param state The state.
+ @param channel The channel, 0 or 1.
+ @param input 576 frequency lines after the alias reduction, 18 lines of every subband. In short blocks the lines of the 3 windows are interleaved: line k of window w is at 3 * k + w.
+ @param output 576 values: 18 time slots of 32 subband samples, the input of SuperpoweredSIMDMP3Synthesis(). Can not be the same as input.
+ @param blockType The block type: 0 (normal), 1 (start), 2 (short) or 3 (stop).
+ @param mixedBlock True for mixed blocks: the lowest 2 subbands are long blocks with the normal window.
+ */
+void SuperpoweredSIMDMP3IMDCT(SuperpoweredSIMDMP3State *state, unsigned int channel, float *input, float *output, int blockType, bool mixedBlock);
+
+/**
+ @fn SuperpoweredSIMDMP3Synthesis(SuperpoweredSIMDMP3State *state, unsigned int channel, float *input, float *output, unsigned int numberOfSlots);
+ @brief The polyphase synthesis filterbank of one channel: every time slot of 32 subband samples becomes 32 audio samples.
+
+ @param state The state.
+ @param channel The channel, 0 or 1.
+ @param input Subband samples, numberOfSlots * 32 values.
+ @param output Audio output, numberOfSlots * 32 samples of the channel. Interleave the channels with SuperpoweredSIMDInterleave().
+ @param numberOfSlots The number of time slots. 18 for one granule.
+ */
+void SuperpoweredSIMDMP3Synthesis(SuperpoweredSIMDMP3State *state, unsigned int channel, float *input, float *output, unsigned int numberOfSlots = 18);
+
+/**
+ @brief Flushes denormals to zero on the current thread while it exists, then restores the previous mode. FTZ and DAZ on x86, FZ on ARM.
+
+ The tails of feedback effects such as SuperpoweredEcho and SuperpoweredReverb decay into denormals, which are extremely slow on many CPUs. Create it on the stack around any SuperpoweredFX::process():
+ { SuperpoweredSIMDDenormalGuard guard; reverb->process(input, output, numberOfSamples); }
+
+ Real-time safe, it only writes the floating point control register, and only if the mode is not set already.
+ */
+class SuperpoweredSIMDDenormalGuard {
+public:
+    SuperpoweredSIMDDenormalGuard();
+    ~SuperpoweredSIMDDenormalGuard();
+
+private:
+    unsigned int previous;
+
+    SuperpoweredSIMDDenormalGuard(const SuperpoweredSIMDDenormalGuard &);
+    SuperpoweredSIMDDenormalGuard &operator=(const SuperpoweredSIMDDenormalGuard &);
+};
+
+#endif
@@ -0,0 +1,333 @@
+#include "SuperpoweredSeekIndex.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SEEKINDEX_VERSION 2
+#define MP3_MAXRESERVOIRBYTES 511 // main_data_begin is 9 bits.
+#define MP3_MAXSIDEBYTES 38 // Header, CRC and MPEG-1 stereo side info: the bytes of a frame that are not main data.
+
+typedef struct seekIndexEntry {
+    int64_t byteOffset, samplePosition;
+} seekIndexEntry;
+
+// The blob layout. Every field is little-endian at a fixed byte offset, so the blob is the same on every ABI and has no padding.
+#define BLOB_MAGIC 0 // "SPSI"
+#define BLOB_VERSION 4 // uint32
+#define BLOB_KIND 8 // uint32
+#define BLOB_SAMPLERATE 12 // uint32
+#define BLOB_SAMPLESPERFRAME 16 // uint32
+#define BLOB_FRAMESPERENTRY 20 // uint32
+#define BLOB_NUMFRAMES 24 // uint32
+#define BLOB_NUMENTRIES 28 // uint32
+#define BLOB_FILEBYTES 32 // int64
+#define BLOB_DURATIONSAMPLES 40 // int64
+#define BLOB_HEADERBYTES 48 // The entries follow: byteOffset (int64), samplePosition (int64).
+#define BLOB_ENTRYBYTES 16
+
+typedef struct seekIndexInternals {
+    seekIndexEntry *entries;
+    unsigned int numEntries, capacity, framesPerEntry;
+} seekIndexInternals;
+
+// A parsed frame header. The version tag is compared between frames to tell real frames from random sync patterns.
+typedef struct frameHeader {
+    unsigned int bytes, samples, samplerate, versionTag;
+} frameHeader;
+
+static const unsigned short mp3Bitrates[5][16] = { // kbps. MPEG-1 layer 1, 2, 3, then MPEG-2/2.5 layer 1, and layer 2 and 3.
+    { 0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448, 0 },
+    { 0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 0 },
+    { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0 },
+    { 0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256, 0 },
+    { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0 }
+};
+static const unsigned int mp3Samplerates[3] = { 44100, 48000, 32000 };
+static const unsigned int aacSamplerates[13] = { 96000, 88200, 64000, 48000, 44100, 32000, 24000, 22050, 16000, 12000, 11025, 8000, 7350 };
+
+static bool parseMP3Header(const unsigned char *p, frameHeader *header) {
+    if ((p[0] != 0xff) || ((p[1] & 0xe0) != 0xe0)) return false;
+    unsigned int version = (p[1] >> 3) & 3, layer = (p[1] >> 1) & 3, bitrateIndex = p[2] >> 4, samplerateIndex = (p[2] >> 2) & 3, padding = (p[2] >> 1) & 1;
+    if ((version == 1) || (layer == 0) || (bitrateIndex == 0) || (bitrateIndex == 15) || (samplerateIndex == 3)) return false; // Reserved or free format.
+
+    bool mpeg1 = (version == 3);
+    layer = 4 - layer;
+    unsigned int bitrate = mp3Bitrates[mpeg1 ? layer - 1 : ((layer == 1) ? 3 : 4)][bitrateIndex] * 1000;
+    header->samplerate = mp3Samplerates[samplerateIndex] >> (mpeg1 ? 0 : ((version == 2) ? 1 : 2));
+
+    if (layer == 1) {
+        header->samples = 384;
+        header->bytes = (12 * bitrate / header->samplerate + padding) * 4;
+    } else if ((layer == 3) && !mpeg1) {
+        header->samples = 576;
+        header->bytes = 72 * bitrate / header->samplerate + padding;
+    } else {
+        header->samples = 1152;
+        header->bytes = 144 * bitrate / header->samplerate + padding;
+    }
+    header->versionTag = (p[1] & 0x1e) | (samplerateIndex << 5);
+    return true;
+}
+
+static bool parseADTSHeader(const unsigned char *p, frameHeader *header) {
+    if ((p[0] != 0xff) || ((p[1] & 0xf6) != 0xf0)) return false; // Sync, layer 0.
+    unsigned int samplerateIndex = (p[2] >> 2) & 15;
+    if (samplerateIndex > 12) return false;
+    header->bytes = ((p[3] & 3) << 11) | (p[4] << 3) | (p[5] >> 5);
+    if (header->bytes < 7) return false;
+    header->samples = ((p[6] & 3) + 1) * 1024;
+    header->samplerate = aacSamplerates[samplerateIndex];
+    header->versionTag = (p[2] & 0xfc) | ((p[3] >> 6) << 8); // Profile, samplerate, channels.
+    return true;
+}
+
+static bool parseHeader(SuperpoweredDecoder_Kind kind, const unsigned char *p, frameHeader *header) {
+    return (kind == SuperpoweredDecoder_MP3) ? parseMP3Header(p, header) : parseADTSHeader(p, header);
+}
+
+// A frame is accepted if the next one follows right after it, with the same version, or it's the last one.
+static bool isFrame(SuperpoweredDecoder_Kind kind, const unsigned char *p, const unsigned char *end, frameHeader *header) {
+    if ((end - p < 7) || !parseHeader(kind, p, header)) return false;
+    const unsigned char *next = p + header->bytes;
+    if (next > end) return false;
+    if (end - next < 7) return true;
+    frameHeader nextHeader;
+    return parseHeader(kind, next, &nextHeader) && (nextHeader.versionTag == header->versionTag);
+}
+
+// The Xing, Info or VBRI frame of VBR and LAME encoded files holds metadata, decoders skip it.
+static bool isMP3InfoFrame(const unsigned char *p, const frameHeader *header) {
+    bool mpeg1 = ((p[1] >> 3) & 3) == 3, mono = (p[3] >> 6) == 3;
+    unsigned int sideInfoBytes = mpeg1 ? (mono ? 17 : 32) : (mono ? 9 : 17);
+    if (header->bytes >= 4 + sideInfoBytes + 4) {
+        const unsigned char *tag = p + 4 + sideInfoBytes;
+        if (!memcmp(tag, "Xing", 4) || !memcmp(tag, "Info", 4)) return true;
+    }
+    return (header->bytes >= 40) && !memcmp(p + 36, "VBRI", 4);
+}
+
+static bool addEntry(seekIndexInternals *internals, int64_t byteOffset, int64_t samplePosition) {
+    if (internals->numEntries == internals->capacity) {
+        unsigned int capacity = internals->capacity ? internals->capacity * 2 : 1024;
+        seekIndexEntry *entries = (seekIndexEntry *)realloc(internals->entries, capacity * sizeof(seekIndexEntry));
+        if (!entries) return false;
+        internals->entries = entries;
+        internals->capacity = capacity;
+    }
+    internals->entries[internals->numEntries].byteOffset = byteOffset;
+    internals->entries[internals->numEntries].samplePosition = samplePosition;
+    internals->numEntries++;
+    return true;
+}
+
+static void clearIndex(SuperpoweredSeekIndex *index, seekIndexInternals *internals) {
+    internals->numEntries = 0;
+    index->samplerate = index->samplesPerFrame = index->numFrames = index->numEntries = 0;
+    index->durationSamples = index->fileBytes = 0;
+}
+
+SuperpoweredSeekIndex::SuperpoweredSeekIndex(unsigned int framesPerEntry) : kind(SuperpoweredDecoder_MP3), samplerate(0), samplesPerFrame(0), numFrames(0), numEntries(0), durationSamples(0), fileBytes(0) {
+    internals = new seekIndexInternals;
+    memset(internals, 0, sizeof(seekIndexInternals));
+    internals->framesPerEntry = framesPerEntry ? framesPerEntry : 1;
+}
+
+SuperpoweredSeekIndex::~SuperpoweredSeekIndex() {
+    free(internals->entries);
+    delete internals;
+}
+
+const char *SuperpoweredSeekIndex::build(const char *path) {
+    clearIndex(this, internals);
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return "Can't open file.";
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (st.st_size < 16)) {
+        close(fd);
+        return "Not a valid MP3 or AAC file.";
+    }
+    size_t mapBytes = (size_t)st.st_size;
+    unsigned char *map = (unsigned char *)mmap(NULL, mapBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return "Can't map file.";
+    madvise(map, mapBytes, MADV_SEQUENTIAL);
+
+    const char *error = buildMemory(map, mapBytes);
+    munmap(map, mapBytes);
+    return error;
+}
+
+const char *SuperpoweredSeekIndex::buildMemory(const void *data, size_t bytes) {
+    clearIndex(this, internals);
+    if (!data || (bytes < 16)) return "Not a valid MP3 or AAC file.";
+    const unsigned char *map = (const unsigned char *)data, *p = map, *end = map + bytes;
+    while ((end - p >= 10) && !memcmp(p, "ID3", 3)) { // ID3v2 tags, there may be more than one.
+        size_t tagBytes = 10 + (((p[6] & 0x7f) << 21) | ((p[7] & 0x7f) << 14) | ((p[8] & 0x7f) << 7) | (p[9] & 0x7f));
+        if (p[5] & 0x10) tagBytes += 10; // Footer.
+        if (tagBytes > (size_t)(end - p)) break;
+        p += tagBytes;
+    }
+
+    // Find the first frame to tell the format.
+    frameHeader header;
+    while ((end - p >= 7) && !isFrame(SuperpoweredDecoder_MP3, p, end, &header) && !isFrame(SuperpoweredDecoder_AAC, p, end, &header)) p++;
+    if (end - p < 7) return "Not a valid MP3 or AAC file.";
+    kind = parseADTSHeader(p, &header) ? SuperpoweredDecoder_AAC : SuperpoweredDecoder_MP3;
+    parseHeader(kind, p, &header);
+    samplerate = header.samplerate;
+    samplesPerFrame = header.samples;
+    unsigned int versionTag = header.versionTag;
+    if ((kind == SuperpoweredDecoder_MP3) && isMP3InfoFrame(p, &header)) p += header.bytes;
+
+    int64_t samplePosition = 0;
+    bool success = true;
+    while (end - p >= 7) {
+        if (!parseHeader(kind, p, &header) || (header.versionTag != versionTag) || (header.bytes > (size_t)(end - p))) {
+            // Lost sync (damaged data or a tag at the end), search for the next frame.
+            do p++; while ((end - p >= 7) && (!isFrame(kind, p, end, &header) || (header.versionTag != versionTag)));
+            continue;
+        }
+        if (!(numFrames % internals->framesPerEntry) && !addEntry(internals, (int64_t)(p - map), samplePosition)) {
+            success = false;
+            break;
+        }
+        numFrames++;
+        samplePosition += header.samples;
+        p += header.bytes;
+    }
+
+    if (!success || !numFrames) {
+        clearIndex(this, internals);
+        return success ? "Not a valid MP3 or AAC file." : "Out of memory.";
+    }
+    numEntries = internals->numEntries;
+    durationSamples = samplePosition;
+    fileBytes = (int64_t)bytes;
+    return NULL;
+}
+
+static void writeBlobValue(unsigned char *blob, size_t offset, uint64_t value, unsigned int bytes) {
+    for (unsigned int n = 0; n < bytes; n++) blob[offset + n] = (unsigned char)(value >> (n * 8));
+}
+
+static uint64_t readBlobValue(const unsigned char *blob, size_t offset, unsigned int bytes) {
+    uint64_t value = 0;
+    for (unsigned int n = bytes; n > 0; n--) value = (value << 8) | blob[offset + n - 1];
+    return value;
+}
+
+bool SuperpoweredSeekIndex::serialize(void **blob, size_t *bytes) {
+    if (!internals->numEntries) return false;
+    size_t blobBytes = BLOB_HEADERBYTES + (size_t)internals->numEntries * BLOB_ENTRYBYTES;
+    unsigned char *data = (unsigned char *)malloc(blobBytes);
+    if (!data) return false;
+
+    memcpy(data + BLOB_MAGIC, "SPSI", 4);
+    writeBlobValue(data, BLOB_VERSION, SEEKINDEX_VERSION, 4);
+    writeBlobValue(data, BLOB_KIND, kind, 4);
+    writeBlobValue(data, BLOB_SAMPLERATE, samplerate, 4);
+    writeBlobValue(data, BLOB_SAMPLESPERFRAME, samplesPerFrame, 4);
+    writeBlobValue(data, BLOB_FRAMESPERENTRY, internals->framesPerEntry, 4);
+    writeBlobValue(data, BLOB_NUMFRAMES, numFrames, 4);
+    writeBlobValue(data, BLOB_NUMENTRIES, internals->numEntries, 4);
+    writeBlobValue(data, BLOB_FILEBYTES, (uint64_t)fileBytes, 8);
+    writeBlobValue(data, BLOB_DURATIONSAMPLES, (uint64_t)durationSamples, 8);
+    for (unsigned int n = 0; n < internals->numEntries; n++) {
+        writeBlobValue(data, BLOB_HEADERBYTES + n * BLOB_ENTRYBYTES, (uint64_t)internals->entries[n].byteOffset, 8);
+        writeBlobValue(data, BLOB_HEADERBYTES + n * BLOB_ENTRYBYTES + 8, (uint64_t)internals->entries[n].samplePosition, 8);
+    }
+
+    *blob = data;
+    *bytes = blobBytes;
+    return true;
+}
+
+// The samples of a frame: 384, 576 or 1152 for MP3 (layer 1, MPEG-2/2.5 layer 3, the others), 1024 for every raw data block of an ADTS frame.
+static bool validFrameSize(SuperpoweredDecoder_Kind kind, unsigned int samplesPerFrame) {
+    if (kind == SuperpoweredDecoder_MP3) return (samplesPerFrame == 384) || (samplesPerFrame == 576) || (samplesPerFrame == 1152);
+    return (samplesPerFrame >= 1024) && (samplesPerFrame <= 4096) && !(samplesPerFrame % 1024);
+}
+
+bool SuperpoweredSeekIndex::load(const void *blob, size_t bytes, const char *path) {
+    const unsigned char *data = (const unsigned char *)blob;
+    if (!data || (bytes < BLOB_HEADERBYTES) || memcmp(data + BLOB_MAGIC, "SPSI", 4) || (readBlobValue(data, BLOB_VERSION, 4) != SEEKINDEX_VERSION)) return false;
+    unsigned int headerKind = (unsigned int)readBlobValue(data, BLOB_KIND, 4), headerSamplerate = (unsigned int)readBlobValue(data, BLOB_SAMPLERATE, 4), headerSamplesPerFrame = (unsigned int)readBlobValue(data, BLOB_SAMPLESPERFRAME, 4);
+    unsigned int headerFramesPerEntry = (unsigned int)readBlobValue(data, BLOB_FRAMESPERENTRY, 4), headerNumFrames = (unsigned int)readBlobValue(data, BLOB_NUMFRAMES, 4), headerNumEntries = (unsigned int)readBlobValue(data, BLOB_NUMENTRIES, 4);
+    int64_t headerFileBytes = (int64_t)readBlobValue(data, BLOB_FILEBYTES, 8), headerDurationSamples = (int64_t)readBlobValue(data, BLOB_DURATIONSAMPLES, 8);
+
+    if ((headerKind != SuperpoweredDecoder_MP3) && (headerKind != SuperpoweredDecoder_AAC)) return false;
+    if (!headerNumEntries || !headerFramesPerEntry || ((bytes - BLOB_HEADERBYTES) / BLOB_ENTRYBYTES != headerNumEntries) || ((bytes - BLOB_HEADERBYTES) % BLOB_ENTRYBYTES)) return false;
+    if (!validFrameSize((SuperpoweredDecoder_Kind)headerKind, headerSamplesPerFrame) || !headerSamplerate || (headerFileBytes <= 0)) return false;
+    if ((headerNumFrames < headerNumEntries) || ((headerNumFrames - 1) / headerFramesPerEntry + 1 != headerNumEntries)) return false;
+
+    if (path) { // The file changed since the index was made?
+        struct stat st;
+        if ((stat(path, &st) != 0) || ((int64_t)st.st_size != headerFileBytes)) return false;
+    }
+
+    seekIndexEntry *entries = (seekIndexEntry *)malloc(headerNumEntries * sizeof(seekIndexEntry));
+    if (!entries) return false;
+    for (unsigned int n = 0; n < headerNumEntries; n++) {
+        entries[n].byteOffset = (int64_t)readBlobValue(data, BLOB_HEADERBYTES + n * BLOB_ENTRYBYTES, 8);
+        entries[n].samplePosition = (int64_t)readBlobValue(data, BLOB_HEADERBYTES + n * BLOB_ENTRYBYTES + 8, 8);
+    }
+    // The entries must be in order, inside the file, and before the end.
+    bool valid = (entries[0].byteOffset >= 0) && (entries[0].samplePosition >= 0) && (entries[headerNumEntries - 1].byteOffset < headerFileBytes) && (entries[headerNumEntries - 1].samplePosition < headerDurationSamples);
+    for (unsigned int n = 1; valid && (n < headerNumEntries); n++) valid = (entries[n].byteOffset > entries[n - 1].byteOffset) && (entries[n].samplePosition > entries[n - 1].samplePosition);
+    if (!valid) {
+        free(entries);
+        return false;
+    }
+
+    free(internals->entries);
+    internals->entries = entries;
+    internals->numEntries = internals->capacity = headerNumEntries;
+    internals->framesPerEntry = headerFramesPerEntry;
+    kind = (SuperpoweredDecoder_Kind)headerKind;
+    samplerate = headerSamplerate;
+    samplesPerFrame = headerSamplesPerFrame;
+    numFrames = headerNumFrames;
+    numEntries = headerNumEntries;
+    fileBytes = headerFileBytes;
+    durationSamples = headerDurationSamples;
+    return true;
+}
+
+// The last entry at or before the position.
+static unsigned int findEntry(seekIndexInternals *internals, int64_t sample) {
+    unsigned int low = 0, high = internals->numEntries;
+    while (high - low > 1) {
+        unsigned int middle = (low + high) / 2;
+        if (internals->entries[middle].samplePosition <= sample) low = middle; else high = middle;
+    }
+    return low;
+}
+
+bool SuperpoweredSeekIndex::find(int64_t sample, int64_t *byteOffset, int64_t *frameSample) {
+    if (!internals->numEntries || (sample < 0) || (sample >= durationSamples)) return false;
+    // The frame before the position's frame must be decoded intact, its overlap is added to the position's frame.
+    unsigned int overlap = findEntry(internals, sample - samplesPerFrame), entry = overlap;
+
+    // Its main data may begin in the bit reservoir: up to 511 bytes of main data in the frames before it, not counting their headers and side info.
+    // Go back until that many bytes of main data are covered.
+    if (kind == SuperpoweredDecoder_MP3) while (entry > 0) {
+        seekIndexEntry *from = &internals->entries[entry], *to = &internals->entries[overlap];
+        int64_t mainDataBytes = to->byteOffset - from->byteOffset - (to->samplePosition - from->samplePosition) / samplesPerFrame * MP3_MAXSIDEBYTES;
+        if (mainDataBytes >= MP3_MAXRESERVOIRBYTES) break;
+        entry--;
+    }
+
+    *byteOffset = internals->entries[entry].byteOffset;
+    *frameSample = internals->entries[entry].samplePosition;
+    return true;
+}
+
+bool SuperpoweredSeekIndex::getEntry(unsigned int entry, int64_t *byteOffset, int64_t *samplePosition) {
+    if (entry >= internals->numEntries) return false;
+    *byteOffset = internals->entries[entry].byteOffset;
+    *samplePosition = internals->entries[entry].samplePosition;
+    return true;
+}
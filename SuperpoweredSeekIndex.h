@@ -0,0 +1,106 @@
+#ifndef Header_SuperpoweredSeekIndex
+#define Header_SuperpoweredSeekIndex
+
+#include "SuperpoweredDecoder.h"
+#include <stddef.h>
+
+struct seekIndexInternals;
+
+/**
+ @brief Frame offset index for MP3 and ADTS AAC files, for fast random access into long VBR files.
+
+ build() scans the frame headers only (no decoding), and stores the byte offset and sample position of every framesPerEntry-th frame. serialize() and load() store it in a sidecar blob, so the scan runs only once per file.
+ find() is a binary search. It returns with a frame some warm-up before the requested position: one frame for AAC (overlap). For MP3 the frame before the position (overlap) must be intact, so decoding starts early enough to have its bit reservoir: 511 bytes of main data before it, not counting headers and side info. Open SuperpoweredDecoder at the returned byte offset (offset and length arguments of open()), then decode and drop the samples before the requested position.
+
+ Sample positions count from the first audio frame. The Xing/Info/VBRI frame of MP3 files is not audio, and it's not counted.
+
+ @param kind SuperpoweredDecoder_MP3 or SuperpoweredDecoder_AAC. Read only.
+ @param samplerate The sample rate. Read only.
+ @param samplesPerFrame The samples in one frame (1152 or 576 for MP3, 1024 for AAC). Read only.
+ @param durationSamples The duration in samples, counting every frame. Read only.
+ @param fileBytes The size of the file the index was made from. Read only.
+ @param numFrames The number of audio frames. Read only.
+ @param numEntries The number of entries in the index. Read only.
+ */
+class SuperpoweredSeekIndex {
+public:
+// READ ONLY properties
+    SuperpoweredDecoder_Kind kind;
+    unsigned int samplerate, samplesPerFrame, numFrames, numEntries;
+    int64_t durationSamples, fileBytes;
+
+    /**
+     @param framesPerEntry Every framesPerEntry-th frame is stored. Bigger values make a smaller index, but seeking decodes up to this many frames more. One entry is 16 bytes.
+     */
+    SuperpoweredSeekIndex(unsigned int framesPerEntry = 8);
+    ~SuperpoweredSeekIndex();
+
+    /**
+     @brief Builds the index by scanning the frame headers of a file. Not real-time safe, reads the entire file.
+
+     @return NULL if successful, or an error string.
+
+     @param path Full file system path.
+     */
+    const char *build(const char *path);
+
+    /**
+     @brief Same as build(), for a file in memory. fileBytes is the size of the data.
+
+     @return NULL if successful, or an error string.
+
+     @param data The file's data. Not used after this returns.
+     @param bytes The size of the data in bytes.
+     */
+    const char *buildMemory(const void *data, size_t bytes);
+
+    /**
+     @brief Stores the index in a blob. The blob has a fixed little-endian layout, so it can be loaded on any platform.
+
+     @return False if there is no index or memory allocation failed.
+
+     @param blob Returns with the blob. You take ownership (free() it).
+     @param bytes Returns with the size of the blob.
+     */
+    bool serialize(void **blob, size_t *bytes);
+
+    /**
+     @brief Loads an index from a blob made by serialize().
+
+     @return False if the blob is invalid, or doesn't belong to the file.
+
+     @param blob The blob.
+     @param bytes The size of the blob.
+     @param path Optional. If not NULL, the index is accepted only if the file's size matches.
+     */
+    bool load(const void *blob, size_t bytes, const char *path = NULL);
+
+    /**
+     @brief Finds the frame to start decoding at for a position. O(log n).
+
+     @return False if there is no index or the position is outside of the file.
+
+     @param sample The position (a sample index).
+     @param byteOffset Returns with the byte offset of the frame in the file.
+     @param frameSample Returns with the sample position of the frame. Decode and drop (sample - frameSample) samples to arrive at the position.
+     */
+    bool find(int64_t sample, int64_t *byteOffset, int64_t *frameSample);
+
+    /**
+     @brief Returns with an entry of the index, for splitting the file at frame boundaries.
+
+     @return False if there is no such entry.
+
+     @param entry The entry index, 0 to numEntries - 1.
+     @param byteOffset Returns with the byte offset of the frame in the file.
+     @param samplePosition Returns with the sample position of the frame.
+     */
+    bool getEntry(unsigned int entry, int64_t *byteOffset, int64_t *samplePosition);
+
+private:
+    seekIndexInternals *internals;
+    SuperpoweredSeekIndex(const SuperpoweredSeekIndex&);
+    SuperpoweredSeekIndex& operator=(const SuperpoweredSeekIndex&);
+};
+
+#endif
@@ -0,0 +1,134 @@
+// Stress test of SuperpoweredAudiobufferCache: 16 threads get, release and retain buffers, and hand retained buffers to each other.
+// Every buffer holds a token of its holder. A buffer handed out twice gets overwritten by the second holder, and the first holder finds a wrong token.
+// Build: g++ -O2 -I.. SuperpoweredAudioBufferCacheTest.cpp ../SuperpoweredAudioBufferCache.cpp -lpthread
+// Returns 0 if every check passed.
+
+#include "SuperpoweredAudioBufferCache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define NUMTHREADS 16
+#define ITERATIONS 200000
+#define MAXHELD 16
+#define MAILBOX 64
+
+typedef struct mailbox {
+    pthread_mutex_t mutex;
+    void *buffers[MAILBOX];
+    unsigned int tokens[MAILBOX];
+    int count;
+} mailbox;
+
+static mailbox mailboxes[NUMTHREADS];
+static int errors = 0;
+
+// Writes the token into the first word of every 64 bytes.
+static void stamp(void *buffer, unsigned int sizeBytes, unsigned int token) {
+    unsigned int *words = (unsigned int *)buffer;
+    for (unsigned int n = 0; n < sizeBytes / 4; n += 16) words[n] = token;
+}
+
+static bool check(void *buffer, unsigned int sizeBytes, unsigned int token) {
+    unsigned int *words = (unsigned int *)buffer;
+    for (unsigned int n = 0; n < sizeBytes / 4; n += 16) if (words[n] != token) return false;
+    return true;
+}
+
+static void emptyMailbox(mailbox *box) {
+    pthread_mutex_lock(&box->mutex);
+    for (int n = 0; n < box->count; n++) {
+        if (*(unsigned int *)box->buffers[n] != box->tokens[n]) __atomic_fetch_add(&errors, 1, __ATOMIC_RELAXED);
+        SuperpoweredAudiobufferCache::releaseBuffer(box->buffers[n]);
+    }
+    box->count = 0;
+    pthread_mutex_unlock(&box->mutex);
+}
+
+static void *worker(void *param) {
+    unsigned int id = (unsigned int)(size_t)param, seed = id * 77 + 1, nextToken = id << 24;
+    void *held[MAXHELD];
+    unsigned int sizes[MAXHELD], tokens[MAXHELD];
+    int numHeld = 0;
+
+    for (int iteration = 0; iteration < ITERATIONS; iteration++) {
+        int action = rand_r(&seed) % 100;
+
+        if ((action < 45) && (numHeld < MAXHELD)) { // Get a buffer of 64 bytes to 32 kb.
+            unsigned int sizeBytes = 64u << (rand_r(&seed) % 10);
+            void *buffer = SuperpoweredAudiobufferCache::getBuffer(sizeBytes);
+            if (!buffer) buffer = SuperpoweredAudiobufferCache::allocBuffer(sizeBytes);
+            if (!buffer) {
+                __atomic_fetch_add(&errors, 1, __ATOMIC_RELAXED);
+                continue;
+            }
+            tokens[numHeld] = ++nextToken;
+            stamp(buffer, sizeBytes, tokens[numHeld]);
+            held[numHeld] = buffer;
+            sizes[numHeld++] = sizeBytes;
+        } else if ((action < 95) && numHeld) { // Release a buffer, or hand it to another thread first.
+            int n = rand_r(&seed) % numHeld;
+            if (!check(held[n], sizes[n], tokens[n])) __atomic_fetch_add(&errors, 1, __ATOMIC_RELAXED);
+
+            if (action >= 85) {
+                mailbox *box = &mailboxes[rand_r(&seed) % NUMTHREADS];
+                SuperpoweredAudiobufferCache::retainBuffer(held[n]);
+                pthread_mutex_lock(&box->mutex);
+                if (box->count < MAILBOX) {
+                    box->buffers[box->count] = held[n];
+                    box->tokens[box->count++] = tokens[n];
+                } else SuperpoweredAudiobufferCache::releaseBuffer(held[n]);
+                pthread_mutex_unlock(&box->mutex);
+            }
+
+            SuperpoweredAudiobufferCache::releaseBuffer(held[n]);
+            numHeld--;
+            held[n] = held[numHeld];
+            sizes[n] = sizes[numHeld];
+            tokens[n] = tokens[numHeld];
+        } else emptyMailbox(&mailboxes[id]);
+    }
+
+    for (int n = 0; n < numHeld; n++) SuperpoweredAudiobufferCache::releaseBuffer(held[n]);
+    return NULL;
+}
+
+static int comparePointers(const void *a, const void *b) {
+    size_t x = (size_t)*(void * const *)a, y = (size_t)*(void * const *)b;
+    return (x > y) - (x < y);
+}
+
+int main() {
+    SuperpoweredAudiobufferCache::ping();
+    for (int n = 0; n < NUMTHREADS; n++) pthread_mutex_init(&mailboxes[n].mutex, NULL);
+
+    pthread_t threads[NUMTHREADS];
+    for (int n = 0; n < NUMTHREADS; n++) pthread_create(&threads[n], NULL, worker, (void *)(size_t)n);
+    for (int n = 0; n < NUMTHREADS; n++) pthread_join(threads[n], NULL);
+    for (int n = 0; n < NUMTHREADS; n++) emptyMailbox(&mailboxes[n]);
+    SuperpoweredAudiobufferCache::flushThread();
+    printf("Stress: %d errors.\n", errors);
+
+    // Every buffer must be back in the pool, exactly once.
+    int failures = errors ? 1 : 0;
+    SuperpoweredAudiobufferCacheStats stats[SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES];
+    SuperpoweredAudiobufferCache::getStats(stats);
+    for (int c = 0; c < SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES; c++) {
+        void **buffers = (void **)malloc(stats[c].buffers * sizeof(void *) + sizeof(void *));
+        unsigned int count = 0, duplicates = 0;
+        void *buffer;
+        while ((count <= stats[c].buffers) && (buffer = SuperpoweredAudiobufferCache::getBuffer(stats[c].bufferSizeBytes))) buffers[count++] = buffer;
+        qsort(buffers, count, sizeof(void *), comparePointers);
+        for (unsigned int n = 1; n < count; n++) if (buffers[n] == buffers[n - 1]) duplicates++;
+        for (unsigned int n = 0; n < count; n++) SuperpoweredAudiobufferCache::releaseBuffer(buffers[n]);
+        free(buffers);
+
+        bool passed = (stats[c].retainedBuffers == 0) && (count == stats[c].buffers) && !duplicates;
+        if (!passed) failures++;
+        printf("%u bytes: %u buffers, %u in use, %u free, %u duplicates%s\n", stats[c].bufferSizeBytes, stats[c].buffers, stats[c].retainedBuffers, count, duplicates, passed ? "" : " FAILED");
+    }
+
+    printf(failures ? "FAILED\n" : "PASSED\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,112 @@
+// Checks SuperpoweredAudiobufferChain::compact: sequences of bounded calls must make progress until nothing is left to merge, and keep the audio and the positions intact.
+// Build on x86 with the library, for example: g++ -O2 -I.. SuperpoweredAudioBufferChainTest.cpp ../SuperpoweredAudioBufferChain.cpp ../SuperpoweredAudioBufferCache.cpp ../libSuperpoweredAndroidx86.a -lpthread
+// Returns 0 if every check passed.
+
+#include "SuperpoweredAudioBufferChain.h"
+#include "SuperpoweredAudioBufferCache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAXSAMPLES 200000
+
+static float reference[MAXSAMPLES * 2];
+
+// Appends an item of stereo float samples, numbered continuously from firstSample.
+static void appendItem(SuperpoweredAudiobufferChain *chain, int64_t samplePosition, int firstSample, int lengthSamples, int padding) {
+    SuperpoweredAudiobufferlistElement element;
+    memset(&element, 0, sizeof(element));
+    float *buffer = (float *)SuperpoweredAudiobufferCache::allocBuffer((unsigned int)(padding + lengthSamples) * 8);
+    for (int n = 0; n < lengthSamples * 2; n++) buffer[padding * 2 + n] = reference[firstSample * 2 + n] = (float)(firstSample * 2 + n);
+    element.buffers[0] = buffer;
+    element.samplePosition = samplePosition;
+    element.startSample = padding;
+    element.endSample = padding + lengthSamples;
+    element.samplesUsed = (float)lengthSamples;
+    chain->append(&element);
+}
+
+// Counts the items and compares the audio to the reference.
+static bool verify(SuperpoweredAudiobufferChain *chain, int lengthSamples, int *numItems) {
+    if (chain->sampleLength != lengthSamples) return false;
+    *numItems = 0;
+    if (!chain->makeSlice(0, lengthSamples)) return false;
+    SuperpoweredAudiobufferlistElement element;
+    int position = 0;
+    while (chain->nextSliceElement(&element, false)) {
+        int length = element.endSample - element.startSample;
+        if (memcmp((float *)element.buffers[0] + element.startSample * 2, reference + position * 2, (size_t)length * 8)) return false;
+        position += length;
+        (*numItems)++;
+    }
+    return position == lengthSamples;
+}
+
+// Calls compact() with the same limit until it returns 0. Every call before that must remove something.
+static bool compactAll(SuperpoweredAudiobufferChain *chain, unsigned int maxSamples, int smallItemSamples, int targetItemSamples, int maxCalls, int *numCalls) {
+    *numCalls = 0;
+    while (chain->compact(maxSamples, smallItemSamples, targetItemSamples)) if (++*numCalls > maxCalls) return false;
+    return true;
+}
+
+// 40 adjacent items of 100 samples, merged in calls copying less than a run.
+static bool boundedCalls(unsigned int maxSamples) {
+    SuperpoweredAudiobufferChain chain(8, 64, 1, &SuperpoweredAudiobufferCacheOwner);
+    for (int n = 0; n < 40; n++) appendItem(&chain, n * 100, n * 100, 100, 0);
+    int64_t start = chain.startSamplePosition(), end = chain.nextSamplePosition();
+
+    unsigned int first = chain.compact(maxSamples, 1024, 8192);
+    int numCalls = 0, numItems = 0;
+    bool passed = first && compactAll(&chain, maxSamples, 1024, 8192, 40, &numCalls) && verify(&chain, 4000, &numItems) &&
+                  (chain.startSamplePosition() == start) && (chain.nextSamplePosition() == end);
+    printf("40 x 100 samples, compact(%u): %u removed by the first call, %d items after %d calls%s\n", maxSamples, first, passed ? numItems : -1, numCalls + 1, passed ? "" : " FAILED");
+    chain.clear();
+    return passed;
+}
+
+// Random item sizes, paddings, gaps in the sample positions and partially used items, compacted with a small limit.
+static bool randomChains() {
+    srand(5);
+    int errors = 0;
+    for (int iteration = 0; iteration < 50; iteration++) {
+        SuperpoweredAudiobufferChain chain(8, 4, 1, &SuperpoweredAudiobufferCacheOwner);
+        int lengthSamples = 0;
+        int64_t samplePosition = 0;
+        for (int n = 0; n < 300; n++) {
+            int length = 1 + rand() % ((rand() % 4) ? 50 : 3000);
+            if (lengthSamples + length > MAXSAMPLES) break;
+            if (rand() % 20 == 0) samplePosition += 7; // Not continuous, must not be merged.
+            appendItem(&chain, samplePosition, lengthSamples, length, rand() % 3);
+            samplePosition += length;
+            lengthSamples += length;
+        }
+        int64_t start = chain.startSamplePosition(), end = chain.nextSamplePosition();
+
+        int numCalls, numItems;
+        if (!compactAll(&chain, 500, 1024, 8192, 1000, &numCalls) || !verify(&chain, lengthSamples, &numItems) ||
+            (chain.startSamplePosition() != start) || (chain.nextSamplePosition() != end)) errors++;
+        chain.clear();
+    }
+    printf("Random chains: %d errors%s\n", errors, errors ? " FAILED" : "");
+    return !errors;
+}
+
+int main() {
+    SuperpoweredAudiobufferCache::ping();
+    int failures = 0;
+    if (!boundedCalls(1000)) failures++;
+    if (!boundedCalls(100)) failures++;
+    if (!boundedCalls(100000)) failures++;
+    if (!randomChains()) failures++;
+
+    // Every buffer must be released.
+    SuperpoweredAudiobufferCache::flushThread();
+    SuperpoweredAudiobufferCacheStats stats[SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES];
+    unsigned int retained = SuperpoweredAudiobufferCache::getStats(stats);
+    for (int n = 0; n < SUPERPOWEREDAUDIOBUFFERCACHE_NUMCLASSES; n++) retained += stats[n].retainedBuffers;
+    if (retained) failures++;
+    printf("Buffers in use at the end: %u%s\n", retained, retained ? " FAILED" : "");
+
+    printf(failures ? "FAILED\n" : "PASSED\n");
+    return failures ? 1 : 0;
+}
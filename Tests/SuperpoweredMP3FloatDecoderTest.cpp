@@ -0,0 +1,503 @@
+// Checks SuperpoweredMP3FloatDecoder on generated MPEG-1, MPEG-2 and MPEG-2.5 layer 3 files, with the bit reservoir and long, short and mixed blocks.
+// Precise seeking must give the same output as decoding from the beginning. Mid/side and intensity stereo are checked against the same audio coded as plain stereo. Damaged files must decode to finite values.
+// Prints the decode throughput of every SIMD code path.
+// Build on x86 with the library, for example: g++ -O2 -I.. SuperpoweredMP3FloatDecoderTest.cpp ../SuperpoweredMP3FloatDecoder.cpp ../SuperpoweredSeekIndex.cpp ../SuperpoweredSIMD.cpp ../libSuperpoweredAndroidx86.a
+// Returns 0 if every check passed.
+
+#include "SuperpoweredMP3FloatDecoder.h"
+#include "SuperpoweredSIMD.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#define NUMFRAMES 400
+#define MAXFRAMEBYTES 1500
+#define CHUNKSAMPLES 4096
+
+static const unsigned short bitrates[2][15] = { // kbps. MPEG-1, MPEG-2/2.5 layer 3.
+    { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 },
+    { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 }
+};
+static const unsigned int samplerates[3] = { 44100, 48000, 32000 };
+
+// One granule of one channel. The quantized values are -1, 0 or 1: Huffman table 1 in the big values region, count1 table B after it.
+typedef struct testGranule {
+    int lines[576];
+    unsigned char longScalefactors[21], shortScalefactors[12][3];
+    unsigned int globalGain, blockType, subblockGain[3], scalefacScale, bigValues, count1Quads;
+    bool mixedBlock;
+} testGranule;
+
+typedef struct testStream {
+    unsigned int version, samplerateIndex, mode, modeExtension; // Header fields. Version: 3 (MPEG-1), 2 (MPEG-2) or 0 (MPEG-2.5). Mode: 0 (stereo), 1 (joint stereo) or 3 (mono).
+    testGranule *granules; // NUMFRAMES frames of 2 granules of 2 channels.
+} testStream;
+
+typedef struct bitWriter {
+    unsigned char *data; // Zeroed.
+    unsigned int position;
+} bitWriter;
+
+static void writeBits(bitWriter *writer, unsigned int value, unsigned int bits) {
+    while (bits--) {
+        if ((value >> bits) & 1) writer->data[writer->position >> 3] |= (unsigned char)(0x80 >> (writer->position & 7));
+        writer->position++;
+    }
+}
+
+static testGranule *granuleOf(const testStream *stream, unsigned int frame, unsigned int granule, unsigned int channel) {
+    return stream->granules + (frame * 2 + granule) * 2 + channel;
+}
+
+static unsigned int samplesPerFrame(const testStream *stream) {
+    return (stream->version == 3) ? 1152 : 576;
+}
+
+static unsigned int samplerate(const testStream *stream) {
+    return samplerates[stream->samplerateIndex] >> ((stream->version == 3) ? 0 : ((stream->version == 2) ? 1 : 2));
+}
+
+// The scalefactors of a granule in bitstream order, with their bits. MPEG-1 uses scalefac_compress 15 (4 and 3 bits), MPEG-2 scalefac_compress 298 (3, 3, 2 and 2 bits).
+// The right channel of MPEG-2 intensity stereo uses scalefac_compress 259: 3, 3 and 3 bits, intensity scale 1.
+static unsigned int scalefactorLayout(testGranule *granule, bool lsf, bool intensity, unsigned char **values, unsigned int *bits) {
+    unsigned int n = 0;
+    if (!lsf) {
+        if (granule->blockType != 2) for (int sfb = 0; sfb < 21; sfb++) {
+            values[n] = &granule->longScalefactors[sfb];
+            bits[n++] = (sfb < 11) ? 4 : 3;
+        } else {
+            if (granule->mixedBlock) for (int sfb = 0; sfb < 8; sfb++) {
+                values[n] = &granule->longScalefactors[sfb];
+                bits[n++] = 4;
+            }
+            for (int sfb = granule->mixedBlock ? 3 : 0; sfb < 12; sfb++) for (int window = 0; window < 3; window++) {
+                values[n] = &granule->shortScalefactors[sfb][window];
+                bits[n++] = (sfb < 6) ? 4 : 3;
+            }
+        }
+        return n;
+    }
+
+    static const unsigned char counts[2][3][4] = {
+        { { 6, 5, 5, 5 }, { 9, 9, 9, 9 }, { 6, 9, 9, 9 } },
+        { { 7, 7, 7, 0 }, { 12, 12, 12, 0 }, { 6, 15, 12, 0 } }
+    }, partBits[2][4] = { { 3, 3, 2, 2 }, { 3, 3, 3, 0 } };
+    unsigned int block = (granule->blockType != 2) ? 0 : (granule->mixedBlock ? 2 : 1), index = 0;
+    for (int part = 0; part < 4; part++) for (unsigned int k = 0; k < counts[intensity][block][part]; k++, index++) {
+        if ((block == 0) || ((block == 2) && (index < 6))) values[n] = &granule->longScalefactors[index];
+        else {
+            unsigned int shortIndex = (block == 2) ? index - 6 + 9 : index; // Mixed blocks continue at short band 3.
+            values[n] = &granule->shortScalefactors[shortIndex / 3][shortIndex % 3];
+        }
+        bits[n++] = partBits[intensity][part];
+    }
+    return n;
+}
+
+static void randomGranule(testGranule *granule, bool lsf, bool longBlocks) {
+    static const unsigned int blockTypes[6] = { 0, 0, 1, 2, 2, 3 };
+    memset(granule, 0, sizeof(testGranule));
+    granule->blockType = longBlocks ? 0 : blockTypes[rand() % 6];
+    granule->mixedBlock = (granule->blockType == 2) && !(rand() % 3);
+    granule->globalGain = 150 + rand() % 30;
+    granule->scalefacScale = rand() % 2;
+    if (granule->blockType == 2) for (int window = 0; window < 3; window++) granule->subblockGain[window] = rand() % 3;
+    granule->bigValues = rand() % (lsf ? 60 : 120);
+    granule->count1Quads = rand() % 30;
+    for (unsigned int n = 0; n < granule->bigValues * 2 + granule->count1Quads * 4; n++) granule->lines[n] = rand() % 3 - 1;
+
+    unsigned char *values[39];
+    unsigned int bits[39], count = scalefactorLayout(granule, lsf, false, values, bits); // The intensity layout has the same number of scalefactors, with enough bits for these.
+    for (unsigned int n = 0; n < count; n++) *values[n] = (unsigned char)(rand() % (1 << bits[n]));
+}
+
+static void writeSign(bitWriter *writer, int value) {
+    if (value) writeBits(writer, value < 0, 1);
+}
+
+// Scalefactors and Huffman codes, returns with part2_3_length.
+static unsigned int writeGranule(bitWriter *writer, testGranule *granule, bool lsf, bool intensity) {
+    static const unsigned char table1[2][2][2] = { { { 1, 1 }, { 1, 3 } }, { { 1, 2 }, { 0, 3 } } }; // [x][y]: code, length.
+    unsigned int start = writer->position;
+    unsigned char *values[39];
+    unsigned int bits[39], count = scalefactorLayout(granule, lsf, intensity, values, bits);
+    for (unsigned int n = 0; n < count; n++) writeBits(writer, *values[n], bits[n]);
+
+    const int *lines = granule->lines;
+    for (unsigned int n = 0; n < granule->bigValues; n++, lines += 2) {
+        const unsigned char *code = table1[abs(lines[0])][abs(lines[1])];
+        writeBits(writer, code[0], code[1]);
+        writeSign(writer, lines[0]);
+        writeSign(writer, lines[1]);
+    }
+    for (unsigned int n = 0; n < granule->count1Quads; n++, lines += 4) {
+        unsigned int vwxy = (unsigned int)((abs(lines[0]) << 3) | (abs(lines[1]) << 2) | (abs(lines[2]) << 1) | abs(lines[3]));
+        writeBits(writer, 15 - vwxy, 4);
+        for (int k = 0; k < 4; k++) writeSign(writer, lines[k]);
+    }
+    return writer->position - start;
+}
+
+static void writeSideInfoGranule(bitWriter *writer, const testGranule *granule, unsigned int part23Length, bool lsf, bool intensity) {
+    writeBits(writer, part23Length, 12);
+    writeBits(writer, granule->bigValues, 9);
+    writeBits(writer, granule->globalGain, 8);
+    if (lsf) writeBits(writer, intensity ? 259 : 298, 9); else writeBits(writer, 15, 4);
+    if (granule->blockType) {
+        writeBits(writer, 1, 1);
+        writeBits(writer, granule->blockType, 2);
+        writeBits(writer, granule->mixedBlock, 1);
+        writeBits(writer, 1, 5);
+        writeBits(writer, 1, 5);
+        for (int window = 0; window < 3; window++) writeBits(writer, granule->subblockGain[window], 3);
+    } else {
+        writeBits(writer, 0, 1);
+        for (int region = 0; region < 3; region++) writeBits(writer, 1, 5);
+        writeBits(writer, 7, 4);
+        writeBits(writer, 7, 3);
+    }
+    if (!lsf) writeBits(writer, 0, 1); // preflag
+    writeBits(writer, granule->scalefacScale, 1);
+    writeBits(writer, 1, 1); // count1 table B
+}
+
+static unsigned int frameBytes(const testStream *stream, unsigned int bitrateIndex) {
+    bool lsf = (stream->version != 3);
+    return (lsf ? 72 : 144) * bitrates[lsf ? 1 : 0][bitrateIndex] * 1000 / samplerate(stream);
+}
+
+static void writeHeader(unsigned char *p, const testStream *stream, unsigned int bitrateIndex) {
+    p[0] = 0xff;
+    p[1] = (unsigned char)(0xe0 | (stream->version << 3) | (1 << 1) | 1); // Layer 3, no CRC.
+    p[2] = (unsigned char)((bitrateIndex << 4) | (stream->samplerateIndex << 2));
+    p[3] = (unsigned char)((stream->mode << 6) | (stream->modeExtension << 4));
+}
+
+// An ID3v2 tag, an Info frame, the frames with garbage in the middle, and an ID3v1 tag. Every frame takes as much main data from the reservoir as it can.
+static unsigned char *writeStream(const testStream *stream, size_t *bytes) {
+    bool lsf = (stream->version != 3), intensity = (stream->mode == 1) && (stream->modeExtension & 1);
+    unsigned int numGranules = lsf ? 1 : 2, numChannels = (stream->mode == 3) ? 1 : 2, sideInfoBytes = lsf ? ((numChannels == 1) ? 9 : 17) : ((numChannels == 1) ? 17 : 32), maxBegin = lsf ? 255 : 511;
+    unsigned char *mainData = (unsigned char *)calloc(NUMFRAMES * MAXFRAMEBYTES, 1), *file = (unsigned char *)calloc(NUMFRAMES * MAXFRAMEBYTES + 4096, 1);
+    static unsigned int bitrateIndexes[NUMFRAMES], mainDataBegins[NUMFRAMES], part23Lengths[NUMFRAMES][2][2];
+
+    // The main data of every frame is placed first, its beginning may be in the frames before.
+    size_t slotStart = 0, dataEnd = 0;
+    for (unsigned int frame = 0; frame < NUMFRAMES; frame++) {
+        unsigned char data[MAXFRAMEBYTES];
+        memset(data, 0, sizeof(data));
+        bitWriter writer = { data, 0 };
+        for (unsigned int granule = 0; granule < numGranules; granule++) for (unsigned int channel = 0; channel < numChannels; channel++) part23Lengths[frame][granule][channel] = writeGranule(&writer, granuleOf(stream, frame, granule, channel), lsf, lsf && intensity && channel);
+
+        size_t dataBytes = (writer.position + 7) / 8, dataStart = (slotStart > dataEnd + maxBegin) ? slotStart - maxBegin : dataEnd;
+        unsigned int bitrateIndex = 1 + rand() % 14;
+        while (dataStart + dataBytes > slotStart + frameBytes(stream, bitrateIndex) - 4 - sideInfoBytes) bitrateIndex++;
+        bitrateIndexes[frame] = bitrateIndex;
+        mainDataBegins[frame] = (unsigned int)(slotStart - dataStart);
+        memcpy(mainData + dataStart, data, dataBytes);
+        dataEnd = dataStart + dataBytes;
+        slotStart += frameBytes(stream, bitrateIndex) - 4 - sideInfoBytes;
+    }
+
+    static const unsigned char id3[10] = { 'I', 'D', '3', 4, 0, 0, 0, 0, 0, 20 };
+    memcpy(file, id3, 10);
+    size_t p = 30;
+    writeHeader(file + p, stream, 9);
+    memcpy(file + p + 4 + sideInfoBytes, "Info", 4);
+    p += frameBytes(stream, 9);
+
+    slotStart = 0;
+    for (unsigned int frame = 0; frame < NUMFRAMES; frame++) {
+        unsigned int bytes = frameBytes(stream, bitrateIndexes[frame]), slotBytes = bytes - 4 - sideInfoBytes;
+        writeHeader(file + p, stream, bitrateIndexes[frame]);
+        bitWriter writer = { file + p + 4, 0 };
+        if (lsf) {
+            writeBits(&writer, mainDataBegins[frame], 8);
+            writeBits(&writer, 0, numChannels);
+        } else {
+            writeBits(&writer, mainDataBegins[frame], 9);
+            writeBits(&writer, 0, (numChannels == 1) ? 5 + 4 : 3 + 8); // Private bits, scfsi.
+        }
+        for (unsigned int granule = 0; granule < numGranules; granule++) for (unsigned int channel = 0; channel < numChannels; channel++) writeSideInfoGranule(&writer, granuleOf(stream, frame, granule, channel), part23Lengths[frame][granule][channel], lsf, lsf && intensity && channel);
+        memcpy(file + p + 4 + sideInfoBytes, mainData + slotStart, slotBytes);
+        slotStart += slotBytes;
+        p += bytes;
+        if (frame == NUMFRAMES / 2) for (int n = 0; n < 333; n++) file[p++] = (unsigned char)(rand() % 255); // No sync patterns.
+    }
+    memcpy(file + p, "TAG", 3);
+    p += 128;
+
+    free(mainData);
+    *bytes = p;
+    return file;
+}
+
+static void randomStream(testStream *stream, unsigned int version, unsigned int samplerateIndex, unsigned int mode) {
+    stream->version = version;
+    stream->samplerateIndex = samplerateIndex;
+    stream->mode = mode;
+    stream->modeExtension = 0;
+    stream->granules = (testGranule *)malloc(NUMFRAMES * 4 * sizeof(testGranule));
+    for (unsigned int n = 0; n < NUMFRAMES * 4; n++) randomGranule(stream->granules + n, version != 3, false);
+}
+
+// Decodes from the current position to the end. Returns with the number of samples, or -1 on error.
+static int64_t decodeAll(SuperpoweredMP3FloatDecoder *decoder, float *output) {
+    static float chunk[CHUNKSAMPLES * 2 + 8192];
+    int64_t samples = 0;
+    while (true) {
+        unsigned int numberOfSamples = CHUNKSAMPLES;
+        unsigned char result = decoder->decode(chunk, &numberOfSamples);
+        if (result == SUPERPOWEREDDECODER_EOF) return samples;
+        if ((result != SUPERPOWEREDDECODER_OK) || (samples + numberOfSamples > decoder->durationSamples)) return -1;
+        if (output) memcpy(output + samples * 2, chunk, numberOfSamples * 2 * sizeof(float));
+        samples += numberOfSamples;
+    }
+}
+
+static double maxDifference(const float *a, const float *b, int64_t numberOfValues, double *peak) {
+    double difference = 0;
+    *peak = 0;
+    for (int64_t n = 0; n < numberOfValues; n++) {
+        if (fabs(a[n] - b[n]) > difference) difference = fabs(a[n] - b[n]);
+        if (fabs(a[n]) > *peak) *peak = fabs(a[n]);
+    }
+    return difference;
+}
+
+// Properties, open() against openMemory(), precise and frame seeking against decoding from the beginning, and damaged copies of the file.
+static int checkStream(const testStream *stream, const char *name) {
+    size_t bytes;
+    unsigned char *file = writeStream(stream, &bytes);
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/SuperpoweredMP3FloatDecoderTest%d.mp3", (int)getpid());
+    FILE *handle = fopen(path, "wb");
+    if (handle) {
+        fwrite(file, 1, bytes, handle);
+        fclose(handle);
+    }
+
+    int errors = 0;
+    int64_t durationSamples = (int64_t)NUMFRAMES * samplesPerFrame(stream);
+    float *all = (float *)malloc(durationSamples * 2 * sizeof(float)), *memory = (float *)malloc(durationSamples * 2 * sizeof(float)), *chunk = (float *)malloc(CHUNKSAMPLES * 2 * sizeof(float) + 32768);
+    SuperpoweredMP3FloatDecoder decoder;
+    if (!handle || decoder.open(path) || (decoder.durationSamples != durationSamples) || (decoder.samplerate != samplerate(stream)) || (decoder.samplesPerFrame != samplesPerFrame(stream)) || (decoder.numChannels != ((stream->mode == 3) ? 1u : 2u)) || (decodeAll(&decoder, all) != durationSamples)) errors++;
+    else {
+        bool silent = true;
+        for (int64_t n = 0; n < durationSamples * 2; n++) {
+            if (!isfinite(all[n])) errors++;
+            if (all[n] != 0) silent = false;
+        }
+        if (silent) errors++;
+
+        SuperpoweredMP3FloatDecoder fromMemory;
+        if (fromMemory.openMemory(file, bytes) || (decodeAll(&fromMemory, memory) != durationSamples)) errors++;
+        else if (memcmp(all, memory, durationSamples * 2 * sizeof(float))) errors++;
+
+        for (int n = 0; n < 300; n++) {
+            int64_t sample = rand() % durationSamples;
+            bool precise = (n & 1) != 0;
+            int64_t position = decoder.seekTo(sample, precise), expected = precise ? sample : sample - sample % samplesPerFrame(stream);
+            unsigned int numberOfSamples = CHUNKSAMPLES;
+            if ((position != expected) || (decoder.samplePosition != expected) || (decoder.decode(chunk, &numberOfSamples) != SUPERPOWEREDDECODER_OK)) {
+                errors++;
+                continue;
+            }
+            if (numberOfSamples > durationSamples - position) errors++;
+            else if (memcmp(chunk, all + position * 2, numberOfSamples * 2 * sizeof(float))) errors++;
+        }
+        if ((decoder.seekTo(durationSamples + 5, true) != durationSamples) || (decodeAll(&decoder, NULL) != 0)) errors++;
+    }
+
+    // Flipped bytes and a truncated end.
+    unsigned char *damaged = (unsigned char *)malloc(bytes);
+    for (int n = 0; n < 20; n++) {
+        memcpy(damaged, file, bytes);
+        for (int k = 0; k < 200; k++) damaged[400 + rand() % (bytes - 400)] = (unsigned char)rand();
+        size_t damagedBytes = bytes - rand() % (bytes / 4);
+        SuperpoweredMP3FloatDecoder damagedDecoder;
+        if (damagedDecoder.openMemory(damaged, damagedBytes)) continue;
+        float *output = (float *)malloc(damagedDecoder.durationSamples * 2 * sizeof(float) + 8);
+        int64_t samples = decodeAll(&damagedDecoder, output);
+        if (samples != damagedDecoder.durationSamples) errors++;
+        else for (int64_t k = 0; k < samples * 2; k++) if (!isfinite(output[k])) {
+            errors++;
+            break;
+        }
+        free(output);
+    }
+
+    unlink(path);
+    free(damaged);
+    free(all);
+    free(memory);
+    free(chunk);
+    free(file);
+    printf("%s: %d errors%s\n", name, errors, errors ? " FAILED" : "");
+    return errors;
+}
+
+static float *decodeStream(const testStream *stream, int64_t *samples) {
+    size_t bytes;
+    unsigned char *file = writeStream(stream, &bytes);
+    SuperpoweredMP3FloatDecoder decoder;
+    float *output = NULL;
+    *samples = -1;
+    if (!decoder.openMemory(file, bytes)) {
+        output = (float *)malloc(decoder.durationSamples * 2 * sizeof(float));
+        *samples = decodeAll(&decoder, output);
+    }
+    free(file);
+    return output;
+}
+
+static int compareStreams(const testStream *a, const testStream *b, const char *name) {
+    int64_t samplesA, samplesB;
+    float *outputA = decodeStream(a, &samplesA), *outputB = decodeStream(b, &samplesB);
+    int errors = 0;
+    if (!outputA || !outputB || (samplesA != (int64_t)NUMFRAMES * samplesPerFrame(a)) || (samplesA != samplesB)) errors++;
+    else {
+        double peak, difference = maxDifference(outputA, outputB, samplesA * 2, &peak);
+        if ((peak == 0) || (difference > peak * 1e-5)) errors++;
+    }
+    free(outputA);
+    free(outputB);
+    printf("%s: %d errors%s\n", name, errors, errors ? " FAILED" : "");
+    return errors;
+}
+
+// Mid/side: the mid channel 3 dB louder (global gain + 2) and silent side must be the same as the same audio in both channels.
+static int checkMidSide() {
+    testStream stereo, midSide;
+    randomStream(&stereo, 3, 0, 0);
+    randomStream(&midSide, 3, 0, 1);
+    midSide.modeExtension = 2;
+    for (unsigned int n = 0; n < NUMFRAMES * 2; n++) {
+        testGranule *left = stereo.granules + n * 2, *right = left + 1, *mid = midSide.granules + n * 2, *side = mid + 1;
+        *right = *left;
+        *mid = *left;
+        mid->globalGain += 2;
+        memset(side, 0, sizeof(testGranule));
+        side->blockType = left->blockType;
+        side->mixedBlock = left->mixedBlock;
+        side->globalGain = 150;
+    }
+    int errors = compareStreams(&stereo, &midSide, "MPEG-1 mid/side stereo");
+    free(stereo.granules);
+    free(midSide.granules);
+    return errors;
+}
+
+// Intensity stereo with a silent right channel, in long blocks. The last band has the position of the band before.
+// MPEG-1: position 6 puts a band to the left, position 0 to the right.
+// MPEG-2 with intensity scale 1: an odd position attenuates the left channel by (position + 1) / 2 steps of 3 dB, an even position the right channel by position / 2 steps, as much as scalefactors do. Position 7 is illegal, the band stays in the left channel.
+static int checkIntensity(bool lsf) {
+    static const unsigned short bands[2][23] = {
+        { 0, 4, 8, 12, 16, 20, 24, 30, 36, 44, 52, 62, 74, 90, 110, 134, 162, 196, 238, 288, 342, 418, 576 },
+        { 0, 6, 12, 18, 24, 30, 36, 44, 54, 66, 80, 96, 116, 140, 168, 200, 238, 284, 336, 396, 464, 522, 576 }
+    };
+    testStream stereo, intensity;
+    randomStream(&stereo, lsf ? 2 : 3, 0, 0);
+    randomStream(&intensity, lsf ? 2 : 3, 0, 1);
+    intensity.modeExtension = 1;
+    for (unsigned int n = 0; n < NUMFRAMES * 2; n++) {
+        testGranule *source = intensity.granules + n * 2, *positions = source + 1, *left = stereo.granules + n * 2, *right = left + 1;
+        randomGranule(source, lsf, true);
+        memset(positions, 0, sizeof(testGranule));
+        positions->globalGain = 150;
+        for (int sfb = 0; sfb < 21; sfb++) positions->longScalefactors[sfb] = (unsigned char)(lsf ? rand() % 8 : ((rand() % 2) ? 6 : 0));
+        if (lsf) { // The attenuation is in the scalefactors of the plain stereo stream, the last band has none.
+            source->scalefacScale = 0;
+            memset(source->longScalefactors, 0, sizeof(source->longScalefactors));
+            for (int line = bands[1][21]; line < 576; line++) source->lines[line] = 0;
+        }
+
+        *left = *source;
+        *right = *source;
+        for (int sfb = 0; sfb < 22; sfb++) {
+            unsigned int position = positions->longScalefactors[(sfb < 21) ? sfb : 20];
+            bool toLeft = lsf || (position == 6), toRight = lsf ? (position != 7) : (position == 0);
+            if (lsf && toRight && (sfb < 21)) {
+                left->longScalefactors[sfb] = (unsigned char)((position & 1) ? (position + 1) / 2 : 0);
+                right->longScalefactors[sfb] = (unsigned char)((position & 1) ? 0 : position / 2);
+            }
+            for (int line = bands[lsf][sfb]; line < bands[lsf][sfb + 1]; line++) {
+                if (!toLeft) left->lines[line] = 0;
+                if (!toRight) right->lines[line] = 0;
+            }
+        }
+    }
+    int errors = compareStreams(&stereo, &intensity, lsf ? "MPEG-2 intensity stereo" : "MPEG-1 intensity stereo");
+    free(stereo.granules);
+    free(intensity.granules);
+    return errors;
+}
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+// The output of every code path must be close to the generic one's.
+static int benchmark() {
+    testStream stream;
+    randomStream(&stream, 3, 0, 0);
+    size_t bytes;
+    unsigned char *file = writeStream(&stream, &bytes);
+    int64_t durationSamples = (int64_t)NUMFRAMES * 1152;
+    float *generic = (float *)malloc(durationSamples * 2 * sizeof(float)), *output = (float *)malloc(durationSamples * 2 * sizeof(float));
+    int errors = 0;
+
+    SuperpoweredSIMDLevel supported = SuperpoweredSIMDGetSupportedLevel();
+    for (int level = SuperpoweredSIMDLevel_Generic; level <= (int)supported; level++) {
+        SuperpoweredSIMDSetLevel((SuperpoweredSIMDLevel)level);
+        SuperpoweredMP3FloatDecoder decoder;
+        if (decoder.openMemory(file, bytes)) {
+            errors++;
+            break;
+        }
+        float *target = (level == SuperpoweredSIMDLevel_Generic) ? generic : output;
+        double start = now();
+        int64_t samples = 0;
+        for (int repeat = 0; repeat < 10; repeat++) {
+            decoder.seekTo(0, false);
+            samples += decodeAll(&decoder, target);
+        }
+        double seconds = now() - start;
+
+        double peak, difference = maxDifference(generic, target, durationSamples * 2, &peak);
+        if (samples != durationSamples * 10) errors++;
+        else if (difference > peak * 1e-5) errors++;
+        printf("%s: %.0fx real-time, difference to generic %.2g\n", SuperpoweredSIMDLevelName((SuperpoweredSIMDLevel)level), (double)samples / 44100.0 / seconds, difference);
+    }
+    SuperpoweredSIMDSetLevel(supported);
+
+    free(generic);
+    free(output);
+    free(file);
+    free(stream.granules);
+    return errors;
+}
+
+int main() {
+    srand(7);
+    int errors = 0;
+    static const struct { unsigned int version, samplerateIndex, mode; const char *name; } streams[4] = {
+        { 3, 0, 0, "MPEG-1 44100 Hz stereo" },
+        { 3, 2, 3, "MPEG-1 32000 Hz mono" },
+        { 2, 0, 0, "MPEG-2 22050 Hz stereo" },
+        { 0, 2, 0, "MPEG-2.5 8000 Hz stereo" }
+    };
+    for (int n = 0; n < 4; n++) {
+        testStream stream;
+        randomStream(&stream, streams[n].version, streams[n].samplerateIndex, streams[n].mode);
+        errors += checkStream(&stream, streams[n].name);
+        free(stream.granules);
+    }
+    errors += checkMidSide() + checkIntensity(false) + checkIntensity(true) + benchmark();
+    printf(errors ? "FAILED\n" : "PASSED\n");
+    return errors ? 1 : 0;
+}
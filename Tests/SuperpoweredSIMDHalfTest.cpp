@@ -0,0 +1,71 @@
+// Checks SuperpoweredSIMDFloatToHalf and SuperpoweredSIMDHalfToFloat on every code path against the F16C instructions: every half value, edge cases and 1M random floats.
+// Build on x86 with the library, for example: g++ -O2 -I.. SuperpoweredSIMDHalfTest.cpp ../SuperpoweredSIMD.cpp ../libSuperpoweredAndroidx86.a
+// Needs a CPU with F16C. Returns 0 if every check passed.
+
+#include "SuperpoweredSIMD.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <immintrin.h>
+
+#define NUMFLOATS (1 << 20)
+
+__attribute__((target("f16c"))) static unsigned short int referenceHalf(float value) {
+    return (unsigned short int)_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT);
+}
+
+__attribute__((target("f16c"))) static float referenceFloat(unsigned short int half) {
+    return _cvtsh_ss(half);
+}
+
+static bool isNaNHalf(unsigned short int half) {
+    return ((half & 0x7c00) == 0x7c00) && (half & 0x3ff);
+}
+
+static float floats[NUMFLOATS], floatOutput[NUMFLOATS];
+static unsigned short int halfs[65536], halfOutput[NUMFLOATS];
+
+int main() {
+    if (!__builtin_cpu_supports("f16c")) {
+        printf("No F16C on this CPU, nothing to compare to.\n");
+        return 0;
+    }
+
+    for (int n = 0; n < 65536; n++) halfs[n] = (unsigned short int)n;
+    // Random bit patterns, a quarter of them in the half range and a quarter around its top.
+    srand(9);
+    for (int n = 0; n < NUMFLOATS; n++) {
+        unsigned int bits = ((unsigned int)rand() << 16) ^ (unsigned int)rand();
+        if (n % 4 == 1) bits = (bits & 0x807fffff) | ((unsigned int)(100 + rand() % 40) << 23);
+        else if (n % 4 == 2) bits = (bits & 0x80ffffff) | 0x47000000;
+        memcpy(&floats[n], &bits, sizeof(float));
+    }
+    static const float edges[] = { 65504.0f, 65519.99f, 65520.0f, 65536.0f, -65520.0f, 6.1035156e-05f, 5.96e-08f, 2.98e-08f, 2.9802322e-08f, 1e-40f, 0.0f, -0.0f, INFINITY, -INFINITY, NAN, 1.0f, 0.1f };
+    memcpy(floats, edges, sizeof(edges));
+
+    int failures = 0;
+    for (int level = 0; level <= SuperpoweredSIMDGetSupportedLevel(); level++) {
+        SuperpoweredSIMDSetLevel((SuperpoweredSIMDLevel)level);
+        int errors = 0;
+
+        SuperpoweredSIMDHalfToFloat(halfs, floatOutput, 65536);
+        for (int n = 0; n < 65536; n++) {
+            float expected = referenceFloat(halfs[n]);
+            if (isnan(expected) ? !isnan(floatOutput[n]) : memcmp(&expected, &floatOutput[n], sizeof(float))) errors++;
+        }
+
+        // An odd count, to check the scalar tail.
+        SuperpoweredSIMDFloatToHalf(floats, halfOutput, NUMFLOATS - 3);
+        for (int n = 0; n < NUMFLOATS - 3; n++) {
+            unsigned short int expected = referenceHalf(floats[n]);
+            if (isNaNHalf(expected) ? !isNaNHalf(halfOutput[n]) : (expected != halfOutput[n])) errors++;
+        }
+
+        if (errors) failures++;
+        printf("%s: %d differences%s\n", SuperpoweredSIMDLevelName((SuperpoweredSIMDLevel)level), errors, errors ? " FAILED" : "");
+    }
+
+    printf(failures ? "FAILED\n" : "PASSED\n");
+    return failures ? 1 : 0;
+}
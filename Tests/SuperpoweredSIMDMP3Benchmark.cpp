@@ -0,0 +1,223 @@
+// Checks and benchmarks the MP3 stages of SuperpoweredSIMD.h on every code path, per stage.
+// Requantization is compared to pow(), the IMDCT to the direct formula of the standard, the synthesis to the direct matrixing and windowing.
+// The synthesis is also checked with the analysis filterbank of the standard: analysis and synthesis together must return the input, delayed by 481 samples.
+// Build on x86 with the library, for example: g++ -O2 -I.. SuperpoweredSIMDMP3Benchmark.cpp ../SuperpoweredSIMD.cpp ../libSuperpoweredAndroidx86.a
+// Returns 0 if every check passed.
+
+#include "SuperpoweredSIMD.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define NUMFRAMES 40
+#define NUMSLOTS 64
+#define REPEAT 20000
+
+static SuperpoweredSIMDMP3State states[4], reference;
+
+static float randomValue() {
+    return (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+// The IMDCT of one subband, windowed: 18 lines (or 3 x 6 short lines) to 36 values.
+static void directIMDCT(const float *lines, int blockType, bool shortBlock, double *output) {
+    const float *window = reference.windows + blockType * 36;
+    memset(output, 0, 36 * sizeof(double));
+    if (!shortBlock) for (int n = 0; n < 36; n++) {
+        double sum = 0;
+        for (int k = 0; k < 18; k++) sum += lines[k] * cos(M_PI / 72.0 * (2 * n + 19) * (2 * k + 1));
+        output[n] = sum * window[n];
+    } else for (int w = 0; w < 3; w++) for (int n = 0; n < 12; n++) {
+        double sum = 0;
+        for (int k = 0; k < 6; k++) sum += lines[3 * k + w] * cos(M_PI / 24.0 * (2 * n + 7) * (2 * k + 1));
+        output[6 + 6 * w + n] += sum * reference.windows[2 * 36 + n];
+    }
+}
+
+// The synthesis as the standard describes it: a 1024 value shift register, 64 x 32 matrixing, then windowing of 512 values.
+typedef struct directSynthesis {
+    double v[1024];
+} directSynthesis;
+
+static void synthesize(directSynthesis *state, const double *subbands, double *output) {
+    memmove(state->v + 64, state->v, 960 * sizeof(double));
+    for (int i = 0; i < 64; i++) {
+        double sum = 0;
+        for (int k = 0; k < 32; k++) sum += cos((16 + i) * (2 * k + 1) * M_PI / 64.0) * subbands[k];
+        state->v[i] = sum;
+    }
+    for (int j = 0; j < 32; j++) {
+        double sum = 0;
+        for (int i = 0; i < 8; i++) sum += state->v[i * 128 + j] * reference.window[i * 64 + j] + state->v[i * 128 + 96 + j] * reference.window[i * 64 + 32 + j];
+        output[j] = sum;
+    }
+}
+
+// The analysis filterbank of the standard. Its window C[] is the synthesis window divided by 32.
+static void analyze(double *x, const float *input, double *subbands) {
+    memmove(x + 32, x, 480 * sizeof(double));
+    for (int n = 0; n < 32; n++) x[n] = input[31 - n];
+    double y[64];
+    for (int i = 0; i < 64; i++) {
+        y[i] = 0;
+        for (int j = 0; j < 8; j++) y[i] += x[i + 64 * j] * reference.window[i + 64 * j] / 32.0;
+    }
+    for (int k = 0; k < 32; k++) {
+        subbands[k] = 0;
+        for (int i = 0; i < 64; i++) subbands[k] += cos((2 * k + 1) * (i - 16) * M_PI / 64.0) * y[i];
+    }
+}
+
+static bool checkDequantize(int numLevels) {
+    int values[1003];
+    for (int n = 0; n < 1003; n++) values[n] = rand() % 16413 - 8206;
+    values[0] = 0;
+    values[1] = 8206;
+    values[2] = -1;
+
+    double worst = 0;
+    for (int level = 0; level < numLevels; level++) {
+        SuperpoweredSIMDSetLevel((SuperpoweredSIMDLevel)level);
+        float output[1003];
+        SuperpoweredSIMDMP3Dequantize(values, output, 1003, 0.5f);
+        for (int n = 0; n < 1003; n++) {
+            double expected = (values[n] < 0 ? -0.5 : 0.5) * pow(fabs((double)values[n]), 4.0 / 3.0);
+            double error = values[n] ? fabs(output[n] / expected - 1.0) : fabs(output[n]);
+            if (error > worst) worst = error;
+        }
+    }
+    bool passed = worst < 1e-6;
+    printf("Requantization: largest relative error %g%s\n", worst, passed ? "" : " FAILED");
+    return passed;
+}
+
+// Every block type, mixed blocks and the overlap between granules. The IMDCT output feeds the synthesis.
+static bool checkIMDCTAndSynthesis(int numLevels) {
+    double overlap[32][18], worstIMDCT = 0, worstSynthesis = 0;
+    memset(overlap, 0, sizeof(overlap));
+    directSynthesis synthesis;
+    memset(&synthesis, 0, sizeof(synthesis));
+
+    for (int frame = 0; frame < NUMFRAMES; frame++) {
+        int blockType = frame % 4;
+        bool mixedBlock = (blockType == 2) && (frame & 4);
+        float lines[576], expected[576];
+        for (int n = 0; n < 576; n++) lines[n] = randomValue();
+
+        for (int subband = 0; subband < 32; subband++) {
+            bool longBlock = (blockType != 2) || (mixedBlock && (subband < 2));
+            double z[36];
+            directIMDCT(lines + subband * 18, longBlock ? ((blockType == 2) ? 0 : blockType) : 2, !longBlock, z);
+            for (int slot = 0; slot < 18; slot++) {
+                double value = z[slot] + overlap[subband][slot];
+                overlap[subband][slot] = z[18 + slot];
+                expected[slot * 32 + subband] = (float)((subband & slot & 1) ? -value : value);
+            }
+        }
+
+        double expectedAudio[576];
+        for (int slot = 0; slot < 18; slot++) {
+            double subbands[32];
+            for (int k = 0; k < 32; k++) subbands[k] = expected[slot * 32 + k];
+            synthesize(&synthesis, subbands, expectedAudio + slot * 32);
+        }
+
+        for (int level = 0; level < numLevels; level++) {
+            SuperpoweredSIMDSetLevel((SuperpoweredSIMDLevel)level);
+            float output[576], audio[576];
+            SuperpoweredSIMDMP3IMDCT(&states[level], 1, lines, output, blockType, mixedBlock);
+            for (int n = 0; n < 576; n++) if (fabs(output[n] - expected[n]) > worstIMDCT) worstIMDCT = fabs(output[n] - expected[n]);
+            SuperpoweredSIMDMP3Synthesis(&states[level], 0, expected, audio);
+            for (int n = 0; n < 576; n++) if (fabs(audio[n] - expectedAudio[n]) > worstSynthesis) worstSynthesis = fabs(audio[n] - expectedAudio[n]);
+        }
+    }
+
+    bool passed = (worstIMDCT < 1e-5) && (worstSynthesis < 1e-5);
+    printf("IMDCT: largest error %g, synthesis: largest error %g%s\n", worstIMDCT, worstSynthesis, passed ? "" : " FAILED");
+    return passed;
+}
+
+static bool checkReconstruction(int numLevels) {
+    float input[NUMSLOTS * 32];
+    for (int n = 0; n < NUMSLOTS * 32; n++) input[n] = (float)(0.5 * sin(0.05 * n) + 0.3 * sin(0.31 * n) + 0.1 * sin(2.9 * n));
+
+    double x[512], subbands[NUMSLOTS * 32];
+    memset(x, 0, sizeof(x));
+    for (int slot = 0; slot < NUMSLOTS; slot++) analyze(x, input + slot * 32, subbands + slot * 32);
+    float subbandsFloat[NUMSLOTS * 32];
+    for (int n = 0; n < NUMSLOTS * 32; n++) subbandsFloat[n] = (float)subbands[n];
+
+    bool passed = true;
+    for (int level = 0; level < numLevels; level++) {
+        SuperpoweredSIMDSetLevel((SuperpoweredSIMDLevel)level);
+        SuperpoweredSIMDMP3State state;
+        SuperpoweredSIMDMP3Init(&state);
+        float output[NUMSLOTS * 32];
+        SuperpoweredSIMDMP3Synthesis(&state, 0, subbandsFloat, output, NUMSLOTS);
+
+        double signal = 0, noise = 0;
+        for (int n = 481 + 512; n < NUMSLOTS * 32; n++) {
+            signal += (double)input[n - 481] * input[n - 481];
+            noise += ((double)output[n] - input[n - 481]) * ((double)output[n] - input[n - 481]);
+        }
+        double snr = 10.0 * log10(signal / noise);
+        if (snr < 80.0) passed = false;
+        printf("%s: analysis and synthesis %.1f dB SNR%s\n", SuperpoweredSIMDLevelName((SuperpoweredSIMDLevel)level), snr, (snr < 80.0) ? " FAILED" : "");
+    }
+    return passed;
+}
+
+static void benchmark(int numLevels) {
+    int values[576];
+    float lines[576], output[576];
+    for (int n = 0; n < 576; n++) {
+        values[n] = rand() % 64 - 32;
+        lines[n] = randomValue();
+    }
+
+    double generic[3] = { 0, 0, 0 };
+    printf("Microseconds per granule (576 values, one channel):\n");
+    for (int level = 0; level < numLevels; level++) {
+        SuperpoweredSIMDSetLevel((SuperpoweredSIMDLevel)level);
+        SuperpoweredSIMDMP3State *state = &states[level];
+        double t[4];
+        t[0] = now();
+        for (int n = 0; n < REPEAT; n++) SuperpoweredSIMDMP3Dequantize(values, output, 576, 1.0f);
+        t[1] = now();
+        for (int n = 0; n < REPEAT; n++) SuperpoweredSIMDMP3IMDCT(state, 0, lines, output, n & 2, false);
+        t[2] = now();
+        for (int n = 0; n < REPEAT; n++) SuperpoweredSIMDMP3Synthesis(state, 0, lines, output);
+        t[3] = now();
+
+        double us[3];
+        for (int stage = 0; stage < 3; stage++) {
+            us[stage] = (t[stage + 1] - t[stage]) / REPEAT * 1e6;
+            if (!level) generic[stage] = us[stage];
+        }
+        printf("%-8s requantization %6.2f (%4.1fx), IMDCT %6.2f (%4.1fx), synthesis %6.2f (%4.1fx)\n", SuperpoweredSIMDLevelName((SuperpoweredSIMDLevel)level),
+               us[0], generic[0] / us[0], us[1], generic[1] / us[1], us[2], generic[2] / us[2]);
+    }
+}
+
+int main() {
+    srand(7);
+    int numLevels = SuperpoweredSIMDGetSupportedLevel() + 1, failures = 0;
+    SuperpoweredSIMDMP3Init(&reference);
+    for (int level = 0; level < numLevels; level++) SuperpoweredSIMDMP3Init(&states[level]);
+
+    if (!checkDequantize(numLevels)) failures++;
+    if (!checkIMDCTAndSynthesis(numLevels)) failures++;
+    if (!checkReconstruction(numLevels)) failures++;
+    benchmark(numLevels);
+
+    printf(failures ? "FAILED\n" : "PASSED\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,131 @@
+// Checks SuperpoweredSIMDMeter against a direct reference on every code path, and the loudness of a 1 kHz sine.
+// Build on x86 with the library, for example: g++ -O2 -I.. SuperpoweredSIMDMeterTest.cpp ../SuperpoweredSIMD.cpp ../libSuperpoweredAndroidx86.a
+// Returns 0 if every check passed.
+
+#include "SuperpoweredSIMD.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define NUMSAMPLES 5000
+#define MAXCHANNELS 12
+
+// The ITU-R BS.1770-4 Annex 2 true peak filter, the same as in SuperpoweredSIMD.cpp.
+static const double truePeakFilter[4][12] = {
+    { 0.0017089843750, 0.0109863281250, -0.0196533203125, 0.0332031250000, -0.0594482421875, 0.1373291015625, 0.9721679687500, -0.1022949218750, 0.0476074218750, -0.0266113281250, 0.0148925781250, -0.0083007812500 },
+    { -0.0291748046875, 0.0292968750000, -0.0517578125000, 0.0891113281250, -0.1665039062500, 0.4650878906250, 0.7797851562500, -0.2003173828125, 0.1015625000000, -0.0582275390625, 0.0330810546875, -0.0189208984375 },
+    { -0.0189208984375, 0.0330810546875, -0.0582275390625, 0.1015625000000, -0.2003173828125, 0.7797851562500, 0.4650878906250, -0.1665039062500, 0.0891113281250, -0.0517578125000, 0.0292968750000, -0.0291748046875 },
+    { -0.0083007812500, 0.0148925781250, -0.0266113281250, 0.0476074218750, -0.1022949218750, 0.9721679687500, 0.1373291015625, -0.0594482421875, 0.0332031250000, -0.0196533203125, 0.0109863281250, 0.0017089843750 }
+};
+
+typedef struct meterResult {
+    double peak[MAXCHANNELS], sumSquares[MAXCHANNELS], truePeak[MAXCHANNELS], loudness[MAXCHANNELS];
+} meterResult;
+
+static float input[NUMSAMPLES * MAXCHANNELS];
+
+// Sample by sample, in double precision. The K-weighting coefficients come from the state.
+static void reference(unsigned int numChannels, const double *c, meterResult *result) {
+    memset(result, 0, sizeof(meterResult));
+    for (unsigned int channel = 0; channel < numChannels; channel++) {
+        double z0 = 0, z1 = 0, z2 = 0, z3 = 0;
+        for (int n = 0; n < NUMSAMPLES; n++) {
+            double x = input[n * numChannels + channel];
+            result->peak[channel] = fmax(result->peak[channel], fabs(x));
+            result->sumSquares[channel] += x * x;
+            result->truePeak[channel] = fmax(result->truePeak[channel], fabs(x));
+            for (int phase = 0; phase < 4; phase++) {
+                double sum = 0;
+                for (int tap = 0; tap < 12; tap++) if (n >= tap) sum += truePeakFilter[phase][tap] * input[(n - tap) * numChannels + channel];
+                result->truePeak[channel] = fmax(result->truePeak[channel], fabs(sum));
+            }
+            double y = c[0] * x + z0;
+            z0 = c[1] * x - c[3] * y + z1;
+            z1 = c[2] * x - c[4] * y;
+            double w = c[5] * y + z2;
+            z2 = c[6] * y - c[8] * w + z3;
+            z3 = c[7] * y - c[9] * w;
+            result->loudness[channel] += w * w;
+        }
+    }
+}
+
+// Buffers of uneven sizes, including empty ones, to cross the vector and chunk boundaries.
+static void measure(SuperpoweredSIMDMeterState *state, unsigned int numChannels, meterResult *result) {
+    static const unsigned int sizes[9] = { 5, 1, 0, 300, 11, 12, 2000, 37, 1024 };
+    memset(result, 0, sizeof(meterResult));
+    unsigned int position = 0, index = 0;
+    while (position < NUMSAMPLES) {
+        unsigned int numberOfSamples = sizes[index++ % 9];
+        if (numberOfSamples > NUMSAMPLES - position) numberOfSamples = NUMSAMPLES - position;
+        float peaks[MAXCHANNELS], sumSquares[MAXCHANNELS], truePeaks[MAXCHANNELS], loudness[MAXCHANNELS];
+        SuperpoweredSIMDMeter(state, input + position * numChannels, numberOfSamples, peaks, sumSquares, truePeaks, loudness);
+        for (unsigned int channel = 0; channel < numChannels; channel++) {
+            result->peak[channel] = fmax(result->peak[channel], peaks[channel]);
+            result->sumSquares[channel] += sumSquares[channel];
+            result->truePeak[channel] = fmax(result->truePeak[channel], truePeaks[channel]);
+            result->loudness[channel] += loudness[channel];
+        }
+        position += numberOfSamples;
+    }
+}
+
+static float sineLoudness(unsigned int samplerate) {
+    float *sine = (float *)malloc(samplerate * sizeof(float));
+    for (unsigned int n = 0; n < samplerate; n++) sine[n] = (float)sin(2.0 * M_PI * 1000.0 * n / samplerate);
+    SuperpoweredSIMDMeterState state;
+    SuperpoweredSIMDMeterInit(&state, samplerate, 1);
+
+    unsigned int block = samplerate / 100, settle = samplerate / 5; // Skip the first 200 ms, the filters settle.
+    double sum = 0;
+    for (unsigned int n = 0; n + block <= samplerate; n += block) {
+        float peak, sumSquares, loudness;
+        SuperpoweredSIMDMeter(&state, sine + n, block, &peak, &sumSquares, NULL, &loudness);
+        if (n >= settle) sum += loudness;
+    }
+    free(sine);
+    float loudness = (float)sum;
+    return SuperpoweredSIMDLoudness(&loudness, samplerate - settle, 1, NULL);
+}
+
+int main() {
+    srand(5);
+    for (int n = 0; n < NUMSAMPLES * MAXCHANNELS; n++) input[n] = ((float)rand() / (float)RAND_MAX - 0.5f) * (float)(1 + n % 7);
+
+    static const unsigned int channelCounts[6] = { 1, 2, 3, 6, 8, MAXCHANNELS };
+    int failures = 0;
+    for (int level = 0; level <= SuperpoweredSIMDGetSupportedLevel(); level++) {
+        SuperpoweredSIMDSetLevel((SuperpoweredSIMDLevel)level);
+        double worst = 0;
+        for (int c = 0; c < 6; c++) {
+            unsigned int numChannels = channelCounts[c];
+            SuperpoweredSIMDMeterState state;
+            SuperpoweredSIMDMeterInit(&state, 48000, numChannels);
+            meterResult expected, result;
+            reference(numChannels, state.coefficients, &expected);
+            measure(&state, numChannels, &result);
+
+            for (unsigned int channel = 0; channel < numChannels; channel++) {
+                double error = fmax(fmax(fabs(result.peak[channel] - expected.peak[channel]), fabs(result.truePeak[channel] - expected.truePeak[channel])),
+                                    fmax(fabs(result.sumSquares[channel] / expected.sumSquares[channel] - 1.0), fabs(result.loudness[channel] / expected.loudness[channel] - 1.0)));
+                if (error > worst) worst = error;
+            }
+        }
+        bool passed = worst < 1e-5;
+        if (!passed) failures++;
+        printf("%s: largest error %g%s\n", SuperpoweredSIMDLevelName((SuperpoweredSIMDLevel)level), worst, passed ? "" : " FAILED");
+    }
+
+    // A 0 dBFS 1 kHz sine in one channel is -3.01 LUFS.
+    static const unsigned int samplerates[2] = { 44100, 48000 };
+    for (int n = 0; n < 2; n++) {
+        float lufs = sineLoudness(samplerates[n]);
+        bool passed = fabsf(lufs + 3.01f) < 0.02f;
+        if (!passed) failures++;
+        printf("1 kHz sine at %u Hz: %.3f LUFS%s\n", samplerates[n], lufs, passed ? "" : " FAILED");
+    }
+
+    printf(failures ? "FAILED\n" : "PASSED\n");
+    return failures ? 1 : 0;
+}
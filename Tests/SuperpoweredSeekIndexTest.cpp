@@ -0,0 +1,184 @@
+// Checks SuperpoweredSeekIndex on generated MP3 and ADTS AAC files: frame count, find() against the real frame positions and the MP3 bit reservoir, serialize() and load().
+// Blobs with a broken field must be rejected by load(): they would make find() divide by zero or return offsets outside of the file.
+// Build: g++ -O2 -I.. SuperpoweredSeekIndexTest.cpp ../SuperpoweredSeekIndex.cpp
+// Returns 0 if every check passed.
+
+#include "SuperpoweredSeekIndex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#define NUMFRAMES 3000
+#define MAXSIDEBYTES 38
+
+static const unsigned short bitrates[15] = { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 };
+
+typedef struct testFile {
+    char path[64];
+    int64_t offsets[NUMFRAMES], samples[NUMFRAMES], durationSamples;
+    unsigned int samplesPerFrame;
+} testFile;
+
+// Random frame contents without sync patterns.
+static void payload(FILE *file, unsigned int bytes) {
+    while (bytes--) fputc(rand() % 255, file);
+}
+
+// MPEG-1 layer 3, 44100 Hz stereo, random bitrates and padding, behind an ID3v2 tag and an Info frame, with garbage in the middle.
+static bool writeMP3(testFile *test) {
+    FILE *file = fopen(test->path, "wb");
+    if (!file) return false;
+    static const unsigned char id3[10] = { 'I', 'D', '3', 4, 0, 0, 0, 0, 1, 0 };
+    fwrite(id3, 1, 10, file);
+    payload(file, 128);
+
+    unsigned char info[417];
+    memset(info, 0, sizeof(info));
+    info[0] = 0xff; info[1] = 0xfb; info[2] = 0x90;
+    memcpy(info + 36, "Info", 4);
+    fwrite(info, 1, sizeof(info), file);
+
+    int64_t samplePosition = 0;
+    for (int n = 0; n < NUMFRAMES; n++) {
+        unsigned int bitrateIndex = 1 + rand() % 14, padding = rand() % 2, bytes = 144 * bitrates[bitrateIndex] * 1000 / 44100 + padding;
+        unsigned char header[4] = { 0xff, 0xfb, (unsigned char)((bitrateIndex << 4) | (padding << 1)), 0 };
+        test->offsets[n] = ftell(file);
+        test->samples[n] = samplePosition;
+        fwrite(header, 1, 4, file);
+        payload(file, bytes - 4);
+        samplePosition += 1152;
+        if (n == NUMFRAMES / 2) payload(file, 777);
+    }
+    fwrite("TAG", 1, 3, file);
+    payload(file, 125);
+    fclose(file);
+    test->durationSamples = samplePosition;
+    test->samplesPerFrame = 1152;
+    return true;
+}
+
+// AAC LC, 44100 Hz stereo, random frame sizes, some frames with 2 raw data blocks.
+static bool writeAAC(testFile *test) {
+    FILE *file = fopen(test->path, "wb");
+    if (!file) return false;
+    int64_t samplePosition = 0;
+    for (int n = 0; n < NUMFRAMES; n++) {
+        unsigned int bytes = 50 + rand() % 750, blocks = (n % 7) ? 0 : 1;
+        unsigned char header[7] = { 0xff, 0xf1, (1 << 6) | (4 << 2), (unsigned char)((2 << 6) | ((bytes >> 11) & 3)), (unsigned char)((bytes >> 3) & 0xff), (unsigned char)(((bytes & 7) << 5) | 0x1f), (unsigned char)(0xfc | blocks) };
+        test->offsets[n] = ftell(file);
+        test->samples[n] = samplePosition;
+        fwrite(header, 1, 7, file);
+        payload(file, bytes - 7);
+        samplePosition += 1024 * (blocks + 1);
+    }
+    fclose(file);
+    test->durationSamples = samplePosition;
+    test->samplesPerFrame = 2048; // The first frame has 2 blocks.
+    return true;
+}
+
+// find() must return a real frame at or before the position's overlap frame. For MP3, 511 bytes of main data must be between them.
+static int checkFind(SuperpoweredSeekIndex *index, testFile *test, bool mp3) {
+    int errors = 0;
+    for (int n = 0; n < 20000; n++) {
+        int64_t sample = (int64_t)(((uint64_t)rand() << 16) ^ (uint64_t)rand()) % test->durationSamples, byteOffset, frameSample;
+        if (!index->find(sample, &byteOffset, &frameSample)) {
+            errors++;
+            continue;
+        }
+        int frame = 0, target = 0;
+        while ((frame < NUMFRAMES) && (test->offsets[frame] != byteOffset)) frame++;
+        while ((target + 1 < NUMFRAMES) && (test->samples[target + 1] <= sample)) target++;
+        if ((frame == NUMFRAMES) || (test->samples[frame] != frameSample)) {
+            errors++;
+            continue;
+        }
+        int overlap = target - 1;
+        if ((overlap > 0) && (frame > overlap)) errors++;
+        if (mp3 && (overlap > 0) && (frame > 0) && (test->offsets[overlap] - byteOffset - (overlap - frame) * MAXSIDEBYTES < 511)) errors++;
+    }
+    int64_t byteOffset, frameSample;
+    if (index->find(test->durationSamples, &byteOffset, &frameSample) || index->find(-1, &byteOffset, &frameSample)) errors++;
+    return errors;
+}
+
+// The blob is little-endian, with fixed offsets.
+static bool loadChanged(const void *blob, size_t bytes, size_t offset, int64_t value, unsigned int width) {
+    unsigned char *copy = (unsigned char *)malloc(bytes);
+    memcpy(copy, blob, bytes);
+    for (unsigned int n = 0; n < width; n++) copy[offset + n] = (unsigned char)((uint64_t)value >> (n * 8));
+    SuperpoweredSeekIndex index;
+    bool loaded = index.load(copy, bytes);
+    free(copy);
+    return loaded;
+}
+
+static int64_t readInt64(const void *blob, size_t offset) {
+    const unsigned char *p = (const unsigned char *)blob + offset;
+    uint64_t value = 0;
+    for (int n = 7; n >= 0; n--) value = (value << 8) | p[n];
+    return (int64_t)value;
+}
+
+static int checkBlob(SuperpoweredSeekIndex *index, testFile *test) {
+    void *blob;
+    size_t bytes;
+    if (!index->serialize(&blob, &bytes)) return 1;
+    int errors = 0;
+
+    SuperpoweredSeekIndex loaded;
+    if (!loaded.load(blob, bytes, test->path) || (checkFind(&loaded, test, index->kind == SuperpoweredDecoder_MP3) != 0)) errors++;
+    if (loaded.load(blob, bytes - 1) || loaded.load(blob, 40)) errors++;
+
+    int64_t fileBytes = readInt64(blob, 32), lastOffset = readInt64(blob, bytes - 16), lastSample = readInt64(blob, bytes - 8);
+    const struct { size_t offset; int64_t value; unsigned int width; } broken[] = {
+        { 4, 99, 4 },              // version
+        { 8, 7, 4 },               // kind
+        { 12, 0, 4 },              // samplerate
+        { 16, 0, 4 },              // samplesPerFrame
+        { 16, 1000, 4 },
+        { 20, 0, 4 },              // framesPerEntry
+        { 20, 3, 4 },
+        { 24, 1, 4 },              // numFrames
+        { 32, lastOffset, 8 },     // fileBytes
+        { 40, lastSample, 8 },     // durationSamples
+        { 48, -1, 8 },             // the first byteOffset
+        { bytes - 16, fileBytes, 8 }
+    };
+    for (unsigned int n = 0; n < sizeof(broken) / sizeof(broken[0]); n++) if (loadChanged(blob, bytes, broken[n].offset, broken[n].value, broken[n].width)) {
+        printf("A blob with %lld at byte %u was accepted.\n", (long long)broken[n].value, (unsigned int)broken[n].offset);
+        errors++;
+    }
+    free(blob);
+    return errors;
+}
+
+static bool test(bool mp3, unsigned int framesPerEntry) {
+    static testFile file;
+    snprintf(file.path, sizeof(file.path), "/tmp/SuperpoweredSeekIndexTest%d.%s", (int)getpid(), mp3 ? "mp3" : "aac");
+    if (!(mp3 ? writeMP3(&file) : writeAAC(&file))) return false;
+
+    SuperpoweredSeekIndex index(framesPerEntry);
+    const char *error = index.build(file.path);
+    int errors = 0;
+    if (error || (index.numFrames != NUMFRAMES) || (index.durationSamples != file.durationSamples) || (index.samplesPerFrame != file.samplesPerFrame) || (index.samplerate != 44100)) errors++;
+    else errors += checkFind(&index, &file, mp3) + checkBlob(&index, &file);
+    unlink(file.path);
+
+    printf("%s, %u frames per entry: %d errors%s\n", mp3 ? "MP3" : "AAC", framesPerEntry, errors, errors ? " FAILED" : "");
+    return !errors;
+}
+
+int main() {
+    srand(5);
+    int failures = 0;
+    static const unsigned int framesPerEntry[3] = { 1, 2, 8 };
+    for (int n = 0; n < 3; n++) {
+        if (!test(true, framesPerEntry[n])) failures++;
+        if (!test(false, framesPerEntry[n])) failures++;
+    }
+    printf(failures ? "FAILED\n" : "PASSED\n");
+    return failures ? 1 : 0;
+}